@@ -0,0 +1,226 @@
+//------------------------------------------------------------------------------
+// File: BucketQueue.cpp
+// Desc: Priority queue for small integer priorities
+//
+// Created: 19 October 2026 17:26:40
+//
+// (c)2002 Neil Wakefield
+//------------------------------------------------------------------------------
+
+
+//------------------------------------------------------------------------------
+// Included files:
+//------------------------------------------------------------------------------
+#include "BucketQueue.h"
+
+#include <stdlib.h>
+
+
+//------------------------------------------------------------------------------
+// Globals:
+//------------------------------------------------------------------------------
+
+
+//------------------------------------------------------------------------------
+// Definitions:
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Name: BucketQueue()
+// Desc: Constructor for the bucket queue
+//------------------------------------------------------------------------------
+BucketQueue::BucketQueue()
+{
+	m_size = 0;
+	m_lowest = 0;
+
+	m_numBuckets = 0;
+	m_pHeads = NULL;
+	m_pNext = NULL;
+	m_pPrev = NULL;
+	m_pPriority = NULL;
+	m_owned = false;
+}
+
+//------------------------------------------------------------------------------
+// Name: BucketQueue()
+// Desc: Copy constructor - a copy of an owning queue owns its own arrays
+//------------------------------------------------------------------------------
+BucketQueue::BucketQueue( const BucketQueue& other )
+{
+	*this = other;
+}
+
+//------------------------------------------------------------------------------
+// Name: operator=()
+// Desc: Assignment - a copy of an owning queue owns its own arrays, while a
+//		 copy of an attached queue shares the attached ones
+//------------------------------------------------------------------------------
+BucketQueue& BucketQueue::operator=( const BucketQueue& other )
+{
+	if( this == &other )
+		return *this;
+
+	m_size = other.m_size;
+	m_lowest = other.m_lowest;
+
+	m_numBuckets = other.m_numBuckets;
+	m_pHeads = other.m_pHeads;
+	m_pNext = other.m_pNext;
+	m_pPrev = other.m_pPrev;
+	m_pPriority = other.m_pPriority;
+
+	m_owned = other.m_owned;
+	m_heads = other.m_heads;
+	m_next = other.m_next;
+	m_prev = other.m_prev;
+	m_priority = other.m_priority;
+
+	if( m_owned )
+		PointAtOwned();
+
+	return *this;
+}
+
+//------------------------------------------------------------------------------
+// Name: Resize()
+// Desc: Sizes the queue for a number of items and a largest priority step,
+//		 leaving it empty
+//------------------------------------------------------------------------------
+void BucketQueue::Resize( const int numItems, const int maxStep )
+{
+	m_heads.assign( maxStep + 1, int( NO_ITEM ) );
+	m_next.resize( numItems );
+	m_prev.assign( numItems, int( NOT_QUEUED ) );
+	m_priority.resize( numItems );
+
+	m_owned = true;
+	PointAtOwned();
+
+	m_size = 0;
+	m_lowest = 0;
+}
+
+//------------------------------------------------------------------------------
+// Name: Attach()
+// Desc: Sets the queue up on arrays supplied by the caller, leaving it empty.
+//		 pHeads needs maxStep + 1 entries and the others numItems each. They
+//		 must outlive the queue, and nothing is allocated
+//------------------------------------------------------------------------------
+void BucketQueue::Attach( const int numItems, const int maxStep, int* pHeads, int* pNext,
+						  int* pPrev, int* pPriority )
+{
+	m_numBuckets = maxStep + 1;
+	m_pHeads = pHeads;
+	m_pNext = pNext;
+	m_pPrev = pPrev;
+	m_pPriority = pPriority;
+
+	m_owned = false;
+	m_heads.clear();
+	m_next.clear();
+	m_prev.clear();
+	m_priority.clear();
+
+	for( int i = 0; i < m_numBuckets; ++i )
+		m_pHeads[ i ] = NO_ITEM;
+	for( int i = 0; i < numItems; ++i )
+		m_pPrev[ i ] = NOT_QUEUED;
+
+	m_size = 0;
+	m_lowest = 0;
+}
+
+//------------------------------------------------------------------------------
+// Name: PointAtOwned()
+// Desc: Points the queue at the arrays it owns
+//------------------------------------------------------------------------------
+void BucketQueue::PointAtOwned()
+{
+	m_numBuckets = int( m_heads.size() );
+	m_pHeads = m_heads.empty() ? NULL : &m_heads[ 0 ];
+	m_pNext = m_next.empty() ? NULL : &m_next[ 0 ];
+	m_pPrev = m_prev.empty() ? NULL : &m_prev[ 0 ];
+	m_pPriority = m_priority.empty() ? NULL : &m_priority[ 0 ];
+}
+
+//------------------------------------------------------------------------------
+// Name: Clear()
+// Desc: Empties the queue, touching only the items still in it
+//------------------------------------------------------------------------------
+void BucketQueue::Clear()
+{
+	for( int i = 0; i < m_numBuckets && m_size > 0; ++i )
+	{
+		for( int item = m_pHeads[ i ]; item != NO_ITEM; item = m_pNext[ item ] )
+		{
+			m_pPrev[ item ] = NOT_QUEUED;
+			--m_size;
+		}
+		m_pHeads[ i ] = NO_ITEM;
+	}
+
+	m_size = 0;
+	m_lowest = 0;
+}
+
+//------------------------------------------------------------------------------
+// Name: Push()
+// Desc: Queues an item, or moves it if it is already queued
+//------------------------------------------------------------------------------
+void BucketQueue::Push( const int item, const int priority )
+{
+	if( Contains( item ) )
+		Remove( item );
+
+	if( 0 == m_size || priority < m_lowest )
+		m_lowest = priority;
+
+	const int bucket = GetBucket( priority );
+	m_pPriority[ item ] = priority;
+	m_pPrev[ item ] = NO_ITEM;
+	m_pNext[ item ] = m_pHeads[ bucket ];
+	if( m_pHeads[ bucket ] != NO_ITEM )
+		m_pPrev[ m_pHeads[ bucket ] ] = item;
+	m_pHeads[ bucket ] = item;
+
+	++m_size;
+}
+
+//------------------------------------------------------------------------------
+// Name: Remove()
+// Desc: Takes an item out of the queue
+//------------------------------------------------------------------------------
+void BucketQueue::Remove( const int item )
+{
+	const int prev = m_pPrev[ item ];
+	const int next = m_pNext[ item ];
+
+	if( NO_ITEM == prev )
+		m_pHeads[ GetBucket( m_pPriority[ item ] ) ] = next;
+	else
+		m_pNext[ prev ] = next;
+
+	if( next != NO_ITEM )
+		m_pPrev[ next ] = prev;
+
+	m_pPrev[ item ] = NOT_QUEUED;
+	--m_size;
+}
+
+//------------------------------------------------------------------------------
+// Name: Pop()
+// Desc: Removes and returns an item with the lowest priority. Items of equal
+//		 priority come out most recent first, which suits A* as the newest are
+//		 usually nearest the goal. The queue must not be empty
+//------------------------------------------------------------------------------
+int BucketQueue::Pop()
+{
+	while( NO_ITEM == m_pHeads[ GetBucket( m_lowest ) ] )
+		++m_lowest;
+
+	const int item = m_pHeads[ GetBucket( m_lowest ) ];
+	Remove( item );
+
+	return item;
+}
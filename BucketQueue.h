@@ -0,0 +1,85 @@
+//------------------------------------------------------------------------------
+// File: BucketQueue.h
+// Desc: Priority queue for small integer priorities
+//
+// Created: 19 October 2026 17:26:40
+//
+// (c)2002 Neil Wakefield
+//------------------------------------------------------------------------------
+
+
+#ifndef INCLUSIONGUARD_BUCKETQUEUE_H
+#define INCLUSIONGUARD_BUCKETQUEUE_H
+
+
+//------------------------------------------------------------------------------
+// Included files:
+//------------------------------------------------------------------------------
+#include "MemoryTracker.h"
+
+#include <vector>
+using namespace std;
+
+
+//------------------------------------------------------------------------------
+// Prototypes and declarations:
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Name: class BucketQueue
+// Desc: Queue of items numbered 0 to numItems - 1, kept in a ring of buckets
+//		 indexed by priority. Every queued priority must lie within maxStep of
+//		 the lowest one, which holds for Dijkstra and for A* with a consistent
+//		 heuristic when maxStep covers the largest step cost. Push and Pop are
+//		 then constant time, and an item can be moved without searching for it.
+//		 The arrays are either owned by the queue, or attached from outside so
+//		 that fixed-size users can keep them off the heap
+//------------------------------------------------------------------------------
+class BucketQueue
+{
+
+public:
+	BucketQueue();
+	BucketQueue( const BucketQueue& other );
+	BucketQueue& operator=( const BucketQueue& other );
+
+	void Resize( const int numItems, const int maxStep );
+	void Attach( const int numItems, const int maxStep, int* pHeads, int* pNext,
+				 int* pPrev, int* pPriority );
+	void Clear();
+
+	bool IsEmpty() const { return 0 == m_size; }
+	int GetSize() const { return m_size; }
+	bool Contains( const int item ) const { return m_pPrev[ item ] != NOT_QUEUED; }
+
+	void Push( const int item, const int priority );
+	void Remove( const int item );
+	int Pop();
+
+private:
+	enum { NOT_QUEUED = -2, NO_ITEM = -1 };
+
+	int m_size;
+	int m_lowest;		//priority of the bucket Pop looks in first
+
+	int m_numBuckets;
+	int* m_pHeads;
+	int* m_pNext;
+	int* m_pPrev;		//NO_ITEM at the head of a bucket
+	int* m_pPriority;
+
+	//storage used by Resize
+	bool m_owned;
+	typedef TrackedVector< int, MemoryTracker::SUBSYSTEM_SOLVER >::Type SolverInts;
+	SolverInts m_heads;
+	SolverInts m_next;
+	SolverInts m_prev;
+	SolverInts m_priority;
+
+	int GetBucket( const int priority ) const { return priority % m_numBuckets; }
+	void PointAtOwned();
+
+};
+
+
+#endif //INCLUSIONGUARD_BUCKETQUEUE_H
@@ -18,5 +18,19 @@
 const int CONST_GRID_SIZE		= 40;
 const float CONST_PLAYER_SPEED	= 5.0f;
 const float CONST_PLAYER_SIZE	= 0.5f;
+const int CONST_TICK_RATE		= 60;
+const int CONST_MAX_TICKS_PER_ADVANCE	= 8;
+const int CONST_CHUNK_SIZE		= 16;
+const int CONST_SOLUTION_CACHE_BYTES	= 1 << 20;
+const int CONST_NUM_LANDMARKS	= 8;
+const int CONST_SOLVER_MEMORY_BYTES	= 1 << 20;
+const int CONST_WORLD_CHUNK_SIZE	= 32;
+const int CONST_WORLD_MEMORY_BYTES	= 4 << 20;
+const int CONST_WORLD_SEARCH_CELLS	= 1 << 20;
+
+const float CONST_CAMERA_FOV		= 0.785398163f;	//pi / 4
+const float CONST_CAMERA_NEAR		= 1.0f;
+const float CONST_CAMERA_FAR		= 500.0f;
+const float CONST_CHASECAM_RANGE	= 40.0f;
 
 #endif //INCLUSIONGUARD_CONSTANTS_H
@@ -0,0 +1,118 @@
+//------------------------------------------------------------------------------
+// File: DirtyChunks.cpp
+// Desc: Tracks which fixed-size chunks of the grid need rebuilding
+//
+// Created: 19 October 2026 11:09:14
+//
+// (c)2002 Neil Wakefield
+//------------------------------------------------------------------------------
+
+
+//------------------------------------------------------------------------------
+// Included files:
+//------------------------------------------------------------------------------
+#include "DirtyChunks.h"
+
+
+//------------------------------------------------------------------------------
+// Globals:
+//------------------------------------------------------------------------------
+
+
+//------------------------------------------------------------------------------
+// Definitions:
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Name: DirtyChunks()
+// Desc: Constructor for the dirty chunk set
+//------------------------------------------------------------------------------
+DirtyChunks::DirtyChunks()
+{
+	m_numX = 0;
+	m_numY = 0;
+}
+
+//------------------------------------------------------------------------------
+// Name: Resize()
+// Desc: Sizes the set to cover a grid, with every chunk starting out dirty
+//------------------------------------------------------------------------------
+void DirtyChunks::Resize( const int gridWidth, const int gridHeight )
+{
+	m_numX = ( gridWidth + CHUNK_SIZE - 1 ) / CHUNK_SIZE;
+	m_numY = ( gridHeight + CHUNK_SIZE - 1 ) / CHUNK_SIZE;
+
+	m_flags.assign( m_numX * m_numY, 0 );
+	m_list.clear();
+	m_list.reserve( m_numX * m_numY );
+
+	MarkAll();
+}
+
+//------------------------------------------------------------------------------
+// Name: MarkTile()
+// Desc: Marks the chunks affected by a change to a single tile. As well as the
+//		 chunk holding it, a tile on the edge of a chunk decides which faces of
+//		 its neighbour are hidden, so that chunk is marked too
+//------------------------------------------------------------------------------
+void DirtyChunks::MarkTile( const int x, const int y )
+{
+	const int cx = x / CHUNK_SIZE;
+	const int cy = y / CHUNK_SIZE;
+	Mark( cx, cy );
+
+	const int localX = x - cx * CHUNK_SIZE;
+	const int localY = y - cy * CHUNK_SIZE;
+
+	if( 0 == localX )
+		Mark( cx - 1, cy );
+	else if( CHUNK_SIZE - 1 == localX )
+		Mark( cx + 1, cy );
+
+	if( 0 == localY )
+		Mark( cx, cy - 1 );
+	else if( CHUNK_SIZE - 1 == localY )
+		Mark( cx, cy + 1 );
+}
+
+//------------------------------------------------------------------------------
+// Name: MarkAll()
+// Desc: Marks every chunk as dirty
+//------------------------------------------------------------------------------
+void DirtyChunks::MarkAll()
+{
+	for( int cy = 0; cy < m_numY; ++cy )
+		for( int cx = 0; cx < m_numX; ++cx )
+			Mark( cx, cy );
+}
+
+//------------------------------------------------------------------------------
+// Name: Pop()
+// Desc: Takes the next dirty chunk off the list, or returns FALSE if clean
+//------------------------------------------------------------------------------
+bool DirtyChunks::Pop( int& cx, int& cy )
+{
+	if( m_list.empty() )
+		return false;
+
+	const int index = m_list.back();
+	m_list.pop_back();
+	m_flags[ index ] = 0;
+
+	cx = index % m_numX;
+	cy = index / m_numX;
+
+	return true;
+}
+
+//------------------------------------------------------------------------------
+// Name: Clear()
+// Desc: Marks every chunk as clean
+//------------------------------------------------------------------------------
+void DirtyChunks::Clear()
+{
+	for( size_t i = 0; i < m_list.size(); ++i )
+		m_flags[ m_list[ i ] ] = 0;
+
+	m_list.clear();
+}
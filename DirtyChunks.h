@@ -0,0 +1,78 @@
+//------------------------------------------------------------------------------
+// File: DirtyChunks.h
+// Desc: Tracks which fixed-size chunks of the grid need rebuilding
+//
+// Created: 19 October 2026 11:02:51
+//
+// (c)2002 Neil Wakefield
+//------------------------------------------------------------------------------
+
+
+#ifndef INCLUSIONGUARD_DIRTYCHUNKS_H
+#define INCLUSIONGUARD_DIRTYCHUNKS_H
+
+
+//------------------------------------------------------------------------------
+// Included files:
+//------------------------------------------------------------------------------
+#include "Constants.h"
+
+#include <vector>
+using namespace std;
+
+
+//------------------------------------------------------------------------------
+// Prototypes and declarations:
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Name: class DirtyChunks
+// Desc: Set of dirty chunks, with a list so they can be visited without
+//		 scanning every chunk in the grid
+//------------------------------------------------------------------------------
+class DirtyChunks
+{
+
+public:
+	DirtyChunks();
+
+	const static int CHUNK_SIZE = CONST_CHUNK_SIZE;
+
+	void Resize( const int gridWidth, const int gridHeight );
+
+	int GetNumX() const { return m_numX; }
+	int GetNumY() const { return m_numY; }
+	int GetNumDirty() const { return int( m_list.size() ); }
+
+	bool IsDirty( const int cx, const int cy ) const { return m_flags[ cy * m_numX + cx ] != 0; }
+
+	void Mark( const int cx, const int cy )
+	{
+		if( cx < 0 || cx >= m_numX || cy < 0 || cy >= m_numY )
+			return;
+
+		const int index = cy * m_numX + cx;
+		if( ! m_flags[ index ] )
+		{
+			m_flags[ index ] = 1;
+			m_list.push_back( index );
+		}
+	}
+
+	void MarkTile( const int x, const int y );
+	void MarkAll();
+
+	bool Pop( int& cx, int& cy );
+	void Clear();
+
+private:
+	int m_numX;
+	int m_numY;
+
+	vector< char > m_flags;
+	vector< int > m_list;
+
+};
+
+
+#endif //INCLUSIONGUARD_DIRTYCHUNKS_H
@@ -0,0 +1,379 @@
+//------------------------------------------------------------------------------
+// File: DistanceMatrix.cpp
+// Desc: Costs between every pair of a set of points in a maze
+//
+// Created: 20 October 2026 06:19:07
+//
+// (c)2002 Neil Wakefield
+//------------------------------------------------------------------------------
+
+
+//------------------------------------------------------------------------------
+// Included files:
+//------------------------------------------------------------------------------
+#include "DistanceMatrix.h"
+#include "Threading.h"
+
+#include <algorithm>
+
+
+//------------------------------------------------------------------------------
+// Globals:
+//------------------------------------------------------------------------------
+namespace
+{
+	const int g_offsetX[ 4 ] = { 0, 1, 0, -1 };
+	const int g_offsetY[ 4 ] = { -1, 0, 1, 0 };
+
+	//the points shared by the threads of one set of searches
+	struct SearchJob
+	{
+		const Grid* pGrid;
+		const vector< int >* pCells;
+		const vector< bool >* pIsPoint;
+		int numTargets;					//distinct open cells among the points
+		int* pDistances;
+		volatile long next;
+	};
+
+	//one thread's searches, with its own workspace. The costs are cleared
+	// only where a search reached, so each starts clean without a pass over
+	// the whole grid
+	struct SearchWorker
+	{
+		SearchJob* pJob;
+		vector< int > cost;
+		vector< int > reached;
+		vector< int > buckets[ Grid::MAX_WEIGHT + 1 ];
+		Thread thread;
+	};
+
+	//--------------------------------------------------------------------------
+	// Name: Search()
+	// Desc: Dijkstra search from one point, using a ring of buckets with stale
+	//		 entries skipped as they come up. Stops when every point's cell
+	//		 has been settled, and fills in the point's row of the matrix
+	//--------------------------------------------------------------------------
+	void Search( SearchWorker& worker, const int from )
+	{
+		const SearchJob& job = *worker.pJob;
+		const Grid& grid = *job.pGrid;
+		const vector< int >& cells = *job.pCells;
+		const int numPoints = int( cells.size() );
+		int* pRow = job.pDistances + from * numPoints;
+
+		const int fromCell = cells[ from ];
+		if( fromCell < 0 )
+		{
+			for( int i = 0; i < numPoints; ++i )
+				pRow[ i ] = -1;
+			return;
+		}
+
+		const int numBuckets = Grid::MAX_WEIGHT + 1;
+		vector< int >& cost = worker.cost;
+		vector< int >& reached = worker.reached;
+		if( int( cost.size() ) != grid.GetNumCells() )
+			cost.assign( grid.GetNumCells(), -1 );
+
+		cost[ fromCell ] = 0;
+		reached.push_back( fromCell );
+		worker.buckets[ 0 ].push_back( fromCell );
+		int numQueued = 1;
+		int remaining = job.numTargets;
+
+		for( int current = 0; numQueued > 0 && remaining > 0; ++current )
+		{
+			//new entries always land in a later bucket, as every step costs
+			// at least MIN_WEIGHT and no more than MAX_WEIGHT
+			vector< int >& bucket = worker.buckets[ current % numBuckets ];
+			for( size_t b = 0; b < bucket.size() && remaining > 0; ++b )
+			{
+				const int cell = bucket[ b ];
+				if( cost[ cell ] != current )
+					continue;
+
+				if( ( *job.pIsPoint )[ cell ] )
+					--remaining;
+
+				const int cellX = grid.GetCellX( cell );
+				const int cellY = grid.GetCellY( cell );
+				for( int i = 0; i < 4; ++i )
+				{
+					const int x = cellX + g_offsetX[ i ];
+					const int y = cellY + g_offsetY[ i ];
+					if( ! grid.IsPath( x, y ) )
+						continue;
+
+					const int next = grid.GetCellIndex( x, y );
+					const int nextCost = current + grid.GetWeight( x, y );
+					if( cost[ next ] >= 0 && cost[ next ] <= nextCost )
+						continue;
+
+					if( cost[ next ] < 0 )
+						reached.push_back( next );
+					cost[ next ] = nextCost;
+					worker.buckets[ nextCost % numBuckets ].push_back( next );
+					++numQueued;
+				}
+			}
+
+			numQueued -= int( bucket.size() );
+			bucket.clear();
+		}
+
+		//anything left queued is stale or not needed
+		for( int i = 0; i < numBuckets; ++i )
+			worker.buckets[ i ].clear();
+
+		for( int i = 0; i < numPoints; ++i )
+			pRow[ i ] = ( cells[ i ] >= 0 ) ? cost[ cells[ i ] ] : -1;
+
+		for( size_t i = 0; i < reached.size(); ++i )
+			cost[ reached[ i ] ] = -1;
+		reached.clear();
+	}
+
+	//--------------------------------------------------------------------------
+	// Name: RunSearchWorker()
+	// Desc: Searches from points until there are none left
+	//--------------------------------------------------------------------------
+	void RunSearchWorker( void* pWorker )
+	{
+		SearchWorker& worker = *( (SearchWorker*)( pWorker ) );
+		const long numPoints = long( worker.pJob->pCells->size() );
+
+		while( true )
+		{
+			const long index = AtomicIncrement( &worker.pJob->next ) - 1;
+			if( index >= numPoints )
+				break;
+
+			Search( worker, int( index ) );
+		}
+	}
+}
+
+
+//------------------------------------------------------------------------------
+// Definitions:
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Name: DistanceMatrix()
+// Desc: Constructor for the distance matrix object
+//------------------------------------------------------------------------------
+DistanceMatrix::DistanceMatrix()
+{
+	m_numThreads = GetNumProcessors();
+	m_useTree = true;
+	m_usedTree = false;
+	m_numPoints = 0;
+}
+
+//------------------------------------------------------------------------------
+// Name: Compute()
+// Desc: Fills in the matrix for a set of points
+//------------------------------------------------------------------------------
+void DistanceMatrix::Compute( const Grid& grid, const vector< MazeSquare >& points )
+{
+	m_numPoints = int( points.size() );
+	m_distances.assign( m_numPoints * m_numPoints, -1 );
+	m_usedTree = false;
+
+	m_cells.resize( m_numPoints );
+	m_isPoint.assign( grid.GetNumCells(), false );
+	m_byCell.clear();
+	for( int i = 0; i < m_numPoints; ++i )
+	{
+		const int x = points[ i ].x;
+		const int y = points[ i ].y;
+		m_cells[ i ] = grid.IsPath( x, y ) ? grid.GetCellIndex( x, y ) : -1;
+		if( m_cells[ i ] < 0 )
+			continue;
+
+		m_isPoint[ m_cells[ i ] ] = true;
+		m_byCell.push_back( make_pair( m_cells[ i ], i ) );
+	}
+	sort( m_byCell.begin(), m_byCell.end() );
+
+	if( m_useTree && ComputeTree( grid ) )
+	{
+		m_usedTree = true;
+		return;
+	}
+
+	ComputeSearches( grid );
+}
+
+//------------------------------------------------------------------------------
+// Name: ComputeTree()
+// Desc: Walks each part of the maze holding points, filling in the matrix as
+//		 it reaches them. Returns false if it finds a loop, as the routes
+//		 would then no longer be the only ones
+//------------------------------------------------------------------------------
+bool DistanceMatrix::ComputeTree( const Grid& grid )
+{
+	WalkCell unvisited;
+	unvisited.set = -1;
+	unvisited.cost = 0;
+	m_walk.assign( grid.GetNumCells(), unvisited );
+
+	vector< int > visited;	//points reached so far in this part of the maze
+
+	for( size_t root = 0; root < m_byCell.size(); ++root )
+	{
+		const int rootCell = m_byCell[ root ].first;
+		if( m_walk[ rootCell ].set >= 0 )
+			continue;
+
+		//every point in an earlier part is out of reach of this one
+		visited.clear();
+
+		WalkStep step;
+		step.cell = rootCell;
+		step.x = grid.GetCellX( rootCell );
+		step.y = grid.GetCellY( rootCell );
+		step.parent = -1;
+		step.nextDir = 0;
+		m_walk[ rootCell ].set = rootCell;
+		m_walk[ rootCell ].cost = grid.GetWeight( step.x, step.y );
+		VisitPoints( grid, rootCell, visited );
+		m_stack.assign( 1, step );
+
+		while( ! m_stack.empty() )
+		{
+			WalkStep& top = m_stack.back();
+			if( 4 == top.nextDir )
+			{
+				//finished with this cell, so it joins its parent's set
+				if( top.parent >= 0 )
+					m_walk[ top.cell ].set = top.parent;
+				m_stack.pop_back();
+				continue;
+			}
+
+			const int dir = top.nextDir++;
+			const int x = top.x + g_offsetX[ dir ];
+			const int y = top.y + g_offsetY[ dir ];
+			if( ! grid.IsPath( x, y ) )
+				continue;
+
+			const int next = grid.GetCellIndex( x, y );
+			if( next == top.parent )
+				continue;
+
+			//only the way back to the parent has been seen before in a tree
+			if( m_walk[ next ].set >= 0 )
+				return false;
+
+			m_walk[ next ].set = next;
+			m_walk[ next ].cost = m_walk[ top.cell ].cost + grid.GetWeight( x, y );
+			if( m_isPoint[ next ] )
+				VisitPoints( grid, next, visited );
+
+			step.cell = next;
+			step.x = x;
+			step.y = y;
+			step.parent = top.cell;
+			m_stack.push_back( step );
+		}
+	}
+
+	return true;
+}
+
+//------------------------------------------------------------------------------
+// Name: VisitPoints()
+// Desc: Fills in the matrix between the points in a newly reached cell and
+//		 those reached before it. The set of an earlier point's cell is
+//		 headed by the last cell on the way back to the root its branch
+//		 shares with this one, which is where the route between them turns
+//------------------------------------------------------------------------------
+void DistanceMatrix::VisitPoints( const Grid& grid, const int cell, vector< int >& visited )
+{
+	const int weight = grid.GetWeight( grid.GetCellX( cell ), grid.GetCellY( cell ) );
+
+	vector< pair< int, int > >::const_iterator it =
+		lower_bound( m_byCell.begin(), m_byCell.end(), make_pair( cell, -1 ) );
+	for( ; it != m_byCell.end() && it->first == cell; ++it )
+	{
+		const int point = it->second;
+		m_distances[ point * m_numPoints + point ] = 0;
+
+		for( size_t i = 0; i < visited.size(); ++i )
+		{
+			const int other = visited[ i ];
+			const int otherCell = m_cells[ other ];
+			const int otherWeight = grid.GetWeight( grid.GetCellX( otherCell ),
+													grid.GetCellY( otherCell ) );
+
+			//the route climbs from one end to the turn and drops to the other.
+			// This is the cost of every cell on it, and each direction pays
+			// for all but the one it starts from
+			const int turn = FindSet( otherCell );
+			const int turnWeight = grid.GetWeight( grid.GetCellX( turn ), grid.GetCellY( turn ) );
+			const int between = m_walk[ cell ].cost + m_walk[ otherCell ].cost -
+								2 * m_walk[ turn ].cost + turnWeight;
+
+			m_distances[ point * m_numPoints + other ] = between - weight;
+			m_distances[ other * m_numPoints + point ] = between - otherWeight;
+		}
+
+		visited.push_back( point );
+	}
+}
+
+//------------------------------------------------------------------------------
+// Name: FindSet()
+// Desc: Returns the head of a cell's set, halving the links on the way
+//------------------------------------------------------------------------------
+int DistanceMatrix::FindSet( int cell )
+{
+	while( m_walk[ cell ].set != cell )
+	{
+		m_walk[ cell ].set = m_walk[ m_walk[ cell ].set ].set;
+		cell = m_walk[ cell ].set;
+	}
+
+	return cell;
+}
+
+//------------------------------------------------------------------------------
+// Name: ComputeSearches()
+// Desc: Searches from every point, sharing the points out between threads
+//------------------------------------------------------------------------------
+void DistanceMatrix::ComputeSearches( const Grid& grid )
+{
+	SearchJob job;
+	job.pGrid = &grid;
+	job.pCells = &m_cells;
+	job.pIsPoint = &m_isPoint;
+	job.pDistances = m_distances.empty() ? NULL : &m_distances[ 0 ];
+	job.next = 0;
+
+	job.numTargets = 0;
+	for( size_t i = 0; i < m_byCell.size(); ++i )
+		if( 0 == i || m_byCell[ i ].first != m_byCell[ i - 1 ].first )
+			++job.numTargets;
+
+	const int numWorkers = ( m_numThreads < m_numPoints ) ? m_numThreads : m_numPoints;
+	vector< SearchWorker* > workers( numWorkers );
+	for( int i = 0; i < numWorkers; ++i )
+	{
+		workers[ i ] = new SearchWorker;
+		workers[ i ]->pJob = &job;
+	}
+
+	//the calling thread takes a share too
+	for( int i = 1; i < numWorkers; ++i )
+		workers[ i ]->thread.Start( RunSearchWorker, workers[ i ] );
+	if( numWorkers > 0 )
+		RunSearchWorker( workers[ 0 ] );
+
+	for( int i = 0; i < numWorkers; ++i )
+	{
+		workers[ i ]->thread.Join();
+		delete workers[ i ];
+	}
+}
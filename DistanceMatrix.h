@@ -0,0 +1,116 @@
+//------------------------------------------------------------------------------
+// File: DistanceMatrix.h
+// Desc: Costs between every pair of a set of points in a maze
+//
+// Created: 20 October 2026 06:03:51
+//
+// (c)2002 Neil Wakefield
+//------------------------------------------------------------------------------
+
+
+#ifndef INCLUSIONGUARD_DISTANCEMATRIX_H
+#define INCLUSIONGUARD_DISTANCEMATRIX_H
+
+
+//------------------------------------------------------------------------------
+// Included files:
+//------------------------------------------------------------------------------
+#include "Grid.h"
+
+#include <utility>
+#include <vector>
+using namespace std;
+
+
+//------------------------------------------------------------------------------
+// Prototypes and declarations:
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Name: class DistanceMatrix
+// Desc: The cost of the cheapest route from each of a set of points, such as
+//		 keys, doors and spawns, to each of the others. Costs are paid on
+//		 entering a cell, as in the solvers, so the two directions between a
+//		 pair differ by the weights of its ends.
+//
+//		 A perfect maze has exactly one route between two cells, so one depth
+//		 first walk of each part of the maze holding points is enough. The
+//		 walk keeps the cost from its root to every cell, and finds the
+//		 lowest common ancestor of each pair with Tarjan's offline union-find
+//		 as it goes, which fixes the cost of the route between them. If the
+//		 walk comes across a loop, as in a braided maze, it gives up and a
+//		 Dijkstra search is run from each point instead, shared out between
+//		 threads, each stopping once it has reached all the points
+//------------------------------------------------------------------------------
+class DistanceMatrix
+{
+
+public:
+	DistanceMatrix();
+
+	//threads the per-point searches may use, the calling thread included
+	void SetNumThreads( const int numThreads ) { m_numThreads = ( numThreads > 1 ) ? numThreads : 1; }
+	int GetNumThreads() const { return m_numThreads; }
+
+	//turning the tree walk off is for comparing against the searches
+	void SetUseTree( const bool useTree ) { m_useTree = useTree; }
+	bool GetUseTree() const { return m_useTree; }
+
+	void Compute( const Grid& grid, const vector< MazeSquare >& points );
+
+	//true if the last Compute found no loops and could use the tree walk
+	bool GetUsedTree() const { return m_usedTree; }
+
+	int GetNumPoints() const { return m_numPoints; }
+
+	//-1 if there is no route, or either point is off the grid or in a wall
+	int GetDistance( const int from, const int to ) const
+	{
+		return m_distances[ from * m_numPoints + to ];
+	}
+
+	//one row per starting point, m_numPoints entries each
+	const int* GetRow( const int from ) const { return &m_distances[ from * m_numPoints ]; }
+	size_t GetNumBytes() const { return m_distances.size() * sizeof( int ); }
+
+private:
+	int m_numThreads;
+	bool m_useTree;
+	bool m_usedTree;
+
+	int m_numPoints;
+	vector< int > m_distances;	//row-major, m_numPoints squared
+	vector< int > m_cells;		//each point's cell, -1 if it isn't open
+
+	//a cell on the way down from the root of the walk
+	struct WalkStep
+	{
+		int cell;
+		int x, y;
+		int parent;		//-1 at the root
+		int nextDir;	//4 once every neighbour has been tried
+	};
+
+	//a cell's state in the walk, kept together as both are wanted at once
+	struct WalkCell
+	{
+		int set;	//union-find link, -1 until visited
+		int cost;	//from the root of the walk, ends included
+	};
+
+	//workspace for the tree walk, kept between calls
+	vector< WalkCell > m_walk;
+	vector< WalkStep > m_stack;
+	vector< bool > m_isPoint;				//per cell
+	vector< pair< int, int > > m_byCell;	//cell and point, sorted
+
+	bool ComputeTree( const Grid& grid );
+	void ComputeSearches( const Grid& grid );
+
+	int FindSet( int cell );
+	void VisitPoints( const Grid& grid, const int cell, vector< int >& visited );
+
+};
+
+
+#endif //INCLUSIONGUARD_DISTANCEMATRIX_H
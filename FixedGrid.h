@@ -0,0 +1,303 @@
+//------------------------------------------------------------------------------
+// File: FixedGrid.h
+// Desc: Maze grid with its size fixed at compile time and no heap use
+//
+// Created: 19 October 2026 21:46:12
+//
+// (c)2002 Neil Wakefield
+//------------------------------------------------------------------------------
+
+
+#ifndef INCLUSIONGUARD_FIXEDGRID_H
+#define INCLUSIONGUARD_FIXEDGRID_H
+
+
+//------------------------------------------------------------------------------
+// Included files:
+//------------------------------------------------------------------------------
+#include "BucketQueue.h"
+#include "Grid.h"
+#include "GridStats.h"
+#include "MazeAlgorithms.h"
+#include "Random.h"
+
+#include "time.h"
+
+
+//------------------------------------------------------------------------------
+// Prototypes and declarations:
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Name: class FixedVector
+// Desc: The parts of vector that MazeGrow needs, over a fixed array
+//------------------------------------------------------------------------------
+template< class Type, int CAPACITY >
+class FixedVector
+{
+
+public:
+	typedef Type* iterator;
+
+	FixedVector() : m_size( 0 ) {}
+
+	iterator begin() { return m_items; }
+	iterator end() { return m_items + m_size; }
+	int size() const { return m_size; }
+
+	void clear() { m_size = 0; }
+	void push_back( const Type& item ) { m_items[ m_size++ ] = item; }
+
+	void erase( iterator item )
+	{
+		for( iterator next = item + 1; next != end(); ++next )
+			*( next - 1 ) = *next;
+		--m_size;
+	}
+
+private:
+	Type m_items[ CAPACITY ];
+	int m_size;
+
+};
+
+//------------------------------------------------------------------------------
+// Name: class FixedGrid
+// Desc: Maze of WIDTH by HEIGHT cells, generated and solved by the same code
+//		 as Grid. Every array lives inside the object, so an instance on the
+//		 stack or in static storage never touches the heap, and the constant
+//		 sizes let the compiler fold the bounds checks and index arithmetic.
+//		 Only the A* solver with the Manhattan heuristic is available, and
+//		 the same seed gives the same maze as a Grid of the same size
+//------------------------------------------------------------------------------
+template< int WIDTH, int HEIGHT >
+class FixedGrid
+{
+
+public:
+	enum
+	{
+		NUM_CELLS = WIDTH * HEIGHT,
+		MAX_STEP = 2 * Grid::MAX_WEIGHT + 1	//largest open list step, as for Grid
+	};
+
+	FixedGrid();
+
+	int GetWidth() const { return WIDTH; }
+	int GetHeight() const { return HEIGHT; }
+	int GetNumCells() const { return NUM_CELLS; }
+
+	int GetCellIndex( const int x, const int y ) const { return y * WIDTH + x; }
+	int GetCellX( const int index ) const { return index % WIDTH; }
+	int GetCellY( const int index ) const { return index / WIDTH; }
+
+	Grid::GridTile GetTile( const int x, const int y ) const
+	{
+		return Grid::GridTile( m_tiles[ GetCellIndex( x, y ) ] );
+	}
+	void SetTile( const int x, const int y, const Grid::GridTile value )
+	{
+		m_tiles[ GetCellIndex( x, y ) ] = (unsigned char)( value );
+	}
+
+	int GetWeight( const int x, const int y ) const { return m_weights[ GetCellIndex( x, y ) ]; }
+	void SetWeight( const int x, const int y, const int weight );
+
+	//the unsigned compares catch negative coordinates too
+	bool IsPath( const int x, const int y ) const
+	{
+		return (unsigned int)( x ) < (unsigned int)( WIDTH ) &&
+			   (unsigned int)( y ) < (unsigned int)( HEIGHT ) &&
+			   Grid::TILE_WALL != GetTile( x, y );
+	}
+
+	int GetStartY() const { return m_startY; }
+	int GetGoalY() const { return m_goalY; }
+
+	void GenerateMaze();
+	void GenerateMaze( const unsigned int seed );
+
+	void GenerateSolution();
+	bool PopNextSolution( MazeSquare& square );
+
+	const GridStats& GetStats() const { return m_stats; }
+
+private:
+	unsigned char m_tiles[ NUM_CELLS ];
+	unsigned char m_weights[ NUM_CELLS ];
+
+	Random m_random;
+	int m_startY;
+	int m_goalY;
+
+	FixedVector< MazeSquare, NUM_CELLS > m_frontier;
+
+	//A* workspace, with the open list attached to arrays held here
+	BucketQueue m_openQueue;
+	int m_queueHeads[ MAX_STEP + 1 ];
+	int m_queueNext[ NUM_CELLS ];
+	int m_queuePrev[ NUM_CELLS ];
+	int m_queuePriority[ NUM_CELLS ];
+	int m_searchCost[ NUM_CELLS ];
+	int m_searchParent[ NUM_CELLS ];
+
+	//the solution includes the squares just outside the entrance and exit
+	MazeSquare m_solution[ NUM_CELLS + 2 ];
+	int m_solutionLength;
+	int m_solutionNext;
+	bool m_solved;
+
+	GridStats m_stats;
+
+	//not copyable, as the open list points into this object
+	FixedGrid( const FixedGrid& );
+	FixedGrid& operator=( const FixedGrid& );
+
+};
+
+
+//------------------------------------------------------------------------------
+// Definitions:
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Name: FixedGrid()
+// Desc: Constructor for the fixed-size grid
+//------------------------------------------------------------------------------
+template< int WIDTH, int HEIGHT >
+FixedGrid< WIDTH, HEIGHT >::FixedGrid()
+{
+	for( int i = 0; i < NUM_CELLS; ++i )
+	{
+		m_tiles[ i ] = (unsigned char)( Grid::TILE_WALL );
+		m_weights[ i ] = (unsigned char)( Grid::MIN_WEIGHT );
+	}
+
+	m_startY = 0;
+	m_goalY = 0;
+
+	m_openQueue.Attach( NUM_CELLS, MAX_STEP, m_queueHeads, m_queueNext,
+						m_queuePrev, m_queuePriority );
+
+	m_solutionLength = 0;
+	m_solutionNext = 0;
+	m_solved = false;
+
+	m_stats.Reset();
+
+	m_random.Seed( (unsigned int)( time( NULL ) ) );
+}
+
+//------------------------------------------------------------------------------
+// Name: SetWeight()
+// Desc: Sets the cost of stepping onto a cell, clamped to the allowed range
+//------------------------------------------------------------------------------
+template< int WIDTH, int HEIGHT >
+void FixedGrid< WIDTH, HEIGHT >::SetWeight( const int x, const int y, const int weight )
+{
+	int clamped = weight;
+	if( clamped < Grid::MIN_WEIGHT )
+		clamped = Grid::MIN_WEIGHT;
+	else if( clamped > Grid::MAX_WEIGHT )
+		clamped = Grid::MAX_WEIGHT;
+
+	m_weights[ GetCellIndex( x, y ) ] = (unsigned char)( clamped );
+}
+
+//------------------------------------------------------------------------------
+// Name: GenerateMaze()
+// Desc: Generates a new maze from a given seed
+//------------------------------------------------------------------------------
+template< int WIDTH, int HEIGHT >
+void FixedGrid< WIDTH, HEIGHT >::GenerateMaze( const unsigned int seed )
+{
+	m_random.Seed( seed );
+	GenerateMaze();
+}
+
+//------------------------------------------------------------------------------
+// Name: GenerateMaze()
+// Desc: Generates a new maze, carrying on from the current random sequence
+//------------------------------------------------------------------------------
+template< int WIDTH, int HEIGHT >
+void FixedGrid< WIDTH, HEIGHT >::GenerateMaze()
+{
+	m_solved = false;
+	m_stats.ResetGenerator();
+	GRID_STAT_TIMER( timer );
+
+	//fill the entire grid with wall squares
+	for( int i = 0; i < NUM_CELLS; ++i )
+	{
+		m_tiles[ i ] = (unsigned char)( Grid::TILE_WALL );
+		m_weights[ i ] = (unsigned char)( Grid::MIN_WEIGHT );
+	}
+
+	GRID_STAT_LAP( m_stats, GridStats::PHASE_GENERATE_FILL, timer );
+
+	//now grow the paths
+	m_frontier.clear();
+	MazeGrow( *this, m_random, m_frontier, m_startY, m_goalY, m_stats );
+
+	GRID_STAT_LAP( m_stats, GridStats::PHASE_GENERATE_GROW, timer );
+}
+
+//------------------------------------------------------------------------------
+// Name: GenerateSolution()
+// Desc: Finds the cheapest path through the maze with an A* search
+//------------------------------------------------------------------------------
+template< int WIDTH, int HEIGHT >
+void FixedGrid< WIDTH, HEIGHT >::GenerateSolution()
+{
+	m_solutionLength = 0;
+	m_solutionNext = 0;
+	m_solved = false;
+	m_stats.ResetSolver();
+	GRID_STAT_TIMER( timer );
+
+	const int startCell = GetCellIndex( 0, m_startY );
+	const int goalCell = GetCellIndex( WIDTH - 1, m_goalY );
+	const MazeSquare goal( WIDTH - 1, m_goalY );
+
+	const ManhattanHeuristic heuristic( &goal, 1 );
+	m_solved = MazeFindPath( *this, startCell, &goalCell, 1, heuristic, m_openQueue,
+							 m_searchCost, m_searchParent, m_stats ) >= 0;
+	GRID_STAT_LAP( m_stats, GridStats::PHASE_SOLVE_SEARCH, timer );
+
+	if( ! m_solved )
+		return;
+
+	//store the solution, walking back from the goal to fill the array in
+	// from the end
+	int length = 2;
+	for( int cell = goalCell; cell >= 0; cell = m_searchParent[ cell ] )
+		++length;
+
+	m_solutionLength = length;
+	m_solution[ --length ] = MazeSquare( WIDTH, m_goalY );
+	for( int cell = goalCell; cell >= 0; cell = m_searchParent[ cell ] )
+		m_solution[ --length ] = MazeSquare( GetCellX( cell ), GetCellY( cell ) );
+	m_solution[ --length ] = MazeSquare( -1, m_startY );
+
+	GRID_STAT_SET( m_stats, solutionLength, (unsigned int)( m_solutionLength - 2 ) );
+	GRID_STAT_SET( m_stats, solutionCost, (unsigned int)( m_searchCost[ goalCell ] ) );
+
+	GRID_STAT_LAP( m_stats, GridStats::PHASE_SOLVE_PATH, timer );
+}
+
+//------------------------------------------------------------------------------
+// Name: PopNextSolution()
+// Desc: Returns the next point in the solution, or FALSE if there isn't one
+//------------------------------------------------------------------------------
+template< int WIDTH, int HEIGHT >
+bool FixedGrid< WIDTH, HEIGHT >::PopNextSolution( MazeSquare& square )
+{
+	if( ! m_solved || m_solutionNext >= m_solutionLength )
+		return false;
+
+	square = m_solution[ m_solutionNext++ ];
+	return true;
+}
+
+
+#endif //INCLUSIONGUARD_FIXEDGRID_H
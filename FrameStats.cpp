@@ -0,0 +1,92 @@
+//------------------------------------------------------------------------------
+// File: FrameStats.cpp
+// Desc: Per-stage frame timing histograms for the application loop
+//
+// Created: 19 October 2026 16:48:15
+//
+// (c)2002 Neil Wakefield
+//------------------------------------------------------------------------------
+
+
+//------------------------------------------------------------------------------
+// Included files:
+//------------------------------------------------------------------------------
+#include "FrameStats.h"
+
+#include <stdio.h>
+
+
+//------------------------------------------------------------------------------
+// Globals:
+//------------------------------------------------------------------------------
+namespace
+{
+	const char* g_stageNames[ FrameStats::NUM_STAGES ] =
+	{
+		"Frame",
+		"FrameMove",
+		"Regenerate",
+		"Render",
+		"Present",
+	};
+}
+
+
+//------------------------------------------------------------------------------
+// Definitions:
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Name: Clear()
+// Desc: Empties every histogram
+//------------------------------------------------------------------------------
+void FrameStats::Clear()
+{
+	for( int i = 0; i < NUM_STAGES; ++i )
+		m_histograms[ i ].Clear();
+}
+
+//------------------------------------------------------------------------------
+// Name: GetStageName()
+// Desc: Returns the display name of a stage
+//------------------------------------------------------------------------------
+const char* FrameStats::GetStageName( const Stage stage )
+{
+	return g_stageNames[ stage ];
+}
+
+//------------------------------------------------------------------------------
+// Name: GetSummary()
+// Desc: Formats one line of percentiles for a stage, in milliseconds
+//------------------------------------------------------------------------------
+string FrameStats::GetSummary( const Stage stage ) const
+{
+	const Histogram& h = m_histograms[ stage ];
+
+	char buffer[ 128 ];
+	sprintf( buffer, "%-10s p50 %7.3fms  p99 %7.3fms  max %7.3fms  (%u)",
+			 g_stageNames[ stage ],
+			 h.GetPercentile( 50.0 ) * 1000.0,
+			 h.GetPercentile( 99.0 ) * 1000.0,
+			 h.GetMax() * 1000.0,
+			 h.GetCount() );
+
+	return string( buffer );
+}
+
+//------------------------------------------------------------------------------
+// Name: GetReport()
+// Desc: Formats the summary for every stage, one per line
+//------------------------------------------------------------------------------
+string FrameStats::GetReport() const
+{
+	string report;
+
+	for( int i = 0; i < NUM_STAGES; ++i )
+	{
+		report += GetSummary( Stage( i ) );
+		report += "\n";
+	}
+
+	return report;
+}
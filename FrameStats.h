@@ -0,0 +1,61 @@
+//------------------------------------------------------------------------------
+// File: FrameStats.h
+// Desc: Per-stage frame timing histograms for the application loop
+//
+// Created: 19 October 2026 16:41:30
+//
+// (c)2002 Neil Wakefield
+//------------------------------------------------------------------------------
+
+
+#ifndef INCLUSIONGUARD_FRAMESTATS_H
+#define INCLUSIONGUARD_FRAMESTATS_H
+
+
+//------------------------------------------------------------------------------
+// Included files:
+//------------------------------------------------------------------------------
+#include "Histogram.h"
+
+#include <string>
+using namespace std;
+
+
+//------------------------------------------------------------------------------
+// Prototypes and declarations:
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Name: class FrameStats
+// Desc: One histogram for each stage of a frame
+//------------------------------------------------------------------------------
+class FrameStats
+{
+
+public:
+	enum Stage
+	{
+		STAGE_FRAME,		//start of one frame to the start of the next
+		STAGE_FRAMEMOVE,	//App::FrameMove, including any regeneration
+		STAGE_REGENERATE,	//generating and solving a new maze
+		STAGE_RENDER,		//App::Render, up to the end of scene submission
+		STAGE_PRESENT,		//end of App::Render to the start of the next frame
+		NUM_STAGES
+	};
+
+	void Record( const Stage stage, const double seconds ) { m_histograms[ stage ].Record( seconds ); }
+	const Histogram& GetHistogram( const Stage stage ) const { return m_histograms[ stage ]; }
+	void Clear();
+
+	string GetSummary( const Stage stage ) const;
+	string GetReport() const;
+
+	static const char* GetStageName( const Stage stage );
+
+private:
+	Histogram m_histograms[ NUM_STAGES ];
+
+};
+
+
+#endif //INCLUSIONGUARD_FRAMESTATS_H
@@ -0,0 +1,154 @@
+//------------------------------------------------------------------------------
+// File: Frustum.cpp
+// Desc: View frustum for culling, built from look-at and projection parameters
+//
+// Created: 19 October 2026 13:26:39
+//
+// (c)2002 Neil Wakefield
+//------------------------------------------------------------------------------
+
+
+//------------------------------------------------------------------------------
+// Included files:
+//------------------------------------------------------------------------------
+#include "Frustum.h"
+
+
+//------------------------------------------------------------------------------
+// Globals:
+//------------------------------------------------------------------------------
+
+
+//------------------------------------------------------------------------------
+// Definitions:
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Name: Frustum()
+// Desc: Constructor for the frustum object
+//------------------------------------------------------------------------------
+Frustum::Frustum()
+{
+	for( int i = 0; i < NUM_PLANES; ++i )
+		m_distances[ i ] = 0.0f;
+
+	m_maxDistance = 0.0f;
+}
+
+//------------------------------------------------------------------------------
+// Name: Build()
+// Desc: Calculates the planes for a camera. Anything further than maxDistance
+//		 from the eye is treated as outside the frustum
+//------------------------------------------------------------------------------
+void Frustum::Build( const Vector3& eye, const Vector3& lookAt, const Vector3& up,
+					 const float fovY, const float aspect,
+					 const float nearZ, const float farZ, const float maxDistance )
+{
+	//camera axes, as D3DXMatrixLookAtLH works them out
+	const Vector3 zAxis = Vec3Normalize( Vec3Subtract( lookAt, eye ) );
+	const Vector3 xAxis = Vec3Normalize( Vec3Cross( up, zAxis ) );
+	const Vector3 yAxis = Vec3Cross( zAxis, xAxis );
+
+	const float tanY = tanf( fovY * 0.5f );
+	const float tanX = tanY * aspect;
+
+	//nothing past the view distance can be seen, so pull the far plane in
+	const float farDist = ( maxDistance < farZ ) ? maxDistance : farZ;
+
+	m_eye = eye;
+	m_maxDistance = maxDistance;
+
+	//near and far planes
+	m_normals[ PLANE_NEAR ] = zAxis;
+	m_distances[ PLANE_NEAR ] = -Vec3Dot( zAxis, Vec3Add( eye, Vec3Scale( zAxis, nearZ ) ) );
+
+	m_normals[ PLANE_FAR ] = Vec3Scale( zAxis, -1.0f );
+	m_distances[ PLANE_FAR ] = Vec3Dot( zAxis, Vec3Add( eye, Vec3Scale( zAxis, farDist ) ) );
+
+	//side planes all pass through the eye
+	m_normals[ PLANE_LEFT ] = Vec3Normalize( Vec3Add( xAxis, Vec3Scale( zAxis, tanX ) ) );
+	m_normals[ PLANE_RIGHT ] = Vec3Normalize( Vec3Subtract( Vec3Scale( zAxis, tanX ), xAxis ) );
+	m_normals[ PLANE_BOTTOM ] = Vec3Normalize( Vec3Add( yAxis, Vec3Scale( zAxis, tanY ) ) );
+	m_normals[ PLANE_TOP ] = Vec3Normalize( Vec3Subtract( Vec3Scale( zAxis, tanY ), yAxis ) );
+
+	for( int i = PLANE_LEFT; i < NUM_PLANES; ++i )
+		m_distances[ i ] = -Vec3Dot( m_normals[ i ], eye );
+
+	//corners of the near and far rectangles, for the footprint
+	for( int i = 0; i < 8; ++i )
+	{
+		const float depth = ( i < 4 ) ? nearZ : farDist;
+		const float sx = ( i & 1 ) ? 1.0f : -1.0f;
+		const float sy = ( i & 2 ) ? 1.0f : -1.0f;
+
+		Vector3 corner = Vec3Add( eye, Vec3Scale( zAxis, depth ) );
+		corner = Vec3Add( corner, Vec3Scale( xAxis, sx * tanX * depth ) );
+		corner = Vec3Add( corner, Vec3Scale( yAxis, sy * tanY * depth ) );
+		m_corners[ i ] = corner;
+	}
+}
+
+//------------------------------------------------------------------------------
+// Name: IsBoxVisible()
+// Desc: Checks to see if an axis-aligned box is at least partly inside
+//------------------------------------------------------------------------------
+bool Frustum::IsBoxVisible( const Vector3& boxMin, const Vector3& boxMax ) const
+{
+	for( int i = 0; i < NUM_PLANES; ++i )
+	{
+		//test the corner furthest along the plane normal
+		const Vector3& n = m_normals[ i ];
+		const Vector3 p( ( n.x >= 0.0f ) ? boxMax.x : boxMin.x,
+						 ( n.y >= 0.0f ) ? boxMax.y : boxMin.y,
+						 ( n.z >= 0.0f ) ? boxMax.z : boxMin.z );
+
+		if( Vec3Dot( n, p ) + m_distances[ i ] < 0.0f )
+			return false;
+	}
+
+	//distance from the eye to the nearest point of the box
+	float dx = 0.0f, dy = 0.0f, dz = 0.0f;
+	if( m_eye.x < boxMin.x ) dx = boxMin.x - m_eye.x;
+	else if( m_eye.x > boxMax.x ) dx = m_eye.x - boxMax.x;
+	if( m_eye.y < boxMin.y ) dy = boxMin.y - m_eye.y;
+	else if( m_eye.y > boxMax.y ) dy = m_eye.y - boxMax.y;
+	if( m_eye.z < boxMin.z ) dz = boxMin.z - m_eye.z;
+	else if( m_eye.z > boxMax.z ) dz = m_eye.z - boxMax.z;
+
+	return ( dx * dx + dy * dy + dz * dz ) <= m_maxDistance * m_maxDistance;
+}
+
+//------------------------------------------------------------------------------
+// Name: IsSphereVisible()
+// Desc: Checks to see if a sphere is at least partly inside
+//------------------------------------------------------------------------------
+bool Frustum::IsSphereVisible( const Vector3& centre, const float radius ) const
+{
+	for( int i = 0; i < NUM_PLANES; ++i )
+	{
+		if( Vec3Dot( m_normals[ i ], centre ) + m_distances[ i ] < -radius )
+			return false;
+	}
+
+	const Vector3 offset = Vec3Subtract( centre, m_eye );
+	const float range = m_maxDistance + radius;
+	return Vec3Dot( offset, offset ) <= range * range;
+}
+
+//------------------------------------------------------------------------------
+// Name: GetFootprint()
+// Desc: Returns the x/y extent of the frustum, for picking candidate chunks
+//------------------------------------------------------------------------------
+void Frustum::GetFootprint( float& minX, float& minY, float& maxX, float& maxY ) const
+{
+	minX = maxX = m_corners[ 0 ].x;
+	minY = maxY = m_corners[ 0 ].y;
+
+	for( int i = 1; i < 8; ++i )
+	{
+		if( m_corners[ i ].x < minX ) minX = m_corners[ i ].x;
+		if( m_corners[ i ].x > maxX ) maxX = m_corners[ i ].x;
+		if( m_corners[ i ].y < minY ) minY = m_corners[ i ].y;
+		if( m_corners[ i ].y > maxY ) maxY = m_corners[ i ].y;
+	}
+}
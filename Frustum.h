@@ -0,0 +1,62 @@
+//------------------------------------------------------------------------------
+// File: Frustum.h
+// Desc: View frustum for culling, built from look-at and projection parameters
+//
+// Created: 19 October 2026 13:17:02
+//
+// (c)2002 Neil Wakefield
+//------------------------------------------------------------------------------
+
+
+#ifndef INCLUSIONGUARD_FRUSTUM_H
+#define INCLUSIONGUARD_FRUSTUM_H
+
+
+//------------------------------------------------------------------------------
+// Included files:
+//------------------------------------------------------------------------------
+#include "Vector3.h"
+
+
+//------------------------------------------------------------------------------
+// Prototypes and declarations:
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Name: class Frustum
+// Desc: Six inward-facing planes matching D3DXMatrixLookAtLH and
+//		 D3DXMatrixPerspectiveFovLH, plus a maximum view distance from the eye
+//------------------------------------------------------------------------------
+class Frustum
+{
+
+public:
+	Frustum();
+
+	void Build( const Vector3& eye, const Vector3& lookAt, const Vector3& up,
+				const float fovY, const float aspect,
+				const float nearZ, const float farZ, const float maxDistance );
+
+	bool IsBoxVisible( const Vector3& boxMin, const Vector3& boxMax ) const;
+	bool IsSphereVisible( const Vector3& centre, const float radius ) const;
+	void GetFootprint( float& minX, float& minY, float& maxX, float& maxY ) const;
+
+private:
+	enum Plane { PLANE_NEAR, PLANE_FAR, PLANE_LEFT, PLANE_RIGHT,
+				 PLANE_BOTTOM, PLANE_TOP, NUM_PLANES };
+
+	Vector3 m_normals[ NUM_PLANES ];
+	float m_distances[ NUM_PLANES ];
+
+	Vector3 m_eye;
+	float m_maxDistance;
+
+	Vector3 m_corners[ 8 ];
+
+	//tests four spheres at a time against the planes
+	friend class InstanceBuffer;
+
+};
+
+
+#endif //INCLUSIONGUARD_FRUSTUM_H
@@ -12,13 +12,123 @@
 // Included files:
 //------------------------------------------------------------------------------
 #include "Grid.h"
+#include "MazeAlgorithms.h"
+#include "SolutionCache.h"
 
 #include "time.h"
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
 
 
 //------------------------------------------------------------------------------
 // Globals:
 //------------------------------------------------------------------------------
+namespace
+{
+	//scrambles a value so that nearby inputs give unrelated hashes
+	uint64 MixHash( uint64 value )
+	{
+		value = ( value ^ ( value >> 30 ) ) * MAKE_UINT64( 0xbf58476d, 0x1ce4e5b9 );
+		value = ( value ^ ( value >> 27 ) ) * MAKE_UINT64( 0x94d049bb, 0x133111eb );
+		return value ^ ( value >> 31 );
+	}
+
+	//the grid hash is the XOR of one of these per cell, so changing a cell
+	// just swaps its old key for the new one
+	uint64 GetCellKey( const int index, const int tile, const int weight )
+	{
+		return MixHash( ( uint64( index ) << 6 ) | uint64( tile << 4 ) | uint64( weight ) );
+	}
+
+	//log2 of the block width for each blocked layout. 8x8 blocks of tiles fill
+	// a single cache line, and 32x32 Morton blocks keep locality over a
+	// range of distances without padding small grids out too far
+	const int g_blockedShift = 3;
+	const int g_mortonShift = 5;
+
+	//spreads the bits of a value out to every other bit
+	int SpreadBits( const int value )
+	{
+		int spread = 0;
+		for( int bit = 0; ( value >> bit ) != 0; ++bit )
+			spread |= ( ( value >> bit ) & 1 ) << ( bit * 2 );
+
+		return spread;
+	}
+
+	//the larger of the Manhattan and landmark bounds, for MazeFindPath
+	struct LandmarkHeuristic
+	{
+		LandmarkHeuristic( const Grid& grid, const Landmarks& landmarks,
+						   const MazeSquare* pGoals, const int numGoals )
+			: pGrid( &grid ), pLandmarks( &landmarks ), manhattan( pGoals, numGoals ) {}
+
+		int operator()( const int x, const int y ) const
+		{
+			const int bound = manhattan( x, y );
+			const int landmark = pLandmarks->Estimate( *pGrid, pGrid->GetCellIndex( x, y ) );
+			return ( landmark > bound ) ? landmark : bound;
+		}
+
+		const Grid* pGrid;
+		const Landmarks* pLandmarks;
+		ManhattanHeuristic manhattan;
+	};
+
+	//how far a disc may graze a wall during the line of sight test, so that
+	// one exactly as wide as a corridor still fits along it
+	const float g_lineOfSightSlack = 0.001f;
+
+	//checks to see if a segment passes through the inside of a box
+	bool SegmentCrossesBox( const float x0, const float y0, const float x1, const float y1,
+							const float minX, const float minY, const float maxX, const float maxY )
+	{
+		float enter = 0.0f;
+		float leave = 1.0f;
+
+		const float start[ 2 ] = { x0, y0 };
+		const float delta[ 2 ] = { x1 - x0, y1 - y0 };
+		const float boxMin[ 2 ] = { minX, minY };
+		const float boxMax[ 2 ] = { maxX, maxY };
+		for( int axis = 0; axis < 2; ++axis )
+		{
+			if( 0.0f == delta[ axis ] )
+			{
+				if( start[ axis ] <= boxMin[ axis ] || start[ axis ] >= boxMax[ axis ] )
+					return false;
+				continue;
+			}
+
+			float t0 = ( boxMin[ axis ] - start[ axis ] ) / delta[ axis ];
+			float t1 = ( boxMax[ axis ] - start[ axis ] ) / delta[ axis ];
+			if( t0 > t1 )
+			{
+				const float swap = t0;
+				t0 = t1;
+				t1 = swap;
+			}
+
+			if( t0 > enter )
+				enter = t0;
+			if( t1 < leave )
+				leave = t1;
+			if( enter >= leave )
+				return false;
+		}
+
+		return true;
+	}
+
+	//a square on the route held by the memory-bounded search
+	struct SearchFrame
+	{
+		int cell;
+		int cost;
+		int direction;	//next direction to try
+	};
+}
 
 
 //------------------------------------------------------------------------------
@@ -29,10 +139,182 @@
 // Name: Grid()
 // Desc: Constructor for the game grid object
 //------------------------------------------------------------------------------
-Grid::Grid()
+Grid::Grid( const int width, const int height, const Layout layout )
 {
+	m_width = width;
+	m_height = height;
+	SetupLayout( layout );
+
+	//the blocked layouts round the grid up to whole blocks
+	const int blockSize = 1 << m_blockShift;
+	const int numCells = m_blocksX * ( ( m_height + blockSize - 1 ) >> m_blockShift ) *
+						 blockSize * blockSize;
+	m_tiles.assign( numCells, (unsigned char)( TILE_WALL ) );
+	m_weights.assign( m_tiles.size(), (unsigned char)( MIN_WEIGHT ) );
+	m_hash = ComputeHash();
+
+	m_startY = 0;
+	m_goalY = 0;
+
+	m_numExits = 1;
+	m_exits.assign( 1, MazeSquare( m_width - 1, m_goalY ) );
+	m_exitCells.assign( 1, GetCellIndex( m_width - 1, m_goalY ) );
+	m_chosenExit = -1;
+
 	m_solved = false;
 	m_solution.clear();
+	m_solutionNext = 0;
+	m_solutionCost = 0;
+	m_solver = SOLVER_ASTAR;
+	m_heuristic = HEURISTIC_MANHATTAN;
+	m_pathSmoothing = false;
+	m_braidFactor = 0.0f;
+	m_memoryBudget = CONST_SOLVER_MEMORY_BYTES;
+	m_numThreads = GetNumProcessors();
+	m_pSolutionCache = NULL;
+	m_pTrace = NULL;
+
+	m_dirtyChunks.Resize( m_width, m_height );
+	m_hierarchy.Resize( m_width, m_height );
+
+	m_random.Seed( (unsigned int)( time( NULL ) ) );
+}
+
+//------------------------------------------------------------------------------
+// Name: SetupLayout()
+// Desc: Fills in the index lookups for a cell layout. The blocked layouts
+//		 store whole blocks one after another, row by row, and order the cells
+//		 within a block either row by row or along a Morton curve
+//------------------------------------------------------------------------------
+void Grid::SetupLayout( const Layout layout )
+{
+	m_layout = layout;
+	m_blockShift = 0;
+	if( LAYOUT_BLOCKED == layout )
+		m_blockShift = g_blockedShift;
+	else if( LAYOUT_MORTON == layout )
+		m_blockShift = g_mortonShift;
+
+	const int blockSize = 1 << m_blockShift;
+	const int blockCells = blockSize * blockSize;
+	m_blockMask = blockCells - 1;
+	m_blocksX = ( m_width + blockSize - 1 ) >> m_blockShift;
+
+	m_offsetX.resize( m_width );
+	m_offsetY.resize( m_height );
+
+	if( 0 == m_blockShift )
+	{
+		for( int x = 0; x < m_width; ++x )
+			m_offsetX[ x ] = x;
+		for( int y = 0; y < m_height; ++y )
+			m_offsetY[ y ] = y * m_width;
+
+		m_localX.clear();
+		m_localY.clear();
+		return;
+	}
+
+	//both blocked orders split into a part from x and a part from y
+	const int mask = blockSize - 1;
+	for( int x = 0; x < m_width; ++x )
+	{
+		const int local = ( LAYOUT_MORTON == layout ) ? SpreadBits( x & mask ) : ( x & mask );
+		m_offsetX[ x ] = ( ( x >> m_blockShift ) * blockCells ) + local;
+	}
+	for( int y = 0; y < m_height; ++y )
+	{
+		const int local = ( LAYOUT_MORTON == layout ) ? ( SpreadBits( y & mask ) << 1 ) :
+														( ( y & mask ) << m_blockShift );
+		m_offsetY[ y ] = ( ( y >> m_blockShift ) * m_blocksX * blockCells ) + local;
+	}
+
+	m_localX.resize( blockCells );
+	m_localY.resize( blockCells );
+	for( int y = 0; y < blockSize; ++y )
+	{
+		for( int x = 0; x < blockSize; ++x )
+		{
+			const int local = ( LAYOUT_MORTON == layout ) ? ( SpreadBits( x ) | ( SpreadBits( y ) << 1 ) ) :
+															( ( y << m_blockShift ) | x );
+			m_localX[ local ] = (unsigned char)( x );
+			m_localY[ local ] = (unsigned char)( y );
+		}
+	}
+}
+
+//------------------------------------------------------------------------------
+// Name: SetTile()
+// Desc: Changes a tile, marking the chunks and clusters that depend on it
+//------------------------------------------------------------------------------
+void Grid::SetTile( const int x, const int y, const GridTile value )
+{
+	const int index = GetCellIndex( x, y );
+	m_hash ^= GetCellKey( index, m_tiles[ index ], m_weights[ index ] ) ^
+			  GetCellKey( index, value, m_weights[ index ] );
+
+	m_tiles[ index ] = (unsigned char)( value );
+	m_dirtyChunks.MarkTile( x, y );
+	m_hierarchy.MarkTile( x, y );
+}
+
+//------------------------------------------------------------------------------
+// Name: SetWeight()
+// Desc: Sets the cost of stepping onto a cell, clamped to the allowed range
+//------------------------------------------------------------------------------
+void Grid::SetWeight( const int x, const int y, const int weight )
+{
+	int clamped = weight;
+	if( clamped < MIN_WEIGHT )
+		clamped = MIN_WEIGHT;
+	else if( clamped > MAX_WEIGHT )
+		clamped = MAX_WEIGHT;
+
+	const int index = GetCellIndex( x, y );
+	m_hash ^= GetCellKey( index, m_tiles[ index ], m_weights[ index ] ) ^
+			  GetCellKey( index, m_tiles[ index ], clamped );
+
+	m_weights[ index ] = (unsigned char)( clamped );
+	m_hierarchy.MarkTile( x, y );
+}
+
+//------------------------------------------------------------------------------
+// Name: ComputeHash()
+// Desc: Works the hash out from scratch. GetHash() gives the same value
+//		 without visiting every cell
+//------------------------------------------------------------------------------
+uint64 Grid::ComputeHash() const
+{
+	uint64 hash = MixHash( ~( ( uint64( m_width ) << 32 ) | uint64( m_height ) ) );
+	for( int i = 0; i < GetNumCells(); ++i )
+		hash ^= GetCellKey( i, m_tiles[ i ], m_weights[ i ] );
+
+	return hash;
+}
+
+//------------------------------------------------------------------------------
+// Name: SetBraidFactor()
+// Desc: Sets the fraction of dead ends to remove, from 0 for a perfect maze
+//		 with a single route to 1 for one with no dead ends at all
+//------------------------------------------------------------------------------
+void Grid::SetBraidFactor( const float factor )
+{
+	if( factor < 0.0f )
+		m_braidFactor = 0.0f;
+	else if( factor > 1.0f )
+		m_braidFactor = 1.0f;
+	else
+		m_braidFactor = factor;
+}
+
+//------------------------------------------------------------------------------
+// Name: GenerateMaze()
+// Desc: Generates a maze from a given seed, so it can be reproduced
+//------------------------------------------------------------------------------
+void Grid::GenerateMaze( const unsigned int seed )
+{
+	m_random.Seed( seed );
+	GenerateMaze();
 }
 
 //------------------------------------------------------------------------------
@@ -41,225 +323,255 @@ Grid::Grid()
 //------------------------------------------------------------------------------
 void Grid::GenerateMaze()
 {
-	m_solved = false;
+	m_stats.ResetGenerator();
+	GRID_STAT_TIMER( timer );
 
-	srand( unsigned int( time( NULL ) ) );
+	ResetMaze();
 
-	vector< MazeSquare > path;	//list of all path squares so far
+	GRID_STAT_LAP( m_stats, GridStats::PHASE_GENERATE_FILL, timer );
 
-	bool foundExit = false; //have we found an exit
+	//now grow the paths
+	if( m_pTrace != NULL )
+		m_pTrace->Begin( m_width, m_height );
+	TrackedVector< MazeSquare, MemoryTracker::SUBSYSTEM_GENERATOR >::Type path;	//all path squares so far
+	MazeGrow( *this, m_random, path, m_startY, m_goalY, m_stats, m_pTrace );
+
+	m_exits.assign( 1, MazeSquare( m_width - 1, m_goalY ) );
+	m_exitCells.assign( 1, GetCellIndex( m_width - 1, m_goalY ) );
+	if( m_numExits > 1 )
+		AddExits();
+
+	GRID_STAT_LAP( m_stats, GridStats::PHASE_GENERATE_GROW, timer );
+
+	if( m_braidFactor > 0.0f )
+	{
+		BraidMaze();
+		GRID_STAT_LAP( m_stats, GridStats::PHASE_GENERATE_BRAID, timer );
+	}
+}
+
+//------------------------------------------------------------------------------
+// Name: ResetMaze()
+// Desc: Fills the grid with wall and forgets the exits and any solution
+//------------------------------------------------------------------------------
+void Grid::ResetMaze()
+{
+	m_solved = false;
+	m_solution.clear();
+	m_solutionNext = 0;
+	m_solutionCost = 0;
+	m_chosenExit = -1;
+	m_exits.clear();
+	m_exitCells.clear();
 
 	//fill the entire grid with wall squares
-	for( int y = 0; y < GRID_SIZE; ++y )
+	for( int y = 0; y < m_height; ++y )
 	{
-		for( int x = 0; x < GRID_SIZE; ++x )
+		for( int x = 0; x < m_width; ++x )
 		{
 			SetTile( x, y, TILE_WALL );
+			SetWeight( x, y, MIN_WEIGHT );
 		}
 	}
+}
+
+//------------------------------------------------------------------------------
+// Name: AddExits()
+// Desc: Turns path squares on the border, picked at random, into exits until
+//		 there are as many as asked for or none are left
+//------------------------------------------------------------------------------
+void Grid::AddExits()
+{
+	TrackedVector< MazeSquare, MemoryTracker::SUBSYSTEM_GENERATOR >::Type candidates;
+	for( int x = 0; x < m_width; ++x )
+	{
+		if( TILE_PATH == GetTile( x, 0 ) )
+			candidates.push_back( MazeSquare( x, 0 ) );
+		if( m_height > 1 && TILE_PATH == GetTile( x, m_height - 1 ) )
+			candidates.push_back( MazeSquare( x, m_height - 1 ) );
+	}
+	for( int y = 1; y < m_height - 1; ++y )
+	{
+		if( TILE_PATH == GetTile( 0, y ) )
+			candidates.push_back( MazeSquare( 0, y ) );
+		if( m_width > 1 && TILE_PATH == GetTile( m_width - 1, y ) )
+			candidates.push_back( MazeSquare( m_width - 1, y ) );
+	}
+
+	while( int( m_exits.size() ) < m_numExits && ! candidates.empty() )
+	{
+		const int pick = int( m_random.Next( (unsigned int)( candidates.size() ) ) );
+		GRID_STAT_INC( m_stats, randomDraws );
+
+		const MazeSquare exit = candidates[ pick ];
+		candidates[ pick ] = candidates.back();
+		candidates.pop_back();
+
+		SetTile( exit.x, exit.y, TILE_GOAL );
+		if( m_pTrace != NULL )
+			m_pTrace->RecordTile( exit.x, exit.y, TILE_GOAL );
+		m_exits.push_back( exit );
+		m_exitCells.push_back( GetCellIndex( exit.x, exit.y ) );
+	}
+}
+
+//------------------------------------------------------------------------------
+// Name: GetExitOutside()
+// Desc: Returns the square just beyond the border from an exit. Exits in a
+//		 corner lead out sideways
+//------------------------------------------------------------------------------
+MazeSquare Grid::GetExitOutside( const int index ) const
+{
+	const MazeSquare& exit = m_exits[ index ];
+	if( m_width - 1 == exit.x )
+		return MazeSquare( m_width, exit.y );
+	if( 0 == exit.x )
+		return MazeSquare( -1, exit.y );
+	if( m_height - 1 == exit.y )
+		return MazeSquare( exit.x, m_height );
 
-	//pick a random starting point in the left hand column
-	m_startY = rand() % GRID_SIZE;
-	SetTile( 0, m_startY, TILE_START );
+	return MazeSquare( exit.x, -1 );
+}
+
+//------------------------------------------------------------------------------
+// Name: FindExit()
+// Desc: Returns the index of the exit at a cell, or -1 if it isn't one
+//------------------------------------------------------------------------------
+int Grid::FindExit( const int cell ) const
+{
+	for( size_t i = 0; i < m_exitCells.size(); ++i )
+		if( m_exitCells[ i ] == cell )
+			return int( i );
 
-	//record this square
-	MazeSquare square;
-	square.y = m_startY;
-	square.x = 0;
-	path.push_back( square );
+	return -1;
+}
 
-	//now grow the paths from here
-	while( 1 )
+//------------------------------------------------------------------------------
+// Name: BraidMaze()
+// Desc: Removes a fraction of the dead ends by knocking out a wall at the end
+//		 of each, joining it to a neighbouring corridor to make a loop
+//------------------------------------------------------------------------------
+void Grid::BraidMaze()
+{
+	//find the dead ends - the start and goal are left alone
+	TrackedVector< int, MemoryTracker::SUBSYSTEM_GENERATOR >::Type deadEnds;
+	for( int y = 0; y < m_height; ++y )
 	{
-		if( 0 == path.size() )
+		for( int x = 0; x < m_width; ++x )
 		{
-			//no more elements left to expand from, this shouldn't actually happen
-			break;
+			if( TILE_PATH == GetTile( x, y ) && 1 == CountOpenNeighbours( x, y ) )
+				deadEnds.push_back( GetCellIndex( x, y ) );
 		}
+	}
 
-		//take a random square from the path list
-		vector< MazeSquare >::iterator currentSquare = path.begin();
-		advance( currentSquare, rand() % int( path.size() ) );
+	//visit them in random order, so the loops are spread across the maze
+	for( int i = int( deadEnds.size() ) - 1; i > 0; --i )
+	{
+		const int j = int( m_random.Next( (unsigned int)( i + 1 ) ) );
+		GRID_STAT_INC( m_stats, randomDraws );
+		const int swap = deadEnds[ i ];
+		deadEnds[ i ] = deadEnds[ j ];
+		deadEnds[ j ] = swap;
+	}
 
-		square = *currentSquare;
-		int x = square.x;
-		int y = square.y;
+	const int target = int( m_braidFactor * deadEnds.size() + 0.5f );
+	int removed = 0;
+	for( size_t i = 0; i < deadEnds.size() && removed < target; ++i )
+	{
+		const int x = GetCellX( deadEnds[ i ] );
+		const int y = GetCellY( deadEnds[ i ] );
 
-		//pick a random direction to move in from this square
-		Direction d = Direction( rand() % 4 );
-		int newD = int( d );
+		//an earlier loop may already have joined this one up
+		if( CountOpenNeighbours( x, y ) != 1 )
+			continue;
 
-		//see if this square is valid
-		MoveInDirection( x, y, d );
-		if( ! CanPlacePath( x, y ) )
+		//pick one of the walls that would join onto another corridor
+		int candidates[ 4 ][ 2 ];
+		int numCandidates = 0;
+		for( int d = 0; d < 4; ++d )
 		{
-			//try next direction
-			x = square.x;
-			y = square.y;
-			int newd = int( d );
-			++newd; newd %= 4; d = Direction( newd );
-			MoveInDirection( x, y, d );
-			
-			if( ! CanPlacePath( x, y ) )
+			int wallX = x;
+			int wallY = y;
+			MoveInDirection( wallX, wallY, Direction( d ) );
+			if( CanOpenWall( wallX, wallY ) )
 			{
-				//try next direction
-				x = square.x;
-				y = square.y;
-				++newd; newd %= 4; d = Direction( newd );
-				MoveInDirection( x, y, d );
-				
-				if( ! CanPlacePath( x, y ) )
-				{
-					//try next direction
-					x = square.x;
-					y = square.y;
-					++newd; newd %= 4; d = Direction( newd );
-					MoveInDirection( x, y, d );
-					if( ! CanPlacePath( x, y ) )
-					{
-						//all four directions tried, so this path is useless
-						//remove it from the places-to-try list
-						path.erase( currentSquare );
-						continue;
-					}
-				}
+				candidates[ numCandidates ][ 0 ] = wallX;
+				candidates[ numCandidates ][ 1 ] = wallY;
+				++numCandidates;
 			}
 		}
+		if( 0 == numCandidates )
+			continue;
 
-		//if we get this far, x,y should contain the location of the next sqaure to
-		// add to the path
-		SetTile( x, y, TILE_PATH );
-		square.x = x;
-		square.y = y;
-		path.push_back( square );
-
-		//see if this path is a valid exit
-		if( x == ( GRID_SIZE - 1 ) )
-		{
-			//if we haven't already found an exit, use this one
-			if( ! foundExit )
-			{
-				//set this tile to the goal
-				SetTile( x, y, TILE_GOAL );
-				m_goalY = y;
-
-				foundExit = true;
+		const int pick = int( m_random.Next( (unsigned int)( numCandidates ) ) );
+		GRID_STAT_INC( m_stats, randomDraws );
+		SetTile( candidates[ pick ][ 0 ], candidates[ pick ][ 1 ], TILE_PATH );
+		if( m_pTrace != NULL )
+			m_pTrace->RecordTile( candidates[ pick ][ 0 ], candidates[ pick ][ 1 ], TILE_PATH );
 
-				//the maze is complete, but continue until all possible squares have been
-				//used so we don't end up with large areas of wall
-			}
-		}
+		++removed;
+		GRID_STAT_INC( m_stats, deadEndsRemoved );
 	}
 }
 
 //------------------------------------------------------------------------------
-// Name: CanPlacePath()
-// Desc: Checks to see if putting a path at a given point would break the maze
+// Name: CanOpenWall()
+// Desc: Checks to see if opening a wall next to a dead end would join it to
+//		 another corridor, without leaving a 2x2 open area as MazeCanPlacePath
+//		 also avoids
 //------------------------------------------------------------------------------
-bool Grid::CanPlacePath( const int x, const int y )
+bool Grid::CanOpenWall( const int x, const int y ) const
 {
-	//make sure the square is inside the bounds of the grid
-	if( ( x < 0 ) || ( x >= GRID_SIZE ) ||
-		( y < 0 ) || ( y >= GRID_SIZE ) )
+	if( x < 0 || x >= m_width || y < 0 || y >= m_height )
 		return false;
 
-	//check to see if this square is already a path
 	if( TILE_WALL != GetTile( x, y ) )
 		return false;
 
-	//check to see if this square would cause a loop
-	// this would happen if the square was touching two or more path squares
-	bool foundOneSquare = false;
-
-	//track paths found - we need these to constrain diagonals
-	bool foundLeft = false;
-	bool foundRight = false;
-	bool foundUp = false;
-	bool foundDown = false;
-
-	bool minX = ( x <= 0 );
-	bool maxX = ( x >= ( GRID_SIZE - 1 ) );
-	bool minY = ( y <= 0 );
-	bool maxY = ( y >= ( GRID_SIZE - 1 ) );
-
-	//up
-	if( !minY )
-		if( TILE_WALL != GetTile( x, y - 1 ) )
-		{
-			foundOneSquare = true;
-			foundUp = true;
-		}
-
-	//right
-	if( !maxX )
-		if( TILE_WALL != GetTile( x + 1, y ) )
-			if( foundOneSquare )
-				return false;
-			else
-			{
-				foundOneSquare = true;
-				foundRight = true;
-			}
-		
-	//down
-	if( !maxY )
-		if( TILE_WALL != GetTile( x, y + 1 ) )
-			if( foundOneSquare )
-				return false;
-			else
-			{
-				foundOneSquare = true;
-				foundDown = true;
-			}
-
-	//left
-	if( !minX )
-		if( TILE_WALL != GetTile( x - 1, y ) )
-			if( foundOneSquare )
-				return false;
-			else
-			{
-				foundOneSquare = true;
-				foundLeft = true;
-			}
-
-	//add some constraints to creating diagonals as this results in ugly mazes
-	//upper-left
-	if( !minY && !minX )
-		if( TILE_WALL != GetTile( x - 1, y - 1 ) )
-			if( ! foundLeft && ! foundUp )
-				return false;
-			else
-				foundOneSquare = true;
-
-	//upper-right
-	if( !minY && !maxX )
-		if( TILE_WALL != GetTile( x + 1, y - 1 ) )
-			if( ! foundRight && ! foundUp )
-				return false;
-			else
-				foundOneSquare = true;
-
-	//lower-right
-	if( !maxY && !maxX )
-		if( TILE_WALL != GetTile( x + 1, y + 1 ) )
-			if( ! foundRight && ! foundDown )
-				return false;
-			else
-				foundOneSquare = true;
-
-	//lower-left
-	if( !minX && !maxY )
-		if( TILE_WALL != GetTile( x - 1, y + 1 ) )
-			if( ! foundLeft && ! foundDown )
-				return false;
-			else
-				foundOneSquare = true;
-
-	//must be a valid place to put a path
+	//must reach something other than the dead end itself
+	if( CountOpenNeighbours( x, y ) < 2 )
+		return false;
+
+	//check the four 2x2 blocks that include this cell
+	for( int dy = -1; dy <= 0; ++dy )
+	{
+		for( int dx = -1; dx <= 0; ++dx )
+		{
+			bool allOpen = true;
+			for( int j = 0; j < 2 && allOpen; ++j )
+			{
+				for( int i = 0; i < 2 && allOpen; ++i )
+				{
+					const int cellX = x + dx + i;
+					const int cellY = y + dy + j;
+					if( cellX != x || cellY != y )
+						allOpen = IsPath( cellX, cellY );
+				}
+			}
+
+			if( allOpen )
+				return false;
+		}
+	}
+
 	return true;
 }
 
+//------------------------------------------------------------------------------
+// Name: CountOpenNeighbours()
+// Desc: Counts the open squares directly next to a square
+//------------------------------------------------------------------------------
+int Grid::CountOpenNeighbours( const int x, const int y ) const
+{
+	int count = 0;
+	if( IsPath( x, y - 1 ) ) ++count;
+	if( IsPath( x + 1, y ) ) ++count;
+	if( IsPath( x, y + 1 ) ) ++count;
+	if( IsPath( x - 1, y ) ) ++count;
+
+	return count;
+}
+
 //------------------------------------------------------------------------------
 // Name: MoveInDirection()
 // Desc: Moves along the grid one unit in the specified direction
@@ -278,175 +590,488 @@ void Grid::MoveInDirection( int& x, int& y, const Direction d )
 
 //------------------------------------------------------------------------------
 // Name: GenerateSolution()
-// Desc: Finds the path through the maze
+// Desc: Finds the path through the maze using the selected solver, or copies
+//		 it from the solution cache if this maze has been solved before
 //------------------------------------------------------------------------------
 void Grid::GenerateSolution()
 {
 	m_solution.clear();
+	m_solutionNext = 0;
+	m_solutionCost = 0;
+	m_solved = false;
+	m_chosenExit = -1;
+	m_stats.ResetSolver();
+
+	//the exits are goal tiles, so the hash already tells them apart
+	SolutionKey key;
+	key.hash = m_hash;
+	key.startCell = GetCellIndex( 0, m_startY );
+	key.goalCell = m_exitCells[ 0 ];
+	key.solver = int( m_solver );
 
-	vector< StateNode* > openList;
-	vector< StateNode* > closedList;
-	vector< StateNode* >::iterator iter;
-	vector< StateNode* >::iterator currentNode;
-	StateNode* pNode = NULL;
+	GRID_STAT_TIMER( timer );
+	if( m_pSolutionCache != NULL && m_pSolutionCache->Find( key, m_solution ) )
+	{
+		const MazeSquare& last = m_solution[ m_solution.size() - 2 ];
+		m_chosenExit = FindExit( GetCellIndex( last.x, last.y ) );
+		m_solved = true;
+		GRID_STAT_SET( m_stats, solutionLength, (unsigned int)( m_solution.size() - 2 ) );
+		GRID_STAT_SET( m_stats, solutionCost, (unsigned int)( SumSolutionCost() ) );
+	}
+	else
+	{
+		if( SOLVER_HIERARCHICAL == m_solver )
+			SolveHierarchical();
+		else if( SOLVER_MEMORY_BOUNDED == m_solver )
+			SolveMemoryBounded();
+		else if( SOLVER_PARALLEL == m_solver )
+			SolveParallel();
+		else
+			SolveAStar();
+
+		//the cache packs single steps, so it takes the path before smoothing
+		if( m_solved && m_pSolutionCache != NULL )
+			m_pSolutionCache->Store( key, m_solution );
+	}
+
+	//smoothing leaves only the waypoints, so the cost is taken from every step
+	// of the path before it runs
+	if( m_solved )
+		m_solutionCost = SumSolutionCost();
+	if( m_solved && m_pathSmoothing )
+		SmoothSolution();
+	GRID_STAT_LAP( m_stats, GridStats::PHASE_SOLVE_PATH, timer );
+}
+
+//------------------------------------------------------------------------------
+// Name: SmoothSolution()
+// Desc: Drops the waypoints a player could walk straight past. Each run of
+//		 squares is replaced by a straight line from its first square to the
+//		 furthest one in sight, keeping the player's clearance from the walls
+//		 and never crossing a cell heavier than the heaviest in the run
+//------------------------------------------------------------------------------
+void Grid::SmoothSolution()
+{
+	if( m_solution.size() < 4 )
+		return;
 
-	StateNode* states[ GRID_SIZE ][ GRID_SIZE ];
-	memset( states, 0, GRID_SIZE * GRID_SIZE * sizeof( StateNode* ) );
+	//the first and last squares lie outside the grid and are kept as they are
+	m_unsmoothed.swap( m_solution );
+	const SquareVector& squares = m_unsmoothed;
+	const size_t last = squares.size() - 1;
 
-	//create the start node
-	pNode = new StateNode( NULL, 0, m_startY, 0, 0 );
-	states[ m_startY ][ 0 ] = pNode;
-	openList.push_back( pNode );
-	pNode = NULL;
+	m_solution.clear();
+	m_solution.push_back( squares[ 0 ] );
+	m_solution.push_back( squares[ 1 ] );
 
-	while( openList.size() != 0 )	//there are still nodes on the open list
+	size_t anchor = 1;
+	int runWeight = GetWeight( squares[ 1 ].x, squares[ 1 ].y );
+	for( size_t i = 2; i < last; ++i )
 	{
-        //find the node on the open list with the lowest total cost
-		currentNode = ( iter = openList.begin() );
+		int weight = GetWeight( squares[ i ].x, squares[ i ].y );
+		if( weight < runWeight )
+			weight = runWeight;
+
+		if( HasLineOfSight( squares[ anchor ].x, squares[ anchor ].y, squares[ i ].x, squares[ i ].y,
+							CONST_PLAYER_SIZE, weight ) )
+		{
+			runWeight = weight;
+			continue;
+		}
+
+		//start a new run from the last square that was in sight
+		anchor = i - 1;
+		m_solution.push_back( squares[ anchor ] );
+		runWeight = GetWeight( squares[ anchor ].x, squares[ anchor ].y );
+		if( runWeight < GetWeight( squares[ i ].x, squares[ i ].y ) )
+			runWeight = GetWeight( squares[ i ].x, squares[ i ].y );
+	}
+
+	if( anchor != last - 1 )
+		m_solution.push_back( squares[ last - 1 ] );
+	m_solution.push_back( squares[ last ] );
+
+	GRID_STAT_SET( m_stats, waypointsRemoved, (unsigned int)( squares.size() - m_solution.size() ) );
+}
+
+//------------------------------------------------------------------------------
+// Name: HasLineOfSight()
+// Desc: Checks to see if a disc of radius clearance can move in a straight
+//		 line between two cell centres without overlapping a wall, the edge of
+//		 the grid or a cell heavier than maxWeight. Only the cells the line
+//		 passes through and their neighbours within the clearance are tested
+//------------------------------------------------------------------------------
+bool Grid::HasLineOfSight( const int fromX, const int fromY, const int toX, const int toY,
+						   const float clearance, const int maxWeight ) const
+{
+	//a blocking cell can only touch the disc if it lies within this many
+	// cells of one the line passes through
+	const int reach = int( clearance ) + 1;
+	const float extent = 0.5f + clearance - g_lineOfSightSlack;
 
-		int tc = (*iter)->totalCost;
-		while( iter != openList.end() )
+	const int stepX = ( toX > fromX ) ? 1 : -1;
+	const int stepY = ( toY > fromY ) ? 1 : -1;
+	const int spanX = abs( toX - fromX );
+	const int spanY = abs( toY - fromY );
+
+	//walk every cell the line passes through, taking both cells when it
+	// crosses exactly through a corner
+	int x = fromX;
+	int y = fromY;
+	int error = spanX - spanY;
+	for( int remaining = spanX + spanY; ; --remaining )
+	{
+		for( int ny = y - reach; ny <= y + reach; ++ny )
 		{
-			if( (*iter)->totalCost < tc )
+			for( int nx = x - reach; nx <= x + reach; ++nx )
 			{
-				currentNode = iter;
-				tc = (*iter)->totalCost;
+				if( IsPath( nx, ny ) && GetWeight( nx, ny ) <= maxWeight )
+					continue;
+
+				if( SegmentCrossesBox( float( fromX ), float( fromY ), float( toX ), float( toY ),
+									   float( nx ) - extent, float( ny ) - extent,
+									   float( nx ) + extent, float( ny ) + extent ) )
+					return false;
 			}
-			++iter;
 		}
-		pNode = *currentNode;
 
-		//if the current node is the same as the goal, we have finished
-		if( (*currentNode)->x == ( GRID_SIZE - 1 ) &&
-			(*currentNode)->y == m_goalY )
-		{
-			m_solved = true;
+		if( remaining <= 0 )
 			break;
+
+		if( error > 0 )
+		{
+			x += stepX;
+			error -= 2 * spanY;
+		}
+		else if( error < 0 )
+		{
+			y += stepY;
+			error += 2 * spanX;
+		}
+		else
+		{
+			//through the corner - the cells either side are covered by the
+			// neighbourhood test, so step diagonally
+			x += stepX;
+			y += stepY;
+			error += 2 * ( spanX - spanY );
+			--remaining;
 		}
+	}
+
+	return true;
+}
+
+//------------------------------------------------------------------------------
+// Name: SumSolutionCost()
+// Desc: Sums the weights of the squares stepped onto along the solution. Only
+//		 meaningful before smoothing, while every step is still in the path
+//------------------------------------------------------------------------------
+int Grid::SumSolutionCost() const
+{
+	int cost = 0;
+	bool first = true;
+
+	SquareVector::const_iterator iter;
+	for( iter = m_solution.begin(); iter != m_solution.end(); ++iter )
+	{
+		//skip the squares outside the entrance and exit
+		if( iter->x < 0 || iter->x >= m_width || iter->y < 0 || iter->y >= m_height )
+			continue;
+
+		if( ! first )
+			cost += GetWeight( iter->x, iter->y );
+		first = false;
+	}
+
+	return cost;
+}
 
-		//move the node to the closed list
-		openList.erase( currentNode );
-		closedList.push_back( pNode );
+//------------------------------------------------------------------------------
+// Name: SolveAStar()
+// Desc: Finds the cheapest path through the maze with an A* search. Step costs
+//		 are small integers, so the open list is a bucket queue
+//------------------------------------------------------------------------------
+void Grid::SolveAStar()
+{
+	GRID_STAT_TIMER( timer );
+
+	const int numCells = GetNumCells();
+	const int startCell = GetCellIndex( 0, m_startY );
+	const int numExits = int( m_exits.size() );
+
+	PrepareHeuristic();
+	GRID_STAT_LAP( m_stats, GridStats::PHASE_SOLVE_PREPARE, timer );
+
+	//a step raises the estimated total by at most its weight plus the change
+	// in the heuristic, which for landmarks can itself be up to MAX_WEIGHT
+	m_openQueue.Resize( numCells, 2 * MAX_WEIGHT + 1 );
+	m_searchCost.resize( numCells );
+	m_searchParent.resize( numCells );
+
+	if( HEURISTIC_ALT == m_heuristic )
+	{
+		const LandmarkHeuristic heuristic( *this, m_landmarks, &m_exits[ 0 ], numExits );
+		m_chosenExit = MazeFindPath( *this, startCell, &m_exitCells[ 0 ], numExits, heuristic,
+									 m_openQueue, &m_searchCost[ 0 ], &m_searchParent[ 0 ], m_stats );
+	}
+	else
+	{
+		const ManhattanHeuristic heuristic( &m_exits[ 0 ], numExits );
+		m_chosenExit = MazeFindPath( *this, startCell, &m_exitCells[ 0 ], numExits, heuristic,
+									 m_openQueue, &m_searchCost[ 0 ], &m_searchParent[ 0 ], m_stats );
+	}
+	GRID_STAT_LAP( m_stats, GridStats::PHASE_SOLVE_SEARCH, timer );
+
+	if( m_chosenExit < 0 )
+	{
+		//something has gone horribly horribly wrong
+		return;
+	}
+	m_solved = true;
+
+	//store the solution, walking back from the goal and then turning it round
+	const int goalCell = m_exitCells[ m_chosenExit ];
+	m_solution.push_back( GetExitOutside( m_chosenExit ) );
+	for( int cell = goalCell; cell >= 0; cell = m_searchParent[ cell ] )
+		m_solution.push_back( MazeSquare( GetCellX( cell ), GetCellY( cell ) ) );
+	GRID_STAT_SET( m_stats, solutionLength, (unsigned int)( m_solution.size() - 1 ) );
+	GRID_STAT_SET( m_stats, solutionCost, (unsigned int)( m_searchCost[ goalCell ] ) );
+	m_solution.push_back( MazeSquare( -1, m_startY ) );
+	reverse( m_solution.begin(), m_solution.end() );
+
+	GRID_STAT_LAP( m_stats, GridStats::PHASE_SOLVE_PATH, timer );
+}
 
-		//for all valid neighbouring nodes...
-		for( int i = 0; i < 4; ++i )
+//------------------------------------------------------------------------------
+// Name: SolveMemoryBounded()
+// Desc: Finds the cheapest path with IDA*, which keeps only the current route
+//		 and a fixed-size transposition table rather than state for every
+//		 cell. Half the memory budget goes to each. A small table only costs
+//		 repeated work, but if the route outgrows its half the search gives up
+//		 rather than hunt blindly for a shorter one, and budgetExceeded in the
+//		 stats says so
+//------------------------------------------------------------------------------
+void Grid::SolveMemoryBounded()
+{
+	GRID_STAT_TIMER( timer );
+
+	const int startCell = GetCellIndex( 0, m_startY );
+
+	PrepareHeuristic();
+	GRID_STAT_LAP( m_stats, GridStats::PHASE_SOLVE_PREPARE, timer );
+
+	m_transpositions.Resize( m_memoryBudget / 2 );
+	size_t maxDepth = ( m_memoryBudget / 2 ) / sizeof( SearchFrame );
+	if( maxDepth < 1 )
+		maxDepth = 1;
+	TrackedVector< SearchFrame, MemoryTracker::SUBSYSTEM_SOLVER >::Type route;
+
+	//the landmark tables are shared with A* but count against the budget too
+	size_t fixedBytes = m_transpositions.GetNumBytes();
+	if( HEURISTIC_ALT == m_heuristic )
+		fixedBytes += m_landmarks.GetNumBytes();
+	size_t peakBytes = fixedBytes;
+
+	bool exceeded = false;
+	int bound = SearchHeuristic( 0, m_startY );
+	while( ! m_solved && ! exceeded )
+	{
+		GRID_STAT_INC( m_stats, searchIterations );
+		m_transpositions.NextIteration();
+		int nextBound = -1;
+
+		SearchFrame start;
+		start.cell = startCell;
+		start.cost = 0;
+		start.direction = 0;
+		route.push_back( start );
+		m_transpositions.Store( startCell, 0 );
+
+		while( ! route.empty() )
 		{
-			int x = pNode->x;
-			int y = pNode->y;
-			Direction d = Direction( i );
-            MoveInDirection( x, y, d );
+			const size_t top = route.size() - 1;
+			const int cell = route[ top ].cell;
 
-			if( IsPath( x, y ) )
+			m_chosenExit = FindExit( cell );
+			if( m_chosenExit >= 0 )
 			{
-                //look through the open and closed lists to see if this point already exists
-				// in a more efficient form, replacing less efficient ones
-				bool skipThisNode = false;
+				m_solved = true;
+				break;
+			}
 
-				//open
-				iter = openList.begin();
-				while( iter != openList.end() )
-				{
-					if( (*iter)->x == x && (*iter)->y == y )
-					{
-						if( (*iter)->nodeCost <= ( (*currentNode)->nodeCost + 1 ) )
-						{
-                            //old node is better so skip this one
-							skipThisNode = true;
-						}
-						break;
-					}
-
-					++iter;
-				}
-				if( skipThisNode )
-					continue;
+			if( 4 == route[ top ].direction )
+			{
+				route.pop_back();
+				continue;
+			}
 
-				//closed
-				iter = closedList.begin();
-				while( iter != closedList.end() )
-				{
-					if( (*iter)->x == x && (*iter)->y == y )
-					{
-						if( (*iter)->nodeCost <= ( pNode->nodeCost + 1 ) )
-						{
-							//old node is better so skip this one
-							skipThisNode = true;
-						}
-						else
-						{
-							//newer node is better, remove this one from the closed list and
-							// resubmit it for checking
-							StateNode* pTemp = *iter;
-							closedList.erase( iter );
-							openList.push_back( pTemp );
-						}
-						break;
-					}
-					++iter;
-				}
-				if( skipThisNode )
-					continue;
+			if( 0 == route[ top ].direction )
+				GRID_STAT_INC( m_stats, nodesExpanded );
 
-				//now we have a new node to add to the open list
-				if( states[ y ][ x ] == NULL )
-				{
-					states[ y ][ x ] = new StateNode( pNode, x, y,
-													  pNode->nodeCost + 1,
-                                                      pNode->nodeCost + 1 + SearchHeuristic( x, y ) );
-					openList.push_back( states[ y ][ x ] );
-				}
-				else
-				{
-					//node already exists, but must be more inefficient so update it
-					states[ y ][ x ]->parent = pNode;
-					states[ y ][ x ]->nodeCost = pNode->nodeCost + 1;
-					states[ y ][ x ]->totalCost = pNode->nodeCost + 1 + SearchHeuristic( x, y );
-					states[ y ][ x ]->x = x;
-					states[ y ][ x ]->y = y;                    				
-				}
+			int x = GetCellX( cell );
+			int y = GetCellY( cell );
+			MoveInDirection( x, y, Direction( route[ top ].direction++ ) );
+			if( ! IsPath( x, y ) )
+				continue;
+
+			//don't step straight back
+			const int next = GetCellIndex( x, y );
+			if( top > 0 && route[ top - 1 ].cell == next )
+				continue;
+
+			const int cost = route[ top ].cost + GetWeight( x, y );
+			const int estimate = cost + SearchHeuristic( x, y );
+			if( estimate > bound )
+			{
+				if( nextBound < 0 || estimate < nextBound )
+					nextBound = estimate;
+				continue;
 			}
+
+			if( m_transpositions.IsDominated( next, cost ) )
+				continue;
+			m_transpositions.Store( next, cost );
+
+			if( route.size() >= maxDepth )
+			{
+				GRID_STAT_SET( m_stats, budgetExceeded, 1 );
+				exceeded = true;
+				break;
+			}
+
+			//grow the route by hand so it never holds more than maxDepth
+			if( route.size() == route.capacity() )
+			{
+				const size_t capacity = route.capacity() * 2 + 16;
+				route.reserve( ( capacity < maxDepth ) ? capacity : maxDepth );
+
+				const size_t bytes = fixedBytes + route.capacity() * sizeof( SearchFrame );
+				if( bytes > peakBytes )
+					peakBytes = bytes;
+			}
+
+			SearchFrame frame;
+			frame.cell = next;
+			frame.cost = cost;
+			frame.direction = 0;
+			route.push_back( frame );
 		}
+
+		//nothing was left beyond the bound, so there is no path
+		if( m_solved || exceeded || nextBound < 0 )
+			break;
+
+		bound = nextBound;
 	}
 
+	GRID_STAT_SET( m_stats, peakBytes, (unsigned int)( peakBytes ) );
+	GRID_STAT_LAP( m_stats, GridStats::PHASE_SOLVE_SEARCH, timer );
+
 	if( ! m_solved )
-	{
-		//something has gone horribly horribly wrong
 		return;
-	}
 
 	//store the solution
-	m_solution.push_front( MazeSquare( GRID_SIZE, m_goalY ) );
-	while( pNode != NULL )
-	{
-		m_solution.push_front( MazeSquare( pNode->x, pNode->y ) );       		
-		pNode = pNode->parent;
-	}
-	m_solution.push_front( MazeSquare( -1, m_startY ) );
+	m_solution.push_back( MazeSquare( -1, m_startY ) );
+	for( size_t i = 0; i < route.size(); ++i )
+		m_solution.push_back( MazeSquare( GetCellX( route[ i ].cell ), GetCellY( route[ i ].cell ) ) );
+	m_solution.push_back( GetExitOutside( m_chosenExit ) );
+	GRID_STAT_SET( m_stats, solutionLength, (unsigned int)( route.size() ) );
+	GRID_STAT_SET( m_stats, solutionCost, (unsigned int)( route.back().cost ) );
+
+	GRID_STAT_LAP( m_stats, GridStats::PHASE_SOLVE_PATH, timer );
+}
+
+//------------------------------------------------------------------------------
+// Name: SolveParallel()
+// Desc: Finds the cheapest path with A* spread over several threads. Worth it
+//		 only for very large grids, where the search dwarfs starting threads
+//------------------------------------------------------------------------------
+void Grid::SolveParallel()
+{
+	GRID_STAT_TIMER( timer );
+
+	PrepareHeuristic();
+	GRID_STAT_LAP( m_stats, GridStats::PHASE_SOLVE_PREPARE, timer );
+
+	ParallelSearch::SolverInts cells;
+	const Landmarks* pLandmarks = ( HEURISTIC_ALT == m_heuristic ) ? &m_landmarks : NULL;
+	const bool found = m_parallelSearch.FindPath( *this, GetCellIndex( 0, m_startY ), &m_exitCells[ 0 ],
+												  int( m_exitCells.size() ), m_numThreads, pLandmarks,
+												  cells, m_chosenExit, m_stats );
+	GRID_STAT_LAP( m_stats, GridStats::PHASE_SOLVE_SEARCH, timer );
+
+	if( ! found )
+		return;
+
+	//store the solution
+	m_solution.push_back( MazeSquare( -1, m_startY ) );
+	for( size_t i = 0; i < cells.size(); ++i )
+		m_solution.push_back( MazeSquare( GetCellX( cells[ i ] ), GetCellY( cells[ i ] ) ) );
+	m_solution.push_back( GetExitOutside( m_chosenExit ) );
+	GRID_STAT_SET( m_stats, solutionLength, (unsigned int)( cells.size() ) );
+	GRID_STAT_SET( m_stats, solutionCost, (unsigned int)( SumSolutionCost() ) );
 
-	//clear the nodes from memory
-	for( int j = 0; j < GRID_SIZE; ++j )
+	m_solved = true;
+
+	GRID_STAT_LAP( m_stats, GridStats::PHASE_SOLVE_PATH, timer );
+}
+
+//------------------------------------------------------------------------------
+// Name: PrepareHeuristic()
+// Desc: Brings any tables the selected heuristic needs up to date for the exits
+//------------------------------------------------------------------------------
+void Grid::PrepareHeuristic()
+{
+	if( HEURISTIC_ALT == m_heuristic )
 	{
-		for( int i = 0; i < GRID_SIZE; ++i )
-		{
-            pNode = states[ j ][ i ];
-			delete pNode;
-			states[ j ][ i ] = NULL;
-		}
+		m_landmarks.Update( *this, CONST_NUM_LANDMARKS );
+		m_landmarks.SetGoals( *this, &m_exitCells[ 0 ], int( m_exitCells.size() ) );
 	}
-	openList.clear();
-	closedList.clear();
+}
 
+//------------------------------------------------------------------------------
+// Name: SolveHierarchical()
+// Desc: Finds the path through the maze over the cached cluster abstraction.
+//		 Only clusters changed since the last solve are rebuilt
+//------------------------------------------------------------------------------
+void Grid::SolveHierarchical()
+{
+	GRID_STAT_TIMER( timer );
+
+	m_hierarchy.Refresh( *this );
+	GRID_STAT_LAP( m_stats, GridStats::PHASE_SOLVE_PREPARE, timer );
+
+	HierarchicalSearch::SolverInts cells;
+	const bool found = m_hierarchy.FindPath( *this, GetCellIndex( 0, m_startY ), &m_exitCells[ 0 ],
+											 int( m_exitCells.size() ), cells, m_chosenExit, m_stats );
+	GRID_STAT_LAP( m_stats, GridStats::PHASE_SOLVE_SEARCH, timer );
+
+	if( ! found )
+		return;
+
+	//store the solution
+	m_solution.push_back( MazeSquare( -1, m_startY ) );
+	for( size_t i = 0; i < cells.size(); ++i )
+		m_solution.push_back( MazeSquare( GetCellX( cells[ i ] ), GetCellY( cells[ i ] ) ) );
+	m_solution.push_back( GetExitOutside( m_chosenExit ) );
+	GRID_STAT_SET( m_stats, solutionLength, (unsigned int)( cells.size() ) );
+	GRID_STAT_SET( m_stats, solutionCost, (unsigned int)( SumSolutionCost() ) );
+
+	m_solved = true;
+
+	GRID_STAT_LAP( m_stats, GridStats::PHASE_SOLVE_PATH, timer );
 }
 
 //------------------------------------------------------------------------------
 // Name: IsPath()
 // Desc: Checks to see if a path exists at a given point on the grid
 //------------------------------------------------------------------------------
-bool Grid::IsPath( const int x, const int y )
+bool Grid::IsPath( const int x, const int y ) const
 {
 	//check if we're out of bounds
-	if( x < 0 || x >= GRID_SIZE ||
-		y < 0 || y >= GRID_SIZE )
+	if( x < 0 || x >= m_width ||
+		y < 0 || y >= m_height )
 		return false;
 
 	//check to see if the space is a wall
@@ -458,11 +1083,19 @@ bool Grid::IsPath( const int x, const int y )
 
 //------------------------------------------------------------------------------
 // Name: SearchHeuristic()
-// Desc: Heuristic function for the A* algorithm
+// Desc: Heuristic function for the A* algorithm. Every step costs at least
+//		 MIN_WEIGHT, so this never overestimates and the path stays the cheapest.
+//		 The landmark bound is also a lower bound, so the larger of the two is
 //------------------------------------------------------------------------------
 int Grid::SearchHeuristic( const int x, const int y )
 {
-	return abs( ( GRID_SIZE - 1 ) - x ) + abs( m_goalY - y );
+	GRID_STAT_INC( m_stats, heuristicCalls );
+	const int manhattan = ManhattanHeuristic( &m_exits[ 0 ], int( m_exits.size() ) )( x, y );
+	if( HEURISTIC_ALT != m_heuristic )
+		return manhattan;
+
+	const int landmark = m_landmarks.Estimate( *this, GetCellIndex( x, y ) );
+	return ( landmark > manhattan ) ? landmark : manhattan;
 }
 
 //------------------------------------------------------------------------------
@@ -476,13 +1109,11 @@ bool Grid::PopNextSolution( MazeSquare& square )
 		return false;
 
 	//make sure we have some points remaining in the path
-	if( m_solution.size() == 0 )
+	if( m_solutionNext >= m_solution.size() )
 		return false;
 
 	//return the next point in the path
-	list< MazeSquare >::iterator iter = m_solution.begin();
-	square = (*iter);
-	m_solution.pop_front();
+	square = m_solution[ m_solutionNext++ ];
 
 	return true;
 }
\ No newline at end of file
@@ -15,10 +15,19 @@
 //------------------------------------------------------------------------------
 // Included files:
 //------------------------------------------------------------------------------
+#include "BucketQueue.h"
 #include "Constants.h"
+#include "DirtyChunks.h"
+#include "GridStats.h"
+#include "HierarchicalSearch.h"
+#include "Landmarks.h"
+#include "MemoryTracker.h"
+#include "ParallelSearch.h"
+#include "Random.h"
+#include "TranspositionTable.h"
+#include "Types.h"
 
 #include <vector>
-#include <list>
 #include <string>
 using namespace std;
 
@@ -26,6 +35,8 @@ using namespace std;
 //------------------------------------------------------------------------------
 // Prototypes and declarations:
 //------------------------------------------------------------------------------
+class MazeTrace;
+class SolutionCache;
 
 
 //------------------------------------------------------------------------------
@@ -40,29 +51,8 @@ struct MazeSquare
 	int x, y;
 };
 
-//------------------------------------------------------------------------------
-// Name: struct StateNode
-// Desc: Single node in the A* algorithm
-//------------------------------------------------------------------------------
-struct StateNode
-{
-	StateNode() : parent( NULL ), nodeCost( 0 ), x( 0 ), y( 0 ), totalCost( 0 ) {}
-	StateNode( StateNode* newParent, const int newX, const int newY,
-			   const int newNodeCost, const int newTotalCost )
-	{
-		parent = newParent;
-		x = newX;
-		y = newY;
-		nodeCost = newNodeCost;
-		totalCost = newTotalCost;
-	}
-		
-	StateNode* parent;
-	int nodeCost;
-	int totalCost;
-	int x;
-	int y;
-};
+//a route through the maze, counted as solution memory
+typedef TrackedVector< MazeSquare, MemoryTracker::SUBSYSTEM_SOLUTION >::Type SquareVector;
 
 //------------------------------------------------------------------------------
 // Name: class Grid
@@ -72,41 +62,208 @@ class Grid
 {
 
 public:
-	Grid();
+	//order the cells are stored in - the blocked layouts keep vertical
+	// neighbours close together in memory, which helps on very wide grids
+	enum Layout { LAYOUT_ROW_MAJOR, LAYOUT_BLOCKED, LAYOUT_MORTON };
 
-	const static enum GridTile { TILE_PATH, TILE_WALL, TILE_START, TILE_GOAL };
-	const static enum Direction { DIR_UP, DIR_RIGHT, DIR_DOWN, DIR_LEFT };
-	const static int GRID_SIZE = CONST_GRID_SIZE;
+	Grid( const int width = CONST_GRID_SIZE, const int height = CONST_GRID_SIZE,
+		  const Layout layout = LAYOUT_ROW_MAJOR );
+
+	enum GridTile { TILE_PATH, TILE_WALL, TILE_START, TILE_GOAL };
+	enum Direction { DIR_UP, DIR_RIGHT, DIR_DOWN, DIR_LEFT };
+	enum Solver { SOLVER_ASTAR, SOLVER_HIERARCHICAL, SOLVER_MEMORY_BOUNDED, SOLVER_PARALLEL };
+	enum Heuristic { HEURISTIC_MANHATTAN, HEURISTIC_ALT };
+	const static int GRID_SIZE = CONST_GRID_SIZE;	//default width and height
+	const static int MIN_WEIGHT = 1;				//cost of stepping onto open ground
+	const static int MAX_WEIGHT = 15;
+
+	int GetWidth() const { return m_width; }
+	int GetHeight() const { return m_height; }
+	Layout GetLayout() const { return m_layout; }
+
+	//cells are also addressed by a single index, for per-cell arrays. The
+	// blocked layouts pad the grid out to whole blocks, so some indices lie
+	// off the grid - IsPath() is false for them
+	int GetNumCells() const { return int( m_tiles.size() ); }
+	int GetCellIndex( const int x, const int y ) const { return m_offsetX[ x ] + m_offsetY[ y ]; }
+	int GetCellX( const int index ) const
+	{
+		if( 0 == m_blockShift )
+			return index % m_width;
+		return ( ( ( index >> ( m_blockShift * 2 ) ) % m_blocksX ) << m_blockShift ) +
+			   m_localX[ index & m_blockMask ];
+	}
+	int GetCellY( const int index ) const
+	{
+		if( 0 == m_blockShift )
+			return index / m_width;
+		return ( ( ( index >> ( m_blockShift * 2 ) ) / m_blocksX ) << m_blockShift ) +
+			   m_localY[ index & m_blockMask ];
+	}
 
-	GridTile GetTile( const int x, const int y ) const { return m_tiles[ y ][ x ]; }
-	void SetTile( const int x, const int y, const GridTile value )
+	GridTile GetTile( const int x, const int y ) const
 	{
-		m_tiles[ y ][ x ] = value;
+		return GridTile( m_tiles[ GetCellIndex( x, y ) ] );
 	}
+	void SetTile( const int x, const int y, const GridTile value );
+
+	int GetWeight( const int x, const int y ) const { return m_weights[ GetCellIndex( x, y ) ]; }
+	void SetWeight( const int x, const int y, const int weight );
+
+	bool IsPath( const int x, const int y ) const;
+
+	//hash of the size, tiles and weights, kept up to date as they change
+	uint64 GetHash() const { return m_hash; }
+	uint64 ComputeHash() const;
+
+	DirtyChunks& GetDirtyChunks() { return m_dirtyChunks; }
 
-	int GetStartY() { return m_startY; }
-	int GetGoalY() { return m_goalY; }
+	int GetStartY() const { return m_startY; }
+	int GetGoalY() const { return m_goalY; }
+
+	//exits are open cells on the border - the first is always the one the
+	// generator reaches first in the right hand column, and any others are
+	// chosen at random from the rest of the border
+	void SetNumExits( const int numExits ) { m_numExits = ( numExits > 1 ) ? numExits : 1; }
+	int GetNumExits() const { return int( m_exits.size() ); }
+	MazeSquare GetExit( const int index ) const { return m_exits[ index ]; }
+	MazeSquare GetExitOutside( const int index ) const;
+
+	//the exit the last solution leads to, or -1 if there isn't one
+	int GetChosenExit() const { return m_chosenExit; }
+
+	//fraction of dead ends opened up into loops after generation
+	void SetBraidFactor( const float factor );
+	float GetBraidFactor() const { return m_braidFactor; }
 
 	void GenerateMaze();
+	void GenerateMaze( const unsigned int seed );
+
+	//record each GenerateMaze's decisions into a trace, or NULL to stop
+	void SetTrace( MazeTrace* pTrace ) { m_pTrace = pTrace; }
+	MazeTrace* GetTrace() const { return m_pTrace; }
+
+	void SetSolver( const Solver solver ) { m_solver = solver; }
+	Solver GetSolver() const { return m_solver; }
+	void SetHeuristic( const Heuristic heuristic ) { m_heuristic = heuristic; }
+	Heuristic GetHeuristic() const { return m_heuristic; }
+
+	//bytes of search state SOLVER_MEMORY_BOUNDED may use
+	void SetMemoryBudget( const size_t bytes ) { m_memoryBudget = bytes; }
+	size_t GetMemoryBudget() const { return m_memoryBudget; }
+
+	//worker threads SOLVER_PARALLEL may use, the calling thread included
+	void SetNumThreads( const int numThreads ) { m_numThreads = numThreads; }
+	int GetNumThreads() const { return m_numThreads; }
+
+	void SetSolutionCache( SolutionCache* pCache ) { m_pSolutionCache = pCache; }
+
+	//replace the solution's single steps with straight runs a player of
+	// CONST_PLAYER_SIZE radius can walk
+	void SetPathSmoothing( const bool smoothing ) { m_pathSmoothing = smoothing; }
+	bool GetPathSmoothing() const { return m_pathSmoothing; }
+	bool HasLineOfSight( const int fromX, const int fromY, const int toX, const int toY,
+						 const float clearance, const int maxWeight = MAX_WEIGHT ) const;
+
 	void GenerateSolution();
 
 	bool PopNextSolution( MazeSquare& square );
 
+	//the whole solution, however much of it has been popped
+	const SquareVector& GetSolution() const { return m_solution; }
+	//total weight of the squares stepped onto, from before any smoothing
+	int GetSolutionCost() const { return m_solutionCost; }
+
+	const GridStats& GetStats() const { return m_stats; }
+
 private:
-	GridTile m_tiles[ GRID_SIZE ][ GRID_SIZE ];
+	typedef TrackedVector< int, MemoryTracker::SUBSYSTEM_TILES >::Type TileInts;
+	typedef TrackedVector< unsigned char, MemoryTracker::SUBSYSTEM_TILES >::Type TileBytes;
+	typedef TrackedVector< MazeSquare, MemoryTracker::SUBSYSTEM_TILES >::Type TileSquares;
+	typedef TrackedVector< int, MemoryTracker::SUBSYSTEM_SOLVER >::Type SolverInts;
+
+	int m_width;
+	int m_height;
+
+	//cell index lookups for the layout - the index of ( x, y ) is
+	// m_offsetX[ x ] + m_offsetY[ y ], and inside a block the local x and y
+	// of each index come from m_localX and m_localY
+	Layout m_layout;
+	int m_blockShift;
+	int m_blockMask;
+	int m_blocksX;
+	TileInts m_offsetX;
+	TileInts m_offsetY;
+	TileBytes m_localX;
+	TileBytes m_localY;
+
+	TileBytes m_tiles;
+	TileBytes m_weights;
+	uint64 m_hash;
+
+	Random m_random;
+	float m_braidFactor;
+	MazeTrace* m_pTrace;
 
 	int m_startY;
 	int m_goalY;
 
-	list< MazeSquare > m_solution;
+	int m_numExits;
+	TileSquares m_exits;
+	TileInts m_exitCells;
+	int m_chosenExit;
+
+	SquareVector m_solution;
+	size_t m_solutionNext;				//next square PopNextSolution returns
+	int m_solutionCost;
+	SquareVector m_unsmoothed;			//smoothing workspace
+
+	DirtyChunks m_dirtyChunks;
+
+	GridStats m_stats;
 
 	bool m_solved;
 
-	bool IsPath( const int x, const int y );
-	bool CanPlacePath( const int x, const int y );
+	Solver m_solver;
+	Heuristic m_heuristic;
+	HierarchicalSearch m_hierarchy;
+	Landmarks m_landmarks;
+	SolutionCache* m_pSolutionCache;
+	bool m_pathSmoothing;
+
+	//A* workspace, kept between solves to save reallocating it
+	BucketQueue m_openQueue;
+	SolverInts m_searchCost;
+	SolverInts m_searchParent;
+
+	size_t m_memoryBudget;
+	TranspositionTable m_transpositions;
+
+	int m_numThreads;
+	ParallelSearch m_parallelSearch;
+
+	void SetupLayout( const Layout layout );
+
+	void ResetMaze();
+	void AddExits();
+	void BraidMaze();
+	bool CanOpenWall( const int x, const int y ) const;
+	int CountOpenNeighbours( const int x, const int y ) const;
 	void MoveInDirection( int& x, int& y, const Direction d );
 	int SearchHeuristic( const int x, const int y );
 
+	void SolveAStar();
+	void SolveHierarchical();
+	void SolveMemoryBounded();
+	void SolveParallel();
+	void PrepareHeuristic();
+	int FindExit( const int cell ) const;
+	void SmoothSolution();
+	int SumSolutionCost() const;
+
+	//rebuilds mazes from traces
+	friend class MazeReplayer;
+
 };
 
 
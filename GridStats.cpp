@@ -0,0 +1,142 @@
+//------------------------------------------------------------------------------
+// File: GridStats.cpp
+// Desc: Counters and phase timers for the maze generator and solver
+//
+// Created: 19 October 2026 15:07:44
+//
+// (c)2002 Neil Wakefield
+//------------------------------------------------------------------------------
+
+
+//------------------------------------------------------------------------------
+// Included files:
+//------------------------------------------------------------------------------
+#include "GridStats.h"
+
+#include <stdio.h>
+
+
+//------------------------------------------------------------------------------
+// Globals:
+//------------------------------------------------------------------------------
+namespace
+{
+	const char* g_phaseNames[ GridStats::NUM_PHASES ] =
+	{
+		"generate_fill",
+		"generate_grow",
+		"generate_braid",
+		"solve_prepare",
+		"solve_search",
+		"solve_path",
+	};
+}
+
+
+//------------------------------------------------------------------------------
+// Definitions:
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Name: Reset()
+// Desc: Zeroes every counter and timer
+//------------------------------------------------------------------------------
+void GridStats::Reset()
+{
+	ResetGenerator();
+	ResetSolver();
+}
+
+//------------------------------------------------------------------------------
+// Name: ResetGenerator()
+// Desc: Zeroes the generator counters and timers
+//------------------------------------------------------------------------------
+void GridStats::ResetGenerator()
+{
+	randomDraws			= 0;
+	placementsRejected	= 0;
+	frontierErasures	= 0;
+	deadEndsRemoved		= 0;
+
+	phaseSeconds[ PHASE_GENERATE_FILL ] = 0.0;
+	phaseSeconds[ PHASE_GENERATE_GROW ] = 0.0;
+	phaseSeconds[ PHASE_GENERATE_BRAID ] = 0.0;
+}
+
+//------------------------------------------------------------------------------
+// Name: ResetSolver()
+// Desc: Zeroes the solver counters and timers
+//------------------------------------------------------------------------------
+void GridStats::ResetSolver()
+{
+	nodesExpanded	= 0;
+	nodesReopened	= 0;
+	peakOpenList	= 0;
+	heuristicCalls	= 0;
+	solutionLength	= 0;
+	solutionCost	= 0;
+	searchIterations = 0;
+	budgetExceeded	= 0;
+	peakBytes		= 0;
+	threadsUsed		= 0;
+	messagesSent	= 0;
+	waypointsRemoved = 0;
+
+	phaseSeconds[ PHASE_SOLVE_PREPARE ]	= 0.0;
+	phaseSeconds[ PHASE_SOLVE_SEARCH ]	= 0.0;
+	phaseSeconds[ PHASE_SOLVE_PATH ]	= 0.0;
+}
+
+//------------------------------------------------------------------------------
+// Name: GetPhaseName()
+// Desc: Returns the name used for a phase in the JSON output
+//------------------------------------------------------------------------------
+const char* GridStats::GetPhaseName( const Phase phase )
+{
+	return g_phaseNames[ phase ];
+}
+
+//------------------------------------------------------------------------------
+// Name: ToJSON()
+// Desc: Formats the statistics as a single JSON object
+//------------------------------------------------------------------------------
+string GridStats::ToJSON() const
+{
+	char buffer[ 256 ];
+	string json;
+
+#ifdef GRID_STATS_ENABLED
+	json = "{\"enabled\":true,";
+#else
+	json = "{\"enabled\":false,";
+#endif
+
+	sprintf( buffer, "\"generator\":{\"random_draws\":%u,\"placements_rejected\":%u,"
+					 "\"frontier_erasures\":%u,\"dead_ends_removed\":%u},",
+			 randomDraws, placementsRejected, frontierErasures, deadEndsRemoved );
+	json += buffer;
+
+	sprintf( buffer, "\"solver\":{\"nodes_expanded\":%u,\"nodes_reopened\":%u,"
+					 "\"peak_open_list\":%u,\"heuristic_calls\":%u,\"solution_length\":%u,"
+					 "\"solution_cost\":%u,",
+			 nodesExpanded, nodesReopened, peakOpenList, heuristicCalls, solutionLength,
+			 solutionCost );
+	json += buffer;
+
+	sprintf( buffer, "\"search_iterations\":%u,\"budget_exceeded\":%u,\"peak_bytes\":%u,"
+					 "\"threads_used\":%u,\"messages_sent\":%u,\"waypoints_removed\":%u},",
+			 searchIterations, budgetExceeded, peakBytes, threadsUsed, messagesSent,
+			 waypointsRemoved );
+	json += buffer;
+
+	json += "\"phase_seconds\":{";
+	for( int i = 0; i < NUM_PHASES; ++i )
+	{
+		sprintf( buffer, "%s\"%s\":%.9f", ( i > 0 ) ? "," : "",
+				 g_phaseNames[ i ], phaseSeconds[ i ] );
+		json += buffer;
+	}
+	json += "}}";
+
+	return json;
+}
@@ -0,0 +1,104 @@
+//------------------------------------------------------------------------------
+// File: GridStats.h
+// Desc: Counters and phase timers for the maze generator and solver
+//
+// Created: 19 October 2026 14:58:31
+//
+// (c)2002 Neil Wakefield
+//------------------------------------------------------------------------------
+
+
+#ifndef INCLUSIONGUARD_GRIDSTATS_H
+#define INCLUSIONGUARD_GRIDSTATS_H
+
+
+//------------------------------------------------------------------------------
+// Included files:
+//------------------------------------------------------------------------------
+#include "Timer.h"
+
+#include <string>
+using namespace std;
+
+
+//------------------------------------------------------------------------------
+// Macros:
+//------------------------------------------------------------------------------
+//define GRID_STATS_DISABLED to compile all of the instrumentation out
+#ifndef GRID_STATS_DISABLED
+#define GRID_STATS_ENABLED
+#endif
+
+#ifdef GRID_STATS_ENABLED
+#define GRID_STAT_INC( stats, counter )			++( stats ).counter
+#define GRID_STAT_ADD( stats, counter, n )		( stats ).counter += ( n )
+#define GRID_STAT_SET( stats, counter, n )		( stats ).counter = ( n )
+#define GRID_STAT_MAX( stats, counter, n )		do { if( ( n ) > ( stats ).counter ) ( stats ).counter = ( n ); } while( 0 )
+#define GRID_STAT_TIMER( timer )				Timer timer
+#define GRID_STAT_LAP( stats, phase, timer )	( stats ).phaseSeconds[ phase ] += ( timer ).Lap()
+#else
+#define GRID_STAT_INC( stats, counter )			((void)0)
+#define GRID_STAT_ADD( stats, counter, n )		((void)0)
+#define GRID_STAT_SET( stats, counter, n )		((void)0)
+#define GRID_STAT_MAX( stats, counter, n )		((void)0)
+#define GRID_STAT_TIMER( timer )				((void)0)
+#define GRID_STAT_LAP( stats, phase, timer )	((void)0)
+#endif
+
+
+//------------------------------------------------------------------------------
+// Prototypes and declarations:
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Name: struct GridStats
+// Desc: Statistics from the last maze generation and the last solve
+//------------------------------------------------------------------------------
+struct GridStats
+{
+	GridStats() { Reset(); }
+
+	enum Phase
+	{
+		PHASE_GENERATE_FILL,	//clearing the grid to walls
+		PHASE_GENERATE_GROW,	//growing the paths
+		PHASE_GENERATE_BRAID,	//opening dead ends into loops
+		PHASE_SOLVE_PREPARE,	//bringing cached search data up to date
+		PHASE_SOLVE_SEARCH,		//searching for the path
+		PHASE_SOLVE_PATH,		//storing the solution and freeing nodes
+		NUM_PHASES
+	};
+
+	void Reset();
+	void ResetGenerator();
+	void ResetSolver();
+
+	string ToJSON() const;
+
+	//generator
+	unsigned int randomDraws;			//random numbers drawn
+	unsigned int placementsRejected;	//squares refused by MazeCanPlacePath
+	unsigned int frontierErasures;		//squares removed from the growing list
+	unsigned int deadEndsRemoved;		//dead ends opened into loops
+
+	//solver
+	unsigned int nodesExpanded;			//nodes moved to the closed list
+	unsigned int nodesReopened;			//closed nodes put back on the open list
+	unsigned int peakOpenList;			//largest size of the open list
+	unsigned int heuristicCalls;		//distance estimates made
+	unsigned int solutionLength;		//squares in the solution, 0 if unsolved
+	unsigned int solutionCost;			//summed weights along the solution
+	unsigned int searchIterations;		//deepening passes by the memory-bounded solver
+	unsigned int budgetExceeded;		//1 if the memory-bounded solver ran out
+	unsigned int peakBytes;				//most search memory held at once
+	unsigned int threadsUsed;			//workers run by the parallel solver
+	unsigned int messagesSent;			//nodes passed between parallel workers
+	unsigned int waypointsRemoved;		//squares dropped by path smoothing
+
+	double phaseSeconds[ NUM_PHASES ];
+
+	static const char* GetPhaseName( const Phase phase );
+};
+
+
+#endif //INCLUSIONGUARD_GRIDSTATS_H
@@ -0,0 +1,509 @@
+//------------------------------------------------------------------------------
+// File: HierarchicalSearch.cpp
+// Desc: Hierarchical path-finding (HPA*) over clusters of the game grid
+//
+// Created: 19 October 2026 16:41:17
+//
+// (c)2002 Neil Wakefield
+//------------------------------------------------------------------------------
+
+
+//------------------------------------------------------------------------------
+// Included files:
+//------------------------------------------------------------------------------
+#include "HierarchicalSearch.h"
+#include "Grid.h"
+
+#include <stdlib.h>
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <queue>
+
+
+//------------------------------------------------------------------------------
+// Globals:
+//------------------------------------------------------------------------------
+namespace
+{
+	//ids of the temporary start and goal nodes in the abstract graph - goal i
+	// is g_goalNode - i
+	const int g_startNode = -1;
+	const int g_goalNode = -2;
+
+	//runs of open cells along a border at least this long get an entrance at
+	// both ends rather than one in the middle
+	const int g_longEntrance = 6;
+
+	//state of a node in the abstract search
+	struct AbstractNode
+	{
+		int cost;
+		int parent;
+		int cell;
+		bool closed;
+	};
+
+	typedef map< int, AbstractNode, less< int >,
+				 TrackedAllocator< pair< const int, AbstractNode >, MemoryTracker::SUBSYSTEM_SOLVER > > AbstractNodeMap;
+	typedef pair< int, int > OpenEntry;		//( estimated total cost, node )
+	typedef TrackedVector< OpenEntry, MemoryTracker::SUBSYSTEM_SOLVER >::Type OpenEntries;
+	typedef priority_queue< OpenEntry, OpenEntries, greater< OpenEntry > > OpenQueue;
+}
+
+
+//------------------------------------------------------------------------------
+// Definitions:
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Name: HierarchicalSearch()
+// Desc: Constructor for the hierarchical search
+//------------------------------------------------------------------------------
+HierarchicalSearch::HierarchicalSearch()
+{
+	m_width = 0;
+	m_height = 0;
+	m_numX = 0;
+
+	m_localCost.resize( CLUSTER_SIZE * CLUSTER_SIZE );
+	m_localParent.resize( CLUSTER_SIZE * CLUSTER_SIZE );
+	m_localQueue.Resize( CLUSTER_SIZE * CLUSTER_SIZE, Grid::MAX_WEIGHT );
+}
+
+//------------------------------------------------------------------------------
+// Name: Resize()
+// Desc: Lays the clusters out over a grid, all of them needing a build
+//------------------------------------------------------------------------------
+void HierarchicalSearch::Resize( const int width, const int height )
+{
+	m_width = width;
+	m_height = height;
+
+	m_dirtyClusters.Resize( width, height );
+	m_numX = m_dirtyClusters.GetNumX();
+
+	m_clusters.clear();
+	m_clusters.resize( m_numX * m_dirtyClusters.GetNumY() );
+
+	for( size_t i = 0; i < m_clusters.size(); ++i )
+	{
+		Cluster& cluster = m_clusters[ i ];
+		cluster.minX = int( i % m_numX ) * CLUSTER_SIZE;
+		cluster.minY = int( i / m_numX ) * CLUSTER_SIZE;
+		cluster.maxX = min( cluster.minX + CLUSTER_SIZE, width ) - 1;
+		cluster.maxY = min( cluster.minY + CLUSTER_SIZE, height ) - 1;
+	}
+}
+
+//------------------------------------------------------------------------------
+// Name: GetNumNodes()
+// Desc: Returns the number of entrances across every cluster
+//------------------------------------------------------------------------------
+int HierarchicalSearch::GetNumNodes() const
+{
+	int numNodes = 0;
+	for( size_t i = 0; i < m_clusters.size(); ++i )
+		numNodes += int( m_clusters[ i ].cells.size() );
+
+	return numNodes;
+}
+
+//------------------------------------------------------------------------------
+// Name: Refresh()
+// Desc: Rebuilds the clusters touched since the last refresh
+//------------------------------------------------------------------------------
+void HierarchicalSearch::Refresh( const Grid& grid )
+{
+	int cx, cy;
+	while( m_dirtyClusters.Pop( cx, cy ) )
+		BuildCluster( grid, cy * m_numX + cx );
+}
+
+//------------------------------------------------------------------------------
+// Name: BuildCluster()
+// Desc: Finds the entrances of a cluster and the distances between them. The
+//		 entrances along a border depend only on the tiles either side of it,
+//		 so both clusters sharing it find the same pairs without coordinating
+//------------------------------------------------------------------------------
+void HierarchicalSearch::BuildCluster( const Grid& grid, const int index )
+{
+	Cluster& cluster = m_clusters[ index ];
+	cluster.cells.clear();
+	cluster.partners.clear();
+
+	for( int side = 0; side < 4; ++side )
+		AddEntrances( grid, cluster, side );
+
+	const int numEntrances = int( cluster.cells.size() );
+	cluster.distances.assign( numEntrances * numEntrances, -1 );
+
+	for( int from = 0; from < numEntrances; ++from )
+	{
+		FloodCluster( grid, cluster, cluster.cells[ from ] );
+
+		for( int to = 0; to < numEntrances; ++to )
+			cluster.distances[ from * numEntrances + to ] =
+				GetFloodCost( grid, cluster, cluster.cells[ to ] );
+	}
+}
+
+//------------------------------------------------------------------------------
+// Name: AddEntrances()
+// Desc: Adds the entrances along one side of a cluster - up, right, down or
+//		 left. Each run of cells open on both sides of the border gets one
+//		 entrance in its middle, or one at each end if it is long
+//------------------------------------------------------------------------------
+void HierarchicalSearch::AddEntrances( const Grid& grid, Cluster& cluster, const int side )
+{
+	const bool horizontal = ( 0 == side || 2 == side );
+	const int length = horizontal ? cluster.maxX - cluster.minX + 1 : cluster.maxY - cluster.minY + 1;
+
+	int x = cluster.minX, y = cluster.minY;
+	int dx = 0, dy = 0;
+	switch( side )
+	{
+	case 0: dy = -1; break;
+	case 1: x = cluster.maxX; dx = 1; break;
+	case 2: y = cluster.maxY; dy = 1; break;
+	case 3: dx = -1; break;
+	}
+
+	int runStart = -1;
+	for( int i = 0; i <= length; ++i )
+	{
+		const int cellX = horizontal ? x + i : x;
+		const int cellY = horizontal ? y : y + i;
+		const bool open = ( i < length ) &&
+						  grid.IsPath( cellX, cellY ) &&
+						  grid.IsPath( cellX + dx, cellY + dy );
+
+		if( open && runStart < 0 )
+			runStart = i;
+
+		if( open || runStart < 0 )
+			continue;
+
+		//the run has ended - place its entrances
+		const int runLength = i - runStart;
+		int picks[ 2 ];
+		int numPicks = 0;
+		if( runLength >= g_longEntrance )
+		{
+			picks[ numPicks++ ] = runStart;
+			picks[ numPicks++ ] = i - 1;
+		}
+		else
+			picks[ numPicks++ ] = runStart + ( runLength - 1 ) / 2;
+
+		for( int p = 0; p < numPicks; ++p )
+		{
+			const int pickX = horizontal ? x + picks[ p ] : x;
+			const int pickY = horizontal ? y : y + picks[ p ];
+			cluster.cells.push_back( grid.GetCellIndex( pickX, pickY ) );
+			cluster.partners.push_back( grid.GetCellIndex( pickX + dx, pickY + dy ) );
+		}
+
+		runStart = -1;
+	}
+}
+
+//------------------------------------------------------------------------------
+// Name: FloodCluster()
+// Desc: Dijkstra search from a cell, never leaving its cluster. The costs
+//		 and parents are left in the local workspace
+//------------------------------------------------------------------------------
+void HierarchicalSearch::FloodCluster( const Grid& grid, const Cluster& cluster, const int fromCell )
+{
+	const int width = cluster.maxX - cluster.minX + 1;
+	const int height = cluster.maxY - cluster.minY + 1;
+
+	for( int y = 0; y < height; ++y )
+		for( int x = 0; x < width; ++x )
+			m_localCost[ y * CLUSTER_SIZE + x ] = -1;
+
+	const int fromLocal = ( grid.GetCellY( fromCell ) - cluster.minY ) * CLUSTER_SIZE +
+						  ( grid.GetCellX( fromCell ) - cluster.minX );
+	m_localCost[ fromLocal ] = 0;
+	m_localParent[ fromLocal ] = -1;
+
+	m_localQueue.Push( fromLocal, 0 );
+
+	const int offsetX[ 4 ] = { 0, 1, 0, -1 };
+	const int offsetY[ 4 ] = { -1, 0, 1, 0 };
+
+	while( ! m_localQueue.IsEmpty() )
+	{
+		const int local = m_localQueue.Pop();
+		const int localX = local % CLUSTER_SIZE;
+		const int localY = local / CLUSTER_SIZE;
+
+		for( int i = 0; i < 4; ++i )
+		{
+			const int nextX = localX + offsetX[ i ];
+			const int nextY = localY + offsetY[ i ];
+			if( nextX < 0 || nextX >= width || nextY < 0 || nextY >= height )
+				continue;
+
+			const int x = cluster.minX + nextX;
+			const int y = cluster.minY + nextY;
+			if( ! grid.IsPath( x, y ) )
+				continue;
+
+			const int next = nextY * CLUSTER_SIZE + nextX;
+			const int cost = m_localCost[ local ] + grid.GetWeight( x, y );
+			if( m_localCost[ next ] >= 0 && m_localCost[ next ] <= cost )
+				continue;
+
+			m_localCost[ next ] = cost;
+			m_localParent[ next ] = local;
+			m_localQueue.Push( next, cost );
+		}
+	}
+}
+
+//------------------------------------------------------------------------------
+// Name: GetFloodCost()
+// Desc: Returns the cost to a cell from the last flood, or -1 if not reached
+//------------------------------------------------------------------------------
+int HierarchicalSearch::GetFloodCost( const Grid& grid, const Cluster& cluster, const int cell ) const
+{
+	return m_localCost[ ( grid.GetCellY( cell ) - cluster.minY ) * CLUSTER_SIZE +
+						( grid.GetCellX( cell ) - cluster.minX ) ];
+}
+
+//------------------------------------------------------------------------------
+// Name: AppendFloodPath()
+// Desc: Appends the route from the last flood's origin to a cell, not
+//		 including the origin itself
+//------------------------------------------------------------------------------
+void HierarchicalSearch::AppendFloodPath( const Grid& grid, const Cluster& cluster, const int toCell,
+										  SolverInts& path ) const
+{
+	const size_t first = path.size();
+
+	int local = ( grid.GetCellY( toCell ) - cluster.minY ) * CLUSTER_SIZE +
+				( grid.GetCellX( toCell ) - cluster.minX );
+	while( m_localParent[ local ] >= 0 )
+	{
+		path.push_back( grid.GetCellIndex( cluster.minX + local % CLUSTER_SIZE,
+										   cluster.minY + local / CLUSTER_SIZE ) );
+		local = m_localParent[ local ];
+	}
+
+	reverse( path.begin() + first, path.end() );
+}
+
+//------------------------------------------------------------------------------
+// Name: FindPath()
+// Desc: Finds a route from an open cell to the nearest of several goals,
+//		 filling in every cell along the way from start to goal inclusive and
+//		 the index of the goal reached. Returns FALSE if there is none. A goal
+//		 inside the start's cluster is taken directly if it can be reached
+//		 without leaving the cluster
+//------------------------------------------------------------------------------
+bool HierarchicalSearch::FindPath( const Grid& grid, const int startCell, const int* pGoalCells,
+								   const int numGoals, SolverInts& path, int& goalIndex, GridStats& stats )
+{
+	path.clear();
+	goalIndex = -1;
+	Refresh( grid );
+
+	const int startX = grid.GetCellX( startCell ), startY = grid.GetCellY( startCell );
+	const int startCluster = GetCluster( startX, startY );
+	const Cluster& start = m_clusters[ startCluster ];
+
+	//costs from the start to the entrances of its cluster, and the cheapest
+	// goal that can be reached without leaving it
+	FloodCluster( grid, start, startCell );
+	int localCost = -1;
+	for( int i = 0; i < numGoals; ++i )
+	{
+		const int goalCell = pGoalCells[ i ];
+		if( GetCluster( grid.GetCellX( goalCell ), grid.GetCellY( goalCell ) ) != startCluster )
+			continue;
+
+		const int cost = GetFloodCost( grid, start, goalCell );
+		if( cost >= 0 && ( localCost < 0 || cost < localCost ) )
+		{
+			localCost = cost;
+			goalIndex = i;
+		}
+	}
+
+	if( goalIndex >= 0 )
+	{
+		path.push_back( startCell );
+		AppendFloodPath( grid, start, pGoalCells[ goalIndex ], path );
+		return true;
+	}
+
+	SolverInts startCosts( start.cells.size() );
+	for( size_t i = 0; i < start.cells.size(); ++i )
+		startCosts[ i ] = GetFloodCost( grid, start, start.cells[ i ] );
+
+	//costs from the entrances of each goal's cluster to the goal. Costs are
+	// paid on entering a cell, so the flood out from the goal is turned around
+	SolverInts goalClusters( numGoals );
+	TrackedVector< SolverInts, MemoryTracker::SUBSYSTEM_SOLVER >::Type goalCosts( numGoals );
+	for( int g = 0; g < numGoals; ++g )
+	{
+		const int goalCell = pGoalCells[ g ];
+		const int goalX = grid.GetCellX( goalCell ), goalY = grid.GetCellY( goalCell );
+		goalClusters[ g ] = GetCluster( goalX, goalY );
+
+		const Cluster& goal = m_clusters[ goalClusters[ g ] ];
+		FloodCluster( grid, goal, goalCell );
+		goalCosts[ g ].resize( goal.cells.size() );
+		for( size_t i = 0; i < goal.cells.size(); ++i )
+		{
+			const int cell = goal.cells[ i ];
+			const int cost = GetFloodCost( grid, goal, cell );
+			goalCosts[ g ][ i ] = ( cost < 0 ) ? -1 :
+								  cost - grid.GetWeight( grid.GetCellX( cell ), grid.GetCellY( cell ) ) +
+								  grid.GetWeight( goalX, goalY );
+		}
+	}
+
+	//A* over the entrances, with the start and goal as extra nodes
+	AbstractNodeMap nodes;
+	OpenQueue openQueue;
+
+	AbstractNode& startNode = nodes[ g_startNode ];
+	startNode.cost = 0;
+	startNode.parent = g_startNode;
+	startNode.cell = startCell;
+	startNode.closed = false;
+	openQueue.push( OpenEntry( 0, g_startNode ) );
+
+	OpenEntries edges;	//( edge cost, node ) out of the node being expanded
+	while( ! openQueue.empty() )
+	{
+		const int id = openQueue.top().second;
+		openQueue.pop();
+
+		AbstractNode& current = nodes[ id ];
+		if( current.closed )
+			continue;
+		current.closed = true;
+		GRID_STAT_INC( stats, nodesExpanded );
+
+		if( id <= g_goalNode )
+		{
+			goalIndex = g_goalNode - id;
+			break;
+		}
+
+		//gather this node's edges
+		edges.clear();
+		if( g_startNode == id )
+		{
+			for( size_t i = 0; i < startCosts.size(); ++i )
+				if( startCosts[ i ] >= 0 )
+					edges.push_back( OpenEntry( startCosts[ i ], startCluster * MAX_ENTRANCES + int( i ) ) );
+		}
+		else
+		{
+			const int clusterIndex = id / MAX_ENTRANCES;
+			const int entrance = id % MAX_ENTRANCES;
+			const Cluster& cluster = m_clusters[ clusterIndex ];
+			const int numEntrances = int( cluster.cells.size() );
+
+			for( int i = 0; i < numEntrances; ++i )
+			{
+				const int distance = cluster.distances[ entrance * numEntrances + i ];
+				if( i != entrance && distance >= 0 )
+					edges.push_back( OpenEntry( distance, clusterIndex * MAX_ENTRANCES + i ) );
+			}
+
+			//step across the border into the matching entrance
+			const int partner = cluster.partners[ entrance ];
+			const int partnerIndex = GetCluster( grid.GetCellX( partner ), grid.GetCellY( partner ) );
+			const Cluster& partnerCluster = m_clusters[ partnerIndex ];
+			for( size_t i = 0; i < partnerCluster.cells.size(); ++i )
+			{
+				if( partnerCluster.cells[ i ] == partner &&
+					partnerCluster.partners[ i ] == cluster.cells[ entrance ] )
+				{
+					edges.push_back( OpenEntry( grid.GetWeight( grid.GetCellX( partner ), grid.GetCellY( partner ) ),
+												partnerIndex * MAX_ENTRANCES + int( i ) ) );
+					break;
+				}
+			}
+
+			for( int g = 0; g < numGoals; ++g )
+				if( clusterIndex == goalClusters[ g ] && goalCosts[ g ][ entrance ] >= 0 )
+					edges.push_back( OpenEntry( goalCosts[ g ][ entrance ], g_goalNode - g ) );
+		}
+
+		const int currentCost = current.cost;
+		for( size_t i = 0; i < edges.size(); ++i )
+		{
+			const int next = edges[ i ].second;
+			const int cost = currentCost + edges[ i ].first;
+
+			AbstractNodeMap::iterator iter = nodes.find( next );
+			if( iter == nodes.end() )
+			{
+				AbstractNode node;
+				node.cell = ( next <= g_goalNode ) ? pGoalCells[ g_goalNode - next ] :
+							m_clusters[ next / MAX_ENTRANCES ].cells[ next % MAX_ENTRANCES ];
+				iter = nodes.insert( AbstractNodeMap::value_type( next, node ) ).first;
+			}
+			else if( iter->second.cost <= cost )
+				continue;
+			else if( iter->second.closed )
+				GRID_STAT_INC( stats, nodesReopened );
+
+			AbstractNode& node = iter->second;
+			node.cost = cost;
+			node.parent = id;
+			node.closed = false;
+
+			GRID_STAT_INC( stats, heuristicCalls );
+			const int nodeX = grid.GetCellX( node.cell ), nodeY = grid.GetCellY( node.cell );
+			int nearest = -1;
+			for( int g = 0; g < numGoals; ++g )
+			{
+				const int distance = abs( nodeX - grid.GetCellX( pGoalCells[ g ] ) ) +
+									 abs( nodeY - grid.GetCellY( pGoalCells[ g ] ) );
+				if( nearest < 0 || distance < nearest )
+					nearest = distance;
+			}
+			openQueue.push( OpenEntry( cost + Grid::MIN_WEIGHT * nearest, next ) );
+		}
+
+		GRID_STAT_MAX( stats, peakOpenList, (unsigned int)( openQueue.size() ) );
+	}
+
+	if( goalIndex < 0 )
+		return false;
+
+	//walk back to get the abstract route, then fill in each leg of it
+	SolverInts route;
+	for( int id = g_goalNode - goalIndex; id != g_startNode; id = nodes[ id ].parent )
+		route.push_back( nodes[ id ].cell );
+	route.push_back( startCell );
+	reverse( route.begin(), route.end() );
+
+	path.push_back( startCell );
+	for( size_t i = 1; i < route.size(); ++i )
+	{
+		const int from = route[ i - 1 ];
+		const int to = route[ i ];
+		if( from == to )
+			continue;
+
+		const int fromCluster = GetCluster( grid.GetCellX( from ), grid.GetCellY( from ) );
+		if( fromCluster != GetCluster( grid.GetCellX( to ), grid.GetCellY( to ) ) )
+		{
+			path.push_back( to );
+			continue;
+		}
+
+		FloodCluster( grid, m_clusters[ fromCluster ], from );
+		AppendFloodPath( grid, m_clusters[ fromCluster ], to, path );
+	}
+
+	return true;
+}
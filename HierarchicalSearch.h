@@ -0,0 +1,99 @@
+//------------------------------------------------------------------------------
+// File: HierarchicalSearch.h
+// Desc: Hierarchical path-finding (HPA*) over clusters of the game grid
+//
+// Created: 19 October 2026 16:41:17
+//
+// (c)2002 Neil Wakefield
+//------------------------------------------------------------------------------
+
+
+#ifndef INCLUSIONGUARD_HIERARCHICALSEARCH_H
+#define INCLUSIONGUARD_HIERARCHICALSEARCH_H
+
+
+//------------------------------------------------------------------------------
+// Included files:
+//------------------------------------------------------------------------------
+#include "BucketQueue.h"
+#include "DirtyChunks.h"
+#include "GridStats.h"
+#include "MemoryTracker.h"
+
+#include <vector>
+using namespace std;
+
+
+//------------------------------------------------------------------------------
+// Prototypes and declarations:
+//------------------------------------------------------------------------------
+class Grid;
+
+//------------------------------------------------------------------------------
+// Name: class HierarchicalSearch
+// Desc: Splits the grid into CLUSTER_SIZE square clusters. Each cluster caches
+//		 its entrances - open cells facing an open cell in the next cluster -
+//		 and the distances between them. A query searches this small abstract
+//		 graph, then fills in the route one cluster at a time. Clusters are
+//		 rebuilt lazily once a tile in or beside them has changed.
+//		 The path found is not always the shortest, as in the original HPA*
+//------------------------------------------------------------------------------
+class HierarchicalSearch
+{
+
+public:
+	typedef TrackedVector< int, MemoryTracker::SUBSYSTEM_SOLVER >::Type SolverInts;
+
+	HierarchicalSearch();
+
+	const static int CLUSTER_SIZE = DirtyChunks::CHUNK_SIZE;
+
+	void Resize( const int width, const int height );
+	void MarkTile( const int x, const int y ) { m_dirtyClusters.MarkTile( x, y ); }
+
+	void Refresh( const Grid& grid );
+	bool FindPath( const Grid& grid, const int startCell, const int* pGoalCells, const int numGoals,
+				   SolverInts& path, int& goalIndex, GridStats& stats );
+
+	int GetNumNodes() const;
+
+private:
+	//entrances per cluster can't exceed this, so ( cluster, entrance ) pairs
+	// pack into a single int
+	const static int MAX_ENTRANCES = 4 * CLUSTER_SIZE;
+
+	struct Cluster
+	{
+		int minX, minY, maxX, maxY;
+		SolverInts cells;		//entrance cells inside this cluster
+		SolverInts partners;	//the open cell facing each entrance
+		SolverInts distances;	//entrance to entrance, -1 if unreachable
+	};
+
+	int m_width;
+	int m_height;
+	int m_numX;
+	TrackedVector< Cluster, MemoryTracker::SUBSYSTEM_SOLVER >::Type m_clusters;
+	DirtyChunks m_dirtyClusters;
+
+	//workspace for flooding a single cluster
+	SolverInts m_localCost;
+	SolverInts m_localParent;
+	BucketQueue m_localQueue;
+
+	int GetCluster( const int x, const int y ) const
+	{
+		return ( y / CLUSTER_SIZE ) * m_numX + ( x / CLUSTER_SIZE );
+	}
+
+	void BuildCluster( const Grid& grid, const int index );
+	void AddEntrances( const Grid& grid, Cluster& cluster, const int side );
+	void FloodCluster( const Grid& grid, const Cluster& cluster, const int fromCell );
+	int GetFloodCost( const Grid& grid, const Cluster& cluster, const int cell ) const;
+	void AppendFloodPath( const Grid& grid, const Cluster& cluster, const int toCell,
+						  SolverInts& path ) const;
+
+};
+
+
+#endif //INCLUSIONGUARD_HIERARCHICALSEARCH_H
@@ -0,0 +1,172 @@
+//------------------------------------------------------------------------------
+// File: Histogram.cpp
+// Desc: Fixed-bucket histogram of durations with percentile queries
+//
+// Created: 19 October 2026 16:20:47
+//
+// (c)2002 Neil Wakefield
+//------------------------------------------------------------------------------
+
+
+//------------------------------------------------------------------------------
+// Included files:
+//------------------------------------------------------------------------------
+#include "Histogram.h"
+
+
+//------------------------------------------------------------------------------
+// Globals:
+//------------------------------------------------------------------------------
+
+
+//------------------------------------------------------------------------------
+// Definitions:
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Name: Histogram()
+// Desc: Constructor for the histogram object
+//------------------------------------------------------------------------------
+Histogram::Histogram()
+{
+	Clear();
+}
+
+//------------------------------------------------------------------------------
+// Name: Clear()
+// Desc: Empties every bucket
+//------------------------------------------------------------------------------
+void Histogram::Clear()
+{
+	for( int i = 0; i < NUM_BUCKETS; ++i )
+		m_buckets[ i ] = 0;
+
+	m_count = 0;
+	m_max = 0;
+	m_total = 0.0;
+}
+
+//------------------------------------------------------------------------------
+// Name: Record()
+// Desc: Adds a duration given in seconds
+//------------------------------------------------------------------------------
+void Histogram::Record( const double seconds )
+{
+	double us = seconds * 1.0e6 + 0.5;
+	if( us < 0.0 )
+		us = 0.0;
+	else if( us > 4294967295.0 )
+		us = 4294967295.0;
+
+	RecordMicroseconds( (unsigned int)( us ) );
+}
+
+//------------------------------------------------------------------------------
+// Name: RecordMicroseconds()
+// Desc: Adds a duration given in microseconds
+//------------------------------------------------------------------------------
+void Histogram::RecordMicroseconds( const unsigned int us )
+{
+	++m_buckets[ GetBucket( us ) ];
+	++m_count;
+	m_total += us;
+	if( us > m_max )
+		m_max = us;
+}
+
+//------------------------------------------------------------------------------
+// Name: Merge()
+// Desc: Adds the contents of another histogram to this one
+//------------------------------------------------------------------------------
+void Histogram::Merge( const Histogram& other )
+{
+	for( int i = 0; i < NUM_BUCKETS; ++i )
+		m_buckets[ i ] += other.m_buckets[ i ];
+
+	m_count += other.m_count;
+	m_total += other.m_total;
+	if( other.m_max > m_max )
+		m_max = other.m_max;
+}
+
+//------------------------------------------------------------------------------
+// Name: GetMean()
+// Desc: Returns the mean duration in seconds
+//------------------------------------------------------------------------------
+double Histogram::GetMean() const
+{
+	if( 0 == m_count )
+		return 0.0;
+
+	return ( m_total / m_count ) * 1.0e-6;
+}
+
+//------------------------------------------------------------------------------
+// Name: GetPercentile()
+// Desc: Returns the duration in seconds below which the given percentage of
+//		 samples fall. The answer is the upper bound of the bucket holding that
+//		 sample, capped at the largest duration seen
+//------------------------------------------------------------------------------
+double Histogram::GetPercentile( const double percent ) const
+{
+	if( 0 == m_count )
+		return 0.0;
+
+	//rank of the sample we want, counting from 1
+	double rank = percent / 100.0 * m_count;
+	if( rank < 1.0 )
+		rank = 1.0;
+
+	unsigned int seen = 0;
+	for( int i = 0; i < NUM_BUCKETS; ++i )
+	{
+		seen += m_buckets[ i ];
+		if( seen >= rank )
+		{
+			unsigned int us = GetBucketUpperBound( i );
+			if( us > m_max )
+				us = m_max;
+			return us * 1.0e-6;
+		}
+	}
+
+	return GetMax();
+}
+
+//------------------------------------------------------------------------------
+// Name: GetBucket()
+// Desc: Returns the bucket for a duration. Values below 4 get a bucket each,
+//		 above that each power of two is split into four
+//------------------------------------------------------------------------------
+int Histogram::GetBucket( const unsigned int us )
+{
+	if( us < 4 )
+		return int( us );
+
+	//find the highest set bit
+	int msb = 2;
+	while( msb < 31 && ( us >> ( msb + 1 ) ) != 0 )
+		++msb;
+
+	const int sub = int( ( us >> ( msb - 2 ) ) & 3 );
+	return ( msb - 1 ) * 4 + sub;
+}
+
+//------------------------------------------------------------------------------
+// Name: GetBucketUpperBound()
+// Desc: Returns the largest duration that falls into a bucket
+//------------------------------------------------------------------------------
+unsigned int Histogram::GetBucketUpperBound( const int bucket )
+{
+	if( bucket < 4 )
+		return (unsigned int)( bucket );
+
+	const int msb = bucket / 4 + 1;
+	const unsigned int sub = (unsigned int)( bucket % 4 );
+
+	//the top bucket would overflow, so clamp it
+	if( 31 == msb && 3 == sub )
+		return 0xffffffff;
+
+	return ( ( 5 + sub ) << ( msb - 2 ) ) - 1;
+}
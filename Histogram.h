@@ -0,0 +1,56 @@
+//------------------------------------------------------------------------------
+// File: Histogram.h
+// Desc: Fixed-bucket histogram of durations with percentile queries
+//
+// Created: 19 October 2026 16:12:09
+//
+// (c)2002 Neil Wakefield
+//------------------------------------------------------------------------------
+
+
+#ifndef INCLUSIONGUARD_HISTOGRAM_H
+#define INCLUSIONGUARD_HISTOGRAM_H
+
+
+//------------------------------------------------------------------------------
+// Prototypes and declarations:
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Name: class Histogram
+// Desc: Records durations in microseconds into log-spaced buckets, four per
+//		 power of two, so any percentile is accurate to within 25%. Recording
+//		 is constant time and the histogram never allocates
+//------------------------------------------------------------------------------
+class Histogram
+{
+
+public:
+	Histogram();
+
+	const static int NUM_BUCKETS = 128;
+
+	void Record( const double seconds );
+	void RecordMicroseconds( const unsigned int us );
+	void Merge( const Histogram& other );
+	void Clear();
+
+	unsigned int GetCount() const { return m_count; }
+	double GetMean() const;
+	double GetMax() const { return m_max * 1.0e-6; }
+	double GetPercentile( const double percent ) const;
+
+	unsigned int GetBucketCount( const int bucket ) const { return m_buckets[ bucket ]; }
+	static int GetBucket( const unsigned int us );
+	static unsigned int GetBucketUpperBound( const int bucket );
+
+private:
+	unsigned int m_buckets[ NUM_BUCKETS ];
+	unsigned int m_count;
+	unsigned int m_max;
+	double m_total;
+
+};
+
+
+#endif //INCLUSIONGUARD_HISTOGRAM_H
@@ -0,0 +1,182 @@
+//------------------------------------------------------------------------------
+// File: InstanceBench.cpp
+// Desc: Measures how fast the instance buffer can be filled and expanded
+//
+// Created: 20 October 2026 05:48:09
+//
+// (c)2002 Neil Wakefield
+//------------------------------------------------------------------------------
+
+
+//------------------------------------------------------------------------------
+// Included files:
+//------------------------------------------------------------------------------
+#include "Constants.h"
+#include "InstanceBuffer.h"
+#include "Random.h"
+#include "Timer.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <vector>
+using namespace std;
+
+
+//------------------------------------------------------------------------------
+// Globals:
+//------------------------------------------------------------------------------
+namespace
+{
+	//roughly the size of the sphere D3DXCreateSphere makes with 20 slices
+	// and 20 stacks
+	const int g_meshVertices = 382;
+
+	//--------------------------------------------------------------------------
+	// Name: GetFloat()
+	// Desc: Returns a number in [0, 1)
+	//--------------------------------------------------------------------------
+	float GetFloat( Random& random )
+	{
+		return ( random.Next() >> 8 ) / 16777216.0f;
+	}
+
+	//--------------------------------------------------------------------------
+	// Name: TimeBuild()
+	// Desc: Returns the best time of several builds, in seconds
+	//--------------------------------------------------------------------------
+	double TimeBuild( InstanceBuffer& buffer, const vector< Vector3 >& agents,
+					  const Frustum* pFrustum, const int numRuns )
+	{
+		double best = 0.0;
+		for( int run = 0; run < numRuns; ++run )
+		{
+			Timer timer;
+			buffer.Build( &agents[ 0 ], int( agents.size() ), CONST_PLAYER_SIZE, pFrustum );
+			const double seconds = timer.GetSeconds();
+			if( 0 == run || seconds < best )
+				best = seconds;
+		}
+
+		return best;
+	}
+
+	//--------------------------------------------------------------------------
+	// Name: TimeExpand()
+	// Desc: Returns the best time of several expansions of every instance in
+	//		 batches, in seconds
+	//--------------------------------------------------------------------------
+	double TimeExpand( const InstanceBuffer& buffer, const vector< float >& mesh,
+					   const int batchSize, vector< float >& out, const int numRuns )
+	{
+		double best = 0.0;
+		for( int run = 0; run < numRuns; ++run )
+		{
+			Timer timer;
+			for( int first = 0; first < buffer.GetNumInstances(); first += batchSize )
+			{
+				int count = buffer.GetNumInstances() - first;
+				if( count > batchSize )
+					count = batchSize;
+				buffer.Expand( &mesh[ 0 ], g_meshVertices, first, count, &out[ 0 ] );
+			}
+			const double seconds = timer.GetSeconds();
+			if( 0 == run || seconds < best )
+				best = seconds;
+		}
+
+		return best;
+	}
+
+	//--------------------------------------------------------------------------
+	// Name: Report()
+	// Desc: Prints one line of results
+	//--------------------------------------------------------------------------
+	void Report( const char* pName, const double seconds, const int numItems,
+				 const char* pUnits )
+	{
+		printf( "%-24s %9.3f ms %10.1f M%s/s\n", pName, seconds * 1000.0,
+				numItems / seconds / 1000000.0, pUnits );
+	}
+}
+
+
+//------------------------------------------------------------------------------
+// Definitions:
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Name: main()
+// Desc: Entry point - InstanceBench [agents] [runs]
+//------------------------------------------------------------------------------
+int main( int argc, char* argv[] )
+{
+	const int numAgents = ( argc > 1 ) ? atoi( argv[ 1 ] ) : 100000;
+	const int numRuns = ( argc > 2 ) ? atoi( argv[ 2 ] ) : 20;
+	if( numAgents <= 0 || numRuns <= 0 )
+	{
+		fprintf( stderr, "usage: InstanceBench [agents] [runs]\n" );
+		return 1;
+	}
+
+	//agents scattered over a maze big enough that a chase-cam sees only some
+	Random random( 1 );
+	const float size = 1024.0f;
+	vector< Vector3 > agents( numAgents );
+	for( int i = 0; i < numAgents; ++i )
+	{
+		agents[ i ] = Vector3( GetFloat( random ) * size - size / 2.0f,
+							   GetFloat( random ) * size - size / 2.0f, 0.5f );
+	}
+
+	Frustum sideView;
+	sideView.Build( Vector3( -0.5f, -0.5f, ( size + 2 ) * -1.4f ), Vector3( -0.5f, -0.5f, 0.0f ),
+					Vector3( 0.0f, 1.0f, 0.0f ), CONST_CAMERA_FOV, 4.0f / 3.0f,
+					CONST_CAMERA_NEAR, size * 2.0f, size * 2.0f );
+
+	Frustum chaseCam;
+	chaseCam.Build( Vector3( -8.0f, -8.0f, -9.5f ), Vector3( 0.0f, 0.0f, 0.5f ),
+					Vector3( 0.0f, 0.0f, -1.0f ), CONST_CAMERA_FOV, 4.0f / 3.0f,
+					CONST_CAMERA_NEAR, CONST_CAMERA_FAR, CONST_CHASECAM_RANGE );
+
+	//any mesh of the right size will do for timing
+	vector< float > mesh( g_meshVertices * InstanceBuffer::VERTEX_FLOATS );
+	for( size_t i = 0; i < mesh.size(); ++i )
+		mesh[ i ] = GetFloat( random );
+
+	const int batchSize = InstanceBuffer::GetMaxBatch( g_meshVertices );
+	vector< float > out( batchSize * g_meshVertices * InstanceBuffer::VERTEX_FLOATS );
+
+	printf( "%d agents, best of %d runs, SSE %s\n", numAgents, numRuns,
+			InstanceBuffer::IsSimdAvailable() ? "available" : "not available" );
+
+	InstanceBuffer buffer;
+	for( int simd = 0; simd < 2; ++simd )
+	{
+		if( 1 == simd && ! InstanceBuffer::IsSimdAvailable() )
+			break;
+		buffer.SetUseSimd( 1 == simd );
+		const char* pPath = simd ? "sse" : "scalar";
+
+		char name[ 64 ];
+		sprintf( name, "build %s, no cull", pPath );
+		Report( name, TimeBuild( buffer, agents, NULL, numRuns ), numAgents, "agents" );
+
+		sprintf( name, "build %s, side view", pPath );
+		Report( name, TimeBuild( buffer, agents, &sideView, numRuns ), numAgents, "agents" );
+		const int numSide = buffer.GetNumInstances();
+
+		sprintf( name, "build %s, chase-cam", pPath );
+		Report( name, TimeBuild( buffer, agents, &chaseCam, numRuns ), numAgents, "agents" );
+		const int numChase = buffer.GetNumInstances();
+		printf( "  visible: side view %d, chase-cam %d\n", numSide, numChase );
+
+		//expand everything, as the side view sees it all
+		buffer.Build( &agents[ 0 ], numAgents, CONST_PLAYER_SIZE, NULL );
+		sprintf( name, "expand %s", pPath );
+		Report( name, TimeExpand( buffer, mesh, batchSize, out, numRuns ),
+				numAgents * g_meshVertices, "vertices" );
+	}
+
+	return 0;
+}
@@ -0,0 +1,286 @@
+//------------------------------------------------------------------------------
+// File: InstanceBuffer.cpp
+// Desc: Per-frame list of visible agents, packed for batched drawing
+//
+// Created: 20 October 2026 05:26:14
+//
+// (c)2002 Neil Wakefield
+//------------------------------------------------------------------------------
+
+
+//------------------------------------------------------------------------------
+// Included files:
+//------------------------------------------------------------------------------
+#include "InstanceBuffer.h"
+
+#ifdef INSTANCEBUFFER_SSE
+#include <xmmintrin.h>
+#endif
+
+
+//------------------------------------------------------------------------------
+// Globals:
+//------------------------------------------------------------------------------
+
+
+//------------------------------------------------------------------------------
+// Definitions:
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Name: InstanceBuffer()
+// Desc: Constructor for the instance buffer object
+//------------------------------------------------------------------------------
+InstanceBuffer::InstanceBuffer()
+{
+	m_numInstances = 0;
+	m_useSimd = IsSimdAvailable();
+}
+
+//------------------------------------------------------------------------------
+// Name: IsSimdAvailable()
+// Desc: Returns true if the SSE paths were compiled in
+//------------------------------------------------------------------------------
+bool InstanceBuffer::IsSimdAvailable()
+{
+#ifdef INSTANCEBUFFER_SSE
+	return true;
+#else
+	return false;
+#endif
+}
+
+//------------------------------------------------------------------------------
+// Name: SetUseSimd()
+// Desc: Chooses between the SSE and plain paths, where there is a choice
+//------------------------------------------------------------------------------
+void InstanceBuffer::SetUseSimd( const bool useSimd )
+{
+	m_useSimd = useSimd && IsSimdAvailable();
+}
+
+//------------------------------------------------------------------------------
+// Name: Build()
+// Desc: Fills the buffer with the agents that can be seen, returning how many
+//------------------------------------------------------------------------------
+int InstanceBuffer::Build( const Vector3* pPositions, const int count, const float radius,
+						   const Frustum* pFrustum )
+{
+	m_numInstances = 0;
+	if( count <= 0 )
+		return 0;
+
+	if( int( m_instances.size() ) < count )
+		m_instances.resize( count );
+
+#ifdef INSTANCEBUFFER_SSE
+	if( m_useSimd && pFrustum )
+	{
+		BuildSimd( pPositions, count, radius, *pFrustum );
+		return m_numInstances;
+	}
+#endif
+
+	BuildScalar( pPositions, 0, count, radius, pFrustum );
+	return m_numInstances;
+}
+
+//------------------------------------------------------------------------------
+// Name: BuildScalar()
+// Desc: Adds the visible agents of a range one at a time
+//------------------------------------------------------------------------------
+void InstanceBuffer::BuildScalar( const Vector3* pPositions, const int first, const int count,
+								  const float radius, const Frustum* pFrustum )
+{
+	Instance* pOut = &m_instances[ 0 ];
+	int numInstances = m_numInstances;
+
+	for( int i = first; i < first + count; ++i )
+	{
+		const Vector3& position = pPositions[ i ];
+		if( pFrustum && ! pFrustum->IsSphereVisible( position, radius ) )
+			continue;
+
+		Instance& instance = pOut[ numInstances++ ];
+		instance.x = position.x;
+		instance.y = position.y;
+		instance.z = position.z;
+		instance.scale = radius;
+	}
+
+	m_numInstances = numInstances;
+}
+
+#ifdef INSTANCEBUFFER_SSE
+//------------------------------------------------------------------------------
+// Name: BuildSimd()
+// Desc: Tests four agents at a time against the frustum, in the same order of
+//		 operations as Frustum::IsSphereVisible so both paths keep the same
+//		 agents. Each group is turned back into four instances and all four
+//		 are stored, but the count only moves past the visible ones, so the
+//		 hidden ones are written over by the next. The buffer holds one
+//		 instance per agent, so the stores never run off the end
+//------------------------------------------------------------------------------
+void InstanceBuffer::BuildSimd( const Vector3* pPositions, const int count, const float radius,
+								const Frustum& frustum )
+{
+	__m128 nx[ Frustum::NUM_PLANES ];
+	__m128 ny[ Frustum::NUM_PLANES ];
+	__m128 nz[ Frustum::NUM_PLANES ];
+	__m128 d[ Frustum::NUM_PLANES ];
+	for( int p = 0; p < Frustum::NUM_PLANES; ++p )
+	{
+		nx[ p ] = _mm_set1_ps( frustum.m_normals[ p ].x );
+		ny[ p ] = _mm_set1_ps( frustum.m_normals[ p ].y );
+		nz[ p ] = _mm_set1_ps( frustum.m_normals[ p ].z );
+		d[ p ] = _mm_set1_ps( frustum.m_distances[ p ] );
+	}
+
+	const __m128 eyeX = _mm_set1_ps( frustum.m_eye.x );
+	const __m128 eyeY = _mm_set1_ps( frustum.m_eye.y );
+	const __m128 eyeZ = _mm_set1_ps( frustum.m_eye.z );
+	const float range = frustum.m_maxDistance + radius;
+	const __m128 rangeSq = _mm_set1_ps( range * range );
+	const __m128 minDist = _mm_set1_ps( -radius );
+	const __m128 scale = _mm_set1_ps( radius );
+
+	Instance* pOut = &m_instances[ 0 ];
+	int numInstances = 0;
+
+	int i = 0;
+	for( ; i + 4 <= count; i += 4 )
+	{
+		//three loads cover four packed positions, which are shuffled apart
+		// into x, y and z for each
+		const float* pIn = &pPositions[ i ].x;
+		const __m128 a = _mm_loadu_ps( pIn );		//x0 y0 z0 x1
+		const __m128 b = _mm_loadu_ps( pIn + 4 );	//y1 z1 x2 y2
+		const __m128 c = _mm_loadu_ps( pIn + 8 );	//z2 x3 y3 z3
+
+		const __m128 bc = _mm_shuffle_ps( b, c, _MM_SHUFFLE( 2, 1, 3, 2 ) );	//x2 y2 x3 y3
+		const __m128 ab = _mm_shuffle_ps( a, b, _MM_SHUFFLE( 0, 0, 1, 1 ) );	//y0 y0 y1 y1
+		const __m128 az = _mm_shuffle_ps( a, b, _MM_SHUFFLE( 1, 1, 2, 2 ) );	//z0 z0 z1 z1
+		const __m128 cz = _mm_shuffle_ps( c, c, _MM_SHUFFLE( 3, 3, 0, 0 ) );	//z2 z2 z3 z3
+		__m128 x = _mm_shuffle_ps( a, bc, _MM_SHUFFLE( 2, 0, 3, 0 ) );
+		__m128 y = _mm_shuffle_ps( ab, bc, _MM_SHUFFLE( 3, 1, 2, 0 ) );
+		__m128 z = _mm_shuffle_ps( az, cz, _MM_SHUFFLE( 2, 0, 2, 0 ) );
+
+		__m128 visible = _mm_cmpnlt_ps( _mm_add_ps( _mm_add_ps( _mm_add_ps(
+										_mm_mul_ps( nx[ 0 ], x ), _mm_mul_ps( ny[ 0 ], y ) ),
+										_mm_mul_ps( nz[ 0 ], z ) ), d[ 0 ] ), minDist );
+		for( int p = 1; p < Frustum::NUM_PLANES; ++p )
+		{
+			const __m128 dist = _mm_add_ps( _mm_add_ps( _mm_add_ps(
+								_mm_mul_ps( nx[ p ], x ), _mm_mul_ps( ny[ p ], y ) ),
+								_mm_mul_ps( nz[ p ], z ) ), d[ p ] );
+			visible = _mm_and_ps( visible, _mm_cmpnlt_ps( dist, minDist ) );
+		}
+
+		const __m128 ox = _mm_sub_ps( x, eyeX );
+		const __m128 oy = _mm_sub_ps( y, eyeY );
+		const __m128 oz = _mm_sub_ps( z, eyeZ );
+		const __m128 distSq = _mm_add_ps( _mm_add_ps( _mm_mul_ps( ox, ox ), _mm_mul_ps( oy, oy ) ),
+										  _mm_mul_ps( oz, oz ) );
+		visible = _mm_and_ps( visible, _mm_cmple_ps( distSq, rangeSq ) );
+
+		const int mask = _mm_movemask_ps( visible );
+		if( 0 == mask )
+			continue;
+
+		__m128 w = scale;
+		_MM_TRANSPOSE4_PS( x, y, z, w );
+		_mm_storeu_ps( &pOut[ numInstances ].x, x );
+		numInstances += mask & 1;
+		_mm_storeu_ps( &pOut[ numInstances ].x, y );
+		numInstances += ( mask >> 1 ) & 1;
+		_mm_storeu_ps( &pOut[ numInstances ].x, z );
+		numInstances += ( mask >> 2 ) & 1;
+		_mm_storeu_ps( &pOut[ numInstances ].x, w );
+		numInstances += ( mask >> 3 ) & 1;
+	}
+
+	m_numInstances = numInstances;
+	BuildScalar( pPositions, i, count - i, radius, &frustum );
+}
+#endif
+
+//------------------------------------------------------------------------------
+// Name: GetMaxBatch()
+// Desc: Returns how many copies of a mesh fit in a 16 bit index range
+//------------------------------------------------------------------------------
+int InstanceBuffer::GetMaxBatch( const int numVertices )
+{
+	if( numVertices <= 0 )
+		return 0;
+
+	return 65536 / numVertices;
+}
+
+//------------------------------------------------------------------------------
+// Name: Expand()
+// Desc: Writes a copy of the mesh for each of a range of instances, scaled
+//		 and then moved into place
+//------------------------------------------------------------------------------
+void InstanceBuffer::Expand( const float* pVertices, const int numVertices, const int first,
+							 const int count, float* pOut ) const
+{
+	const int numFloats = numVertices * VERTEX_FLOATS;
+
+	for( int i = first; i < first + count; ++i )
+	{
+		const Instance& instance = m_instances[ i ];
+		int v = 0;
+
+#ifdef INSTANCEBUFFER_SSE
+		if( m_useSimd )
+		{
+			//two vertices make three registers, and each lines up with its
+			// own mix of scale and offset for the positions and normals
+			const float s = instance.scale;
+			const __m128 scale0 = _mm_set_ps( 1.0f, s, s, s );
+			const __m128 scale1 = _mm_set_ps( s, s, 1.0f, 1.0f );
+			const __m128 scale2 = _mm_set_ps( 1.0f, 1.0f, 1.0f, s );
+			const __m128 move0 = _mm_set_ps( 0.0f, instance.z, instance.y, instance.x );
+			const __m128 move1 = _mm_set_ps( instance.y, instance.x, 0.0f, 0.0f );
+			const __m128 move2 = _mm_set_ps( 0.0f, 0.0f, 0.0f, instance.z );
+
+			for( ; v + 2 <= numVertices; v += 2 )
+			{
+				const float* pIn = pVertices + v * VERTEX_FLOATS;
+				_mm_storeu_ps( pOut, _mm_add_ps( _mm_mul_ps( _mm_loadu_ps( pIn ), scale0 ), move0 ) );
+				_mm_storeu_ps( pOut + 4, _mm_add_ps( _mm_mul_ps( _mm_loadu_ps( pIn + 4 ), scale1 ), move1 ) );
+				_mm_storeu_ps( pOut + 8, _mm_add_ps( _mm_mul_ps( _mm_loadu_ps( pIn + 8 ), scale2 ), move2 ) );
+				pOut += 2 * VERTEX_FLOATS;
+			}
+		}
+#endif
+
+		for( const float* pIn = pVertices + v * VERTEX_FLOATS;
+			 pIn < pVertices + numFloats; pIn += VERTEX_FLOATS )
+		{
+			pOut[ 0 ] = pIn[ 0 ] * instance.scale + instance.x;
+			pOut[ 1 ] = pIn[ 1 ] * instance.scale + instance.y;
+			pOut[ 2 ] = pIn[ 2 ] * instance.scale + instance.z;
+			pOut[ 3 ] = pIn[ 3 ];
+			pOut[ 4 ] = pIn[ 4 ];
+			pOut[ 5 ] = pIn[ 5 ];
+			pOut += VERTEX_FLOATS;
+		}
+	}
+}
+
+//------------------------------------------------------------------------------
+// Name: ExpandIndices()
+// Desc: Repeats a mesh's indices for a batch, offsetting each copy
+//------------------------------------------------------------------------------
+void InstanceBuffer::ExpandIndices( const unsigned short* pIndices, const int numIndices,
+									const int numVertices, const int count,
+									unsigned short* pOut )
+{
+	for( int c = 0; c < count; ++c )
+	{
+		const int base = c * numVertices;
+		for( int i = 0; i < numIndices; ++i )
+			*pOut++ = (unsigned short)( pIndices[ i ] + base );
+	}
+}
@@ -0,0 +1,112 @@
+//------------------------------------------------------------------------------
+// File: InstanceBuffer.h
+// Desc: Per-frame list of visible agents, packed for batched drawing
+//
+// Created: 20 October 2026 05:12:37
+//
+// (c)2002 Neil Wakefield
+//------------------------------------------------------------------------------
+
+
+#ifndef INCLUSIONGUARD_INSTANCEBUFFER_H
+#define INCLUSIONGUARD_INSTANCEBUFFER_H
+
+
+//------------------------------------------------------------------------------
+// Included files:
+//------------------------------------------------------------------------------
+#include "Frustum.h"
+#include "Vector3.h"
+
+#include <vector>
+using namespace std;
+
+//SSE is used wherever the compiler will generate it
+#if defined( __SSE__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 1 )
+#define INSTANCEBUFFER_SSE
+#endif
+
+
+//------------------------------------------------------------------------------
+// Prototypes and declarations:
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Name: struct Instance
+// Desc: Where to draw one copy of a mesh, and how much to scale it by. Four
+//		 floats, so one fills an SSE register
+//------------------------------------------------------------------------------
+struct Instance
+{
+	float x, y, z;
+	float scale;
+};
+
+//------------------------------------------------------------------------------
+// Name: class InstanceBuffer
+// Desc: Collects the agents a frustum can see into one contiguous array of
+//		 instances each frame, testing four at a time with SSE where it is
+//		 available. Direct3D 8 has no hardware instancing, so Expand then
+//		 writes a batch of instances out as pre-transformed copies of a mesh,
+//		 which the renderer draws in a single call against an index buffer
+//		 made once by ExpandIndices. Nothing here touches the device.
+//
+//		 Mesh vertices are VERTEX_FLOATS floats - a position and a normal, as
+//		 in MESH_VERTEX and WallVertex. Only uniform scales are supported, so
+//		 the normals are copied unchanged
+//------------------------------------------------------------------------------
+class InstanceBuffer
+{
+
+public:
+	InstanceBuffer();
+
+	enum { VERTEX_FLOATS = 6 };
+
+	//turning SSE off is for comparing against the plain version
+	static bool IsSimdAvailable();
+	void SetUseSimd( const bool useSimd );
+	bool GetUseSimd() const { return m_useSimd; }
+
+	//keeps the agents that are at least partly in the frustum, or all of them
+	// if there isn't one. radius is the size of the agents, and becomes each
+	// instance's scale, so the mesh should be made with a radius of one
+	int Build( const Vector3* pPositions, const int count, const float radius,
+			   const Frustum* pFrustum );
+
+	int GetNumInstances() const { return m_numInstances; }
+	const Instance* GetInstances() const
+	{
+		return m_instances.empty() ? NULL : &m_instances[ 0 ];
+	}
+
+	//the most copies of a mesh that 16 bit indices can reach
+	static int GetMaxBatch( const int numVertices );
+
+	//writes count moved and scaled copies of a mesh to pOut, one after the
+	// other, for the instances from first onwards
+	void Expand( const float* pVertices, const int numVertices, const int first,
+				 const int count, float* pOut ) const;
+
+	//writes count copies of a mesh's indices, each pointing at its own copy
+	// of the vertices
+	static void ExpandIndices( const unsigned short* pIndices, const int numIndices,
+							   const int numVertices, const int count,
+							   unsigned short* pOut );
+
+private:
+	vector< Instance > m_instances;		//only grows, so frames don't reallocate
+	int m_numInstances;
+	bool m_useSimd;
+
+	void BuildScalar( const Vector3* pPositions, const int first, const int count,
+					  const float radius, const Frustum* pFrustum );
+#ifdef INSTANCEBUFFER_SSE
+	void BuildSimd( const Vector3* pPositions, const int count, const float radius,
+					const Frustum& frustum );
+#endif
+
+};
+
+
+#endif //INCLUSIONGUARD_INSTANCEBUFFER_H
@@ -0,0 +1,204 @@
+//------------------------------------------------------------------------------
+// File: Landmarks.cpp
+// Desc: Landmark distance tables for the ALT search heuristic
+//
+// Created: 19 October 2026 18:57:02
+//
+// (c)2002 Neil Wakefield
+//------------------------------------------------------------------------------
+
+
+//------------------------------------------------------------------------------
+// Included files:
+//------------------------------------------------------------------------------
+#include "Landmarks.h"
+#include "Grid.h"
+
+
+//------------------------------------------------------------------------------
+// Globals:
+//------------------------------------------------------------------------------
+
+
+//------------------------------------------------------------------------------
+// Definitions:
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Name: Landmarks()
+// Desc: Constructor for the landmark tables
+//------------------------------------------------------------------------------
+Landmarks::Landmarks()
+{
+	m_valid = false;
+	m_hash = 0;
+	m_width = 0;
+	m_height = 0;
+	m_count = 0;
+}
+
+//------------------------------------------------------------------------------
+// Name: Update()
+// Desc: Rebuilds the tables if the grid has changed since they were built,
+//		 returning TRUE if it did
+//------------------------------------------------------------------------------
+bool Landmarks::Update( const Grid& grid, const int count )
+{
+	if( m_valid && m_hash == grid.GetHash() && m_count == count &&
+		m_width == grid.GetWidth() && m_height == grid.GetHeight() )
+		return false;
+
+	m_valid = true;
+	m_hash = grid.GetHash();
+	m_width = grid.GetWidth();
+	m_height = grid.GetHeight();
+	m_count = count;
+
+	const int numCells = grid.GetNumCells();
+	m_queue.Resize( numCells, Grid::MAX_WEIGHT );
+	m_cells.clear();
+	m_distances.assign( numCells * count, -1 );
+
+	//start from the cell farthest from an arbitrary open cell, which lies at
+	// the end of a long corridor
+	int pick = 0;
+	while( pick < numCells && ! grid.IsPath( grid.GetCellX( pick ), grid.GetCellY( pick ) ) )
+		++pick;
+	if( pick == numCells )
+		return true;
+
+	Flood( grid, pick );
+	for( int i = 0; i < numCells; ++i )
+		if( m_flood[ i ] > m_flood[ pick ] )
+			pick = i;
+
+	//distance from each cell to its nearest landmark so far
+	SolverInts nearest( numCells, -1 );
+
+	for( int landmark = 0; landmark < count; ++landmark )
+	{
+		if( landmark > 0 )
+		{
+			//next landmark is the cell farthest from all the others
+			for( int i = 0; i < numCells; ++i )
+				if( nearest[ i ] > nearest[ pick ] )
+					pick = i;
+
+			if( nearest[ pick ] <= 0 )
+				break;
+		}
+
+		m_cells.push_back( pick );
+		Flood( grid, pick );
+
+		for( int i = 0; i < numCells; ++i )
+		{
+			m_distances[ i * count + landmark ] = m_flood[ i ];
+			if( m_flood[ i ] >= 0 && ( nearest[ i ] < 0 || m_flood[ i ] < nearest[ i ] ) )
+				nearest[ i ] = m_flood[ i ];
+		}
+	}
+
+	return true;
+}
+
+//------------------------------------------------------------------------------
+// Name: SetGoals()
+// Desc: Looks up the goals' distances once, ready for Estimate()
+//------------------------------------------------------------------------------
+void Landmarks::SetGoals( const Grid& grid, const int* pGoalCells, const int numGoals )
+{
+	const size_t numLandmarks = m_cells.size();
+	m_goalDistances.resize( numGoals * numLandmarks );
+	m_goalWeights.resize( numGoals );
+	for( int goal = 0; goal < numGoals; ++goal )
+	{
+		const int cell = pGoalCells[ goal ];
+		for( size_t i = 0; i < numLandmarks; ++i )
+			m_goalDistances[ goal * numLandmarks + i ] = GetDistance( int( i ), cell );
+
+		m_goalWeights[ goal ] = grid.GetWeight( grid.GetCellX( cell ), grid.GetCellY( cell ) );
+	}
+}
+
+//------------------------------------------------------------------------------
+// Name: Estimate()
+// Desc: Returns a lower bound on the cost from a cell to the nearest goal.
+//		 Costs are paid on entering a cell, so a route run backwards costs the
+//		 same bar swapping the weights of its two ends, which the second bound
+//		 allows for
+//------------------------------------------------------------------------------
+int Landmarks::Estimate( const Grid& grid, const int cell ) const
+{
+	const int* pDistances = &m_distances[ cell * m_count ];
+	const int weight = grid.GetWeight( grid.GetCellX( cell ), grid.GetCellY( cell ) );
+	const size_t numLandmarks = m_cells.size();
+
+	int nearest = -1;
+	for( size_t goal = 0; goal < m_goalWeights.size(); ++goal )
+	{
+		const int* pGoalDistances = &m_goalDistances[ goal * numLandmarks ];
+
+		int best = 0;
+		for( size_t i = 0; i < numLandmarks; ++i )
+		{
+			const int toCell = pDistances[ i ];
+			const int toGoal = pGoalDistances[ i ];
+			if( toCell < 0 || toGoal < 0 )
+				continue;
+
+			//landmark -> cell -> goal can be no shorter than landmark -> goal
+			const int ahead = toGoal - toCell;
+			if( ahead > best )
+				best = ahead;
+
+			//likewise cell -> goal -> landmark against cell -> landmark
+			const int behind = toCell - toGoal - weight + m_goalWeights[ goal ];
+			if( behind > best )
+				best = behind;
+		}
+
+		if( nearest < 0 || best < nearest )
+			nearest = best;
+	}
+
+	return ( nearest > 0 ) ? nearest : 0;
+}
+
+//------------------------------------------------------------------------------
+// Name: Flood()
+// Desc: Dijkstra search from a cell over the whole grid, leaving the costs in
+//		 the workspace with -1 for cells that can't be reached
+//------------------------------------------------------------------------------
+void Landmarks::Flood( const Grid& grid, const int fromCell )
+{
+	m_flood.assign( grid.GetNumCells(), -1 );
+	m_flood[ fromCell ] = 0;
+	m_queue.Push( fromCell, 0 );
+
+	const int offsetX[ 4 ] = { 0, 1, 0, -1 };
+	const int offsetY[ 4 ] = { -1, 0, 1, 0 };
+
+	while( ! m_queue.IsEmpty() )
+	{
+		const int cell = m_queue.Pop();
+		const int cellX = grid.GetCellX( cell );
+		const int cellY = grid.GetCellY( cell );
+
+		for( int i = 0; i < 4; ++i )
+		{
+			const int x = cellX + offsetX[ i ];
+			const int y = cellY + offsetY[ i ];
+			if( ! grid.IsPath( x, y ) )
+				continue;
+
+			const int next = grid.GetCellIndex( x, y );
+			const int cost = m_flood[ cell ] + grid.GetWeight( x, y );
+			if( m_flood[ next ] >= 0 && m_flood[ next ] <= cost )
+				continue;
+
+			m_flood[ next ] = cost;
+			m_queue.Push( next, cost );
+		}
+	}
+}
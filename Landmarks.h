@@ -0,0 +1,84 @@
+//------------------------------------------------------------------------------
+// File: Landmarks.h
+// Desc: Landmark distance tables for the ALT search heuristic
+//
+// Created: 19 October 2026 18:57:02
+//
+// (c)2002 Neil Wakefield
+//------------------------------------------------------------------------------
+
+
+#ifndef INCLUSIONGUARD_LANDMARKS_H
+#define INCLUSIONGUARD_LANDMARKS_H
+
+
+//------------------------------------------------------------------------------
+// Included files:
+//------------------------------------------------------------------------------
+#include "BucketQueue.h"
+#include "MemoryTracker.h"
+#include "Types.h"
+
+#include <vector>
+using namespace std;
+
+
+//------------------------------------------------------------------------------
+// Prototypes and declarations:
+//------------------------------------------------------------------------------
+class Grid;
+
+//------------------------------------------------------------------------------
+// Name: class Landmarks
+// Desc: Distances from a few landmark cells to every cell of a grid. By the
+//		 triangle inequality the difference between two cells' distances to a
+//		 landmark is a lower bound on the distance between them, which in a
+//		 maze is far tighter than the Manhattan distance. Landmarks are chosen
+//		 spread out, each as far as possible from those already picked. The
+//		 tables are rebuilt only when the grid's hash changes
+//------------------------------------------------------------------------------
+class Landmarks
+{
+
+public:
+	Landmarks();
+
+	bool Update( const Grid& grid, const int count );
+	void Invalidate() { m_valid = false; }
+
+	int GetNumLandmarks() const { return int( m_cells.size() ); }
+	size_t GetNumBytes() const { return m_distances.size() * sizeof( int ); }
+	int GetLandmark( const int index ) const { return m_cells[ index ]; }
+	int GetDistance( const int landmark, const int cell ) const
+	{
+		return m_distances[ cell * m_count + landmark ];
+	}
+
+	void SetGoals( const Grid& grid, const int* pGoalCells, const int numGoals );
+	int Estimate( const Grid& grid, const int cell ) const;
+
+private:
+	bool m_valid;
+	uint64 m_hash;
+	int m_width;
+	int m_height;
+	int m_count;
+
+	typedef TrackedVector< int, MemoryTracker::SUBSYSTEM_SOLVER >::Type SolverInts;
+
+	SolverInts m_cells;
+	SolverInts m_distances;		//m_count per cell, -1 if unreachable
+
+	SolverInts m_goalDistances;	//one set per goal
+	SolverInts m_goalWeights;
+
+	//workspace for building the tables
+	BucketQueue m_queue;
+	SolverInts m_flood;
+
+	void Flood( const Grid& grid, const int fromCell );
+
+};
+
+
+#endif //INCLUSIONGUARD_LANDMARKS_H
@@ -0,0 +1,399 @@
+//------------------------------------------------------------------------------
+// File: MazeAPI.cpp
+// Desc: C interface to the maze generator and solvers
+//
+// Created: 20 October 2026 00:58:09
+//
+// (c)2002 Neil Wakefield
+//------------------------------------------------------------------------------
+
+
+//------------------------------------------------------------------------------
+// Included files:
+//------------------------------------------------------------------------------
+#include "MazeAPI.h"
+#include "Grid.h"
+
+#include <new>
+
+
+//------------------------------------------------------------------------------
+// Globals:
+//------------------------------------------------------------------------------
+
+//the C enumerations must line up with Grid's, as values are cast across
+typedef char TileValuesMatch[ ( MAZE_TILE_GOAL == int( Grid::TILE_GOAL ) &&
+								MAZE_TILE_WALL == int( Grid::TILE_WALL ) ) ? 1 : -1 ];
+typedef char SolverValuesMatch[ ( MAZE_SOLVER_PARALLEL == int( Grid::SOLVER_PARALLEL ) &&
+								  MAZE_SOLVER_HIERARCHICAL == int( Grid::SOLVER_HIERARCHICAL ) ) ? 1 : -1 ];
+typedef char HeuristicValuesMatch[ ( MAZE_HEURISTIC_LANDMARKS == int( Grid::HEURISTIC_ALT ) ) ? 1 : -1 ];
+
+//------------------------------------------------------------------------------
+// Name: struct MazeHandle
+// Desc: What a C caller's handle points to
+//------------------------------------------------------------------------------
+struct MazeHandle
+{
+	MazeHandle( const int width, const int height ) : grid( width, height ), generated( false ) {}
+
+	Grid grid;
+	bool generated;
+};
+
+namespace
+{
+	const int g_maxSize = 1 << 15;	//keeps every cell count within an int
+
+	//--------------------------------------------------------------------------
+	// Name: CheckBuffer()
+	// Desc: Reports the count needed and whether a buffer can take it
+	//--------------------------------------------------------------------------
+	MazeResult CheckBuffer( const void* pBuffer, const size_t capacity, const size_t count,
+							size_t* pCount )
+	{
+		if( pCount == NULL )
+			return MAZE_ERROR_INVALID_ARGUMENT;
+
+		*pCount = count;
+		if( pBuffer == NULL && 0 == capacity )
+			return MAZE_OK;
+		if( pBuffer == NULL || capacity < count )
+			return MAZE_ERROR_BUFFER_TOO_SMALL;
+
+		return MAZE_OK;
+	}
+}
+
+
+//------------------------------------------------------------------------------
+// Definitions:
+//
+// No exception may cross into C, so anything that could throw is wrapped
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Name: MazeGetVersion()
+// Desc: Returns the MAZE_API_VERSION the library was built with
+//------------------------------------------------------------------------------
+int MazeGetVersion()
+{
+	return MAZE_API_VERSION;
+}
+
+//------------------------------------------------------------------------------
+// Name: MazeGetResultString()
+// Desc: Describes a result code
+//------------------------------------------------------------------------------
+const char* MazeGetResultString( const MazeResult result )
+{
+	switch( result )
+	{
+	case MAZE_OK:						return "ok";
+	case MAZE_ERROR_INVALID_ARGUMENT:	return "invalid argument";
+	case MAZE_ERROR_BUFFER_TOO_SMALL:	return "buffer too small";
+	case MAZE_ERROR_NOT_GENERATED:		return "no maze generated";
+	case MAZE_ERROR_NO_SOLUTION:		return "no solution";
+	case MAZE_ERROR_OUT_OF_MEMORY:		return "out of memory";
+	case MAZE_ERROR_INTERNAL:			return "internal error";
+	}
+
+	return "unknown result";
+}
+
+//------------------------------------------------------------------------------
+// Name: MazeCreate()
+// Desc: Makes a handle for a maze of the given size, all wall until generated
+//------------------------------------------------------------------------------
+MazeResult MazeCreate( const int width, const int height, MazeHandle** ppMaze )
+{
+	if( ppMaze == NULL )
+		return MAZE_ERROR_INVALID_ARGUMENT;
+	*ppMaze = NULL;
+
+	if( width < 2 || width > g_maxSize || height < 2 || height > g_maxSize )
+		return MAZE_ERROR_INVALID_ARGUMENT;
+
+	try
+	{
+		*ppMaze = new MazeHandle( width, height );
+	}
+	catch( const std::bad_alloc& )
+	{
+		return MAZE_ERROR_OUT_OF_MEMORY;
+	}
+	catch( ... )
+	{
+		return MAZE_ERROR_INTERNAL;
+	}
+
+	return MAZE_OK;
+}
+
+//------------------------------------------------------------------------------
+// Name: MazeDestroy()
+// Desc: Frees a handle and everything it holds
+//------------------------------------------------------------------------------
+void MazeDestroy( MazeHandle* pMaze )
+{
+	delete pMaze;
+}
+
+//------------------------------------------------------------------------------
+// Name: MazeSetNumExits()
+// Desc: Sets how many exits the next maze has
+//------------------------------------------------------------------------------
+MazeResult MazeSetNumExits( MazeHandle* pMaze, const int numExits )
+{
+	if( pMaze == NULL || numExits < 1 )
+		return MAZE_ERROR_INVALID_ARGUMENT;
+
+	pMaze->grid.SetNumExits( numExits );
+	return MAZE_OK;
+}
+
+//------------------------------------------------------------------------------
+// Name: MazeSetBraidFactor()
+// Desc: Sets the fraction of dead ends the next maze opens into loops
+//------------------------------------------------------------------------------
+MazeResult MazeSetBraidFactor( MazeHandle* pMaze, const float factor )
+{
+	if( pMaze == NULL || ! ( factor >= 0.0f && factor <= 1.0f ) )
+		return MAZE_ERROR_INVALID_ARGUMENT;
+
+	pMaze->grid.SetBraidFactor( factor );
+	return MAZE_OK;
+}
+
+//------------------------------------------------------------------------------
+// Name: MazeSetSolver()
+// Desc: Chooses the search MazeSolve runs
+//------------------------------------------------------------------------------
+MazeResult MazeSetSolver( MazeHandle* pMaze, const MazeSolver solver )
+{
+	if( pMaze == NULL || solver < MAZE_SOLVER_ASTAR || solver > MAZE_SOLVER_PARALLEL )
+		return MAZE_ERROR_INVALID_ARGUMENT;
+
+	pMaze->grid.SetSolver( Grid::Solver( solver ) );
+	return MAZE_OK;
+}
+
+//------------------------------------------------------------------------------
+// Name: MazeSetHeuristic()
+// Desc: Chooses the lower bound the searches use
+//------------------------------------------------------------------------------
+MazeResult MazeSetHeuristic( MazeHandle* pMaze, const MazeHeuristic heuristic )
+{
+	if( pMaze == NULL || heuristic < MAZE_HEURISTIC_MANHATTAN || heuristic > MAZE_HEURISTIC_LANDMARKS )
+		return MAZE_ERROR_INVALID_ARGUMENT;
+
+	pMaze->grid.SetHeuristic( Grid::Heuristic( heuristic ) );
+	return MAZE_OK;
+}
+
+//------------------------------------------------------------------------------
+// Name: MazeSetNumThreads()
+// Desc: Sets how many threads MAZE_SOLVER_PARALLEL may use
+//------------------------------------------------------------------------------
+MazeResult MazeSetNumThreads( MazeHandle* pMaze, const int numThreads )
+{
+	if( pMaze == NULL || numThreads < 1 )
+		return MAZE_ERROR_INVALID_ARGUMENT;
+
+	pMaze->grid.SetNumThreads( numThreads );
+	return MAZE_OK;
+}
+
+//------------------------------------------------------------------------------
+// Name: MazeSetPathSmoothing()
+// Desc: Turns straight-run smoothing of the path on or off
+//------------------------------------------------------------------------------
+MazeResult MazeSetPathSmoothing( MazeHandle* pMaze, const int smoothing )
+{
+	if( pMaze == NULL )
+		return MAZE_ERROR_INVALID_ARGUMENT;
+
+	pMaze->grid.SetPathSmoothing( 0 != smoothing );
+	return MAZE_OK;
+}
+
+//------------------------------------------------------------------------------
+// Name: MazeGenerate()
+// Desc: Builds a new maze from a seed, dropping any solution
+//------------------------------------------------------------------------------
+MazeResult MazeGenerate( MazeHandle* pMaze, const unsigned int seed )
+{
+	if( pMaze == NULL )
+		return MAZE_ERROR_INVALID_ARGUMENT;
+
+	try
+	{
+		pMaze->generated = false;
+		pMaze->grid.GenerateMaze( seed );
+		pMaze->generated = true;
+	}
+	catch( const std::bad_alloc& )
+	{
+		return MAZE_ERROR_OUT_OF_MEMORY;
+	}
+	catch( ... )
+	{
+		return MAZE_ERROR_INTERNAL;
+	}
+
+	return MAZE_OK;
+}
+
+//------------------------------------------------------------------------------
+// Name: MazeSolve()
+// Desc: Finds the path to the nearest exit with the chosen solver
+//------------------------------------------------------------------------------
+MazeResult MazeSolve( MazeHandle* pMaze )
+{
+	if( pMaze == NULL )
+		return MAZE_ERROR_INVALID_ARGUMENT;
+	if( ! pMaze->generated )
+		return MAZE_ERROR_NOT_GENERATED;
+
+	try
+	{
+		pMaze->grid.GenerateSolution();
+	}
+	catch( const std::bad_alloc& )
+	{
+		return MAZE_ERROR_OUT_OF_MEMORY;
+	}
+	catch( ... )
+	{
+		return MAZE_ERROR_INTERNAL;
+	}
+
+	return pMaze->grid.GetSolution().empty() ? MAZE_ERROR_NO_SOLUTION : MAZE_OK;
+}
+
+//------------------------------------------------------------------------------
+// Name: MazeGetSize()
+// Desc: Returns the width and height the handle was made with
+//------------------------------------------------------------------------------
+MazeResult MazeGetSize( const MazeHandle* pMaze, int* pWidth, int* pHeight )
+{
+	if( pMaze == NULL || pWidth == NULL || pHeight == NULL )
+		return MAZE_ERROR_INVALID_ARGUMENT;
+
+	*pWidth = pMaze->grid.GetWidth();
+	*pHeight = pMaze->grid.GetHeight();
+	return MAZE_OK;
+}
+
+//------------------------------------------------------------------------------
+// Name: MazeGetStart()
+// Desc: Returns the entrance square, in the left hand column
+//------------------------------------------------------------------------------
+MazeResult MazeGetStart( const MazeHandle* pMaze, MazePoint* pStart )
+{
+	if( pMaze == NULL || pStart == NULL )
+		return MAZE_ERROR_INVALID_ARGUMENT;
+	if( ! pMaze->generated )
+		return MAZE_ERROR_NOT_GENERATED;
+
+	pStart->x = 0;
+	pStart->y = pMaze->grid.GetStartY();
+	return MAZE_OK;
+}
+
+//------------------------------------------------------------------------------
+// Name: MazeGetTiles()
+// Desc: Copies out every tile, row by row
+//------------------------------------------------------------------------------
+MazeResult MazeGetTiles( const MazeHandle* pMaze, unsigned char* pTiles, const size_t capacity,
+						 size_t* pCount )
+{
+	if( pMaze == NULL )
+		return MAZE_ERROR_INVALID_ARGUMENT;
+
+	const Grid& grid = pMaze->grid;
+	const int width = grid.GetWidth();
+	const int height = grid.GetHeight();
+	const MazeResult result = CheckBuffer( pTiles, capacity, size_t( width ) * height, pCount );
+	if( MAZE_OK != result || pTiles == NULL )
+		return result;
+
+	for( int y = 0; y < height; ++y )
+		for( int x = 0; x < width; ++x )
+			*pTiles++ = (unsigned char)( grid.GetTile( x, y ) );
+
+	return MAZE_OK;
+}
+
+//------------------------------------------------------------------------------
+// Name: MazeGetExits()
+// Desc: Copies out the exit squares, in the order MazeGetSolution numbers them
+//------------------------------------------------------------------------------
+MazeResult MazeGetExits( const MazeHandle* pMaze, MazePoint* pExits, const size_t capacity,
+						 size_t* pCount )
+{
+	if( pMaze == NULL )
+		return MAZE_ERROR_INVALID_ARGUMENT;
+	if( ! pMaze->generated )
+		return MAZE_ERROR_NOT_GENERATED;
+
+	const Grid& grid = pMaze->grid;
+	const MazeResult result = CheckBuffer( pExits, capacity, grid.GetNumExits(), pCount );
+	if( MAZE_OK != result || pExits == NULL )
+		return result;
+
+	for( int i = 0; i < grid.GetNumExits(); ++i )
+	{
+		const MazeSquare exit = grid.GetExit( i );
+		pExits[ i ].x = exit.x;
+		pExits[ i ].y = exit.y;
+	}
+
+	return MAZE_OK;
+}
+
+//------------------------------------------------------------------------------
+// Name: MazeGetPath()
+// Desc: Copies out the last solution found
+//------------------------------------------------------------------------------
+MazeResult MazeGetPath( const MazeHandle* pMaze, MazePoint* pPoints, const size_t capacity,
+						size_t* pCount )
+{
+	if( pMaze == NULL )
+		return MAZE_ERROR_INVALID_ARGUMENT;
+
+	const SquareVector& solution = pMaze->grid.GetSolution();
+	if( solution.empty() )
+	{
+		if( pCount != NULL )
+			*pCount = 0;
+		return MAZE_ERROR_NO_SOLUTION;
+	}
+
+	const MazeResult result = CheckBuffer( pPoints, capacity, solution.size(), pCount );
+	if( MAZE_OK != result || pPoints == NULL )
+		return result;
+
+	for( size_t i = 0; i < solution.size(); ++i )
+	{
+		pPoints[ i ].x = solution[ i ].x;
+		pPoints[ i ].y = solution[ i ].y;
+	}
+
+	return MAZE_OK;
+}
+
+//------------------------------------------------------------------------------
+// Name: MazeGetSolution()
+// Desc: Returns the cost of the last solution and the exit it leads to
+//------------------------------------------------------------------------------
+MazeResult MazeGetSolution( const MazeHandle* pMaze, int* pCost, int* pExit )
+{
+	if( pMaze == NULL || pCost == NULL || pExit == NULL )
+		return MAZE_ERROR_INVALID_ARGUMENT;
+	if( pMaze->grid.GetSolution().empty() )
+		return MAZE_ERROR_NO_SOLUTION;
+
+	*pCost = pMaze->grid.GetSolutionCost();
+	*pExit = pMaze->grid.GetChosenExit();
+	return MAZE_OK;
+}
@@ -0,0 +1,132 @@
+/*------------------------------------------------------------------------------
+// File: MazeAPI.h
+// Desc: C interface to the maze generator and solvers
+//
+// Created: 20 October 2026 00:42:17
+//
+// (c)2002 Neil Wakefield
+//----------------------------------------------------------------------------*/
+
+
+#ifndef INCLUSIONGUARD_MAZEAPI_H
+#define INCLUSIONGUARD_MAZEAPI_H
+
+
+/*------------------------------------------------------------------------------
+// Included files:
+//----------------------------------------------------------------------------*/
+#include <stddef.h>
+
+
+/*------------------------------------------------------------------------------
+// Definitions:
+//
+// Build the library with MAZE_EXPORTS defined, and define MAZE_STATIC on both
+// sides to link it statically instead
+//----------------------------------------------------------------------------*/
+#if defined( MAZE_STATIC )
+#define MAZE_API
+#elif defined( WIN32 ) || defined( _WIN32 )
+#ifdef MAZE_EXPORTS
+#define MAZE_API __declspec( dllexport )
+#else
+#define MAZE_API __declspec( dllimport )
+#endif
+#elif defined( __GNUC__ )
+#define MAZE_API __attribute__( ( visibility( "default" ) ) )
+#else
+#define MAZE_API
+#endif
+
+/* bumped whenever a declaration here changes */
+#define MAZE_API_VERSION 1
+
+
+/*------------------------------------------------------------------------------
+// Prototypes and declarations:
+//
+// Every call takes a handle from MazeCreate and returns a MazeResult. Handles
+// share nothing, so different threads may use different handles at once, but
+// one handle must only be used by one thread at a time.
+//
+// Calls that fill a buffer take its capacity in elements and always write the
+// number of elements needed to *pCount. Pass NULL and 0 to ask for the count
+// alone, then call again with a buffer at least that big. A buffer that is
+// too small gets nothing written to it. Reading the maze or path never
+// allocates, and generating or solving again reuses the handle's memory
+// unless the maze or path is bigger than any before
+//----------------------------------------------------------------------------*/
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct MazeHandle MazeHandle;
+
+typedef enum MazeResult
+{
+	MAZE_OK = 0,
+	MAZE_ERROR_INVALID_ARGUMENT,
+	MAZE_ERROR_BUFFER_TOO_SMALL,
+	MAZE_ERROR_NOT_GENERATED,		/* no maze has been generated yet */
+	MAZE_ERROR_NO_SOLUTION,			/* not solved yet, or no path exists */
+	MAZE_ERROR_OUT_OF_MEMORY,
+	MAZE_ERROR_INTERNAL
+} MazeResult;
+
+/* these match Grid's enumerations */
+typedef enum MazeTile { MAZE_TILE_PATH, MAZE_TILE_WALL, MAZE_TILE_START, MAZE_TILE_GOAL } MazeTile;
+typedef enum MazeSolver
+{
+	MAZE_SOLVER_ASTAR,
+	MAZE_SOLVER_HIERARCHICAL,
+	MAZE_SOLVER_MEMORY_BOUNDED,
+	MAZE_SOLVER_PARALLEL
+} MazeSolver;
+typedef enum MazeHeuristic { MAZE_HEURISTIC_MANHATTAN, MAZE_HEURISTIC_LANDMARKS } MazeHeuristic;
+
+typedef struct MazePoint
+{
+	int x;
+	int y;
+} MazePoint;
+
+MAZE_API int MazeGetVersion( void );
+MAZE_API const char* MazeGetResultString( MazeResult result );
+
+MAZE_API MazeResult MazeCreate( int width, int height, MazeHandle** ppMaze );
+MAZE_API void MazeDestroy( MazeHandle* pMaze );
+
+/* settings used by the next MazeGenerate */
+MAZE_API MazeResult MazeSetNumExits( MazeHandle* pMaze, int numExits );
+MAZE_API MazeResult MazeSetBraidFactor( MazeHandle* pMaze, float factor );
+
+/* settings used by the next MazeSolve */
+MAZE_API MazeResult MazeSetSolver( MazeHandle* pMaze, MazeSolver solver );
+MAZE_API MazeResult MazeSetHeuristic( MazeHandle* pMaze, MazeHeuristic heuristic );
+MAZE_API MazeResult MazeSetNumThreads( MazeHandle* pMaze, int numThreads );
+MAZE_API MazeResult MazeSetPathSmoothing( MazeHandle* pMaze, int smoothing );
+
+MAZE_API MazeResult MazeGenerate( MazeHandle* pMaze, unsigned int seed );
+MAZE_API MazeResult MazeSolve( MazeHandle* pMaze );
+
+MAZE_API MazeResult MazeGetSize( const MazeHandle* pMaze, int* pWidth, int* pHeight );
+MAZE_API MazeResult MazeGetStart( const MazeHandle* pMaze, MazePoint* pStart );
+
+/* one MazeTile per cell, row by row from y = 0 */
+MAZE_API MazeResult MazeGetTiles( const MazeHandle* pMaze, unsigned char* pTiles,
+								  size_t capacity, size_t* pCount );
+MAZE_API MazeResult MazeGetExits( const MazeHandle* pMaze, MazePoint* pExits,
+								  size_t capacity, size_t* pCount );
+
+/* the path runs from just outside the entrance to just outside the chosen
+   exit - single steps, or straight runs if smoothing is on */
+MAZE_API MazeResult MazeGetPath( const MazeHandle* pMaze, MazePoint* pPoints,
+								 size_t capacity, size_t* pCount );
+MAZE_API MazeResult MazeGetSolution( const MazeHandle* pMaze, int* pCost, int* pExit );
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif /* INCLUSIONGUARD_MAZEAPI_H */
@@ -0,0 +1,353 @@
+//------------------------------------------------------------------------------
+// File: MazeAlgorithms.h
+// Desc: Maze generation and A* search shared by Grid and FixedGrid
+//
+// Created: 19 October 2026 21:46:12
+//
+// (c)2002 Neil Wakefield
+//------------------------------------------------------------------------------
+
+
+#ifndef INCLUSIONGUARD_MAZEALGORITHMS_H
+#define INCLUSIONGUARD_MAZEALGORITHMS_H
+
+
+//------------------------------------------------------------------------------
+// Included files:
+//------------------------------------------------------------------------------
+#include "BucketQueue.h"
+#include "Grid.h"
+#include "GridStats.h"
+#include "MazeTrace.h"
+#include "Random.h"
+
+#include <stdlib.h>
+
+
+//------------------------------------------------------------------------------
+// Prototypes and declarations:
+//
+// These are templates on the grid type so that FixedGrid's compile-time
+// sizes reach the inner loops. The grid must provide GetWidth, GetHeight,
+// GetTile, SetTile, GetWeight, IsPath, GetCellIndex, GetCellX and GetCellY
+// as Grid does
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Name: struct ManhattanHeuristic
+// Desc: Lower bound on the cost to the nearest of several goals from the grid
+//		 distance alone
+//------------------------------------------------------------------------------
+struct ManhattanHeuristic
+{
+	ManhattanHeuristic( const MazeSquare* pNewGoals, const int newNumGoals )
+		: pGoals( pNewGoals ), numGoals( newNumGoals ) {}
+
+	int operator()( const int x, const int y ) const
+	{
+		int best = abs( pGoals[ 0 ].x - x ) + abs( pGoals[ 0 ].y - y );
+		for( int i = 1; i < numGoals; ++i )
+		{
+			const int distance = abs( pGoals[ i ].x - x ) + abs( pGoals[ i ].y - y );
+			if( distance < best )
+				best = distance;
+		}
+
+		return Grid::MIN_WEIGHT * best;
+	}
+
+	const MazeSquare* pGoals;
+	int numGoals;
+};
+
+//------------------------------------------------------------------------------
+// Name: MazeCanPlacePath()
+// Desc: Checks to see if a wall square can be turned into path without
+//		 joining two paths together or making an ugly diagonal
+//------------------------------------------------------------------------------
+template< class GridType >
+bool MazeCanPlacePath( const GridType& grid, const int x, const int y )
+{
+	//make sure the square is inside the bounds of the grid
+	if( ( x < 0 ) || ( x >= grid.GetWidth() ) ||
+		( y < 0 ) || ( y >= grid.GetHeight() ) )
+		return false;
+
+	//check to see if this square is already a path
+	if( Grid::TILE_WALL != grid.GetTile( x, y ) )
+		return false;
+
+	//check to see if this square would cause a loop
+	// this would happen if the square was touching two or more path squares
+	bool foundOneSquare = false;
+
+	//track paths found - we need these to constrain diagonals
+	bool foundLeft = false;
+	bool foundRight = false;
+	bool foundUp = false;
+	bool foundDown = false;
+
+	bool minX = ( x <= 0 );
+	bool maxX = ( x >= ( grid.GetWidth() - 1 ) );
+	bool minY = ( y <= 0 );
+	bool maxY = ( y >= ( grid.GetHeight() - 1 ) );
+
+	//up
+	if( !minY )
+		if( Grid::TILE_WALL != grid.GetTile( x, y - 1 ) )
+		{
+			foundOneSquare = true;
+			foundUp = true;
+		}
+
+	//right
+	if( !maxX )
+		if( Grid::TILE_WALL != grid.GetTile( x + 1, y ) )
+		{
+			if( foundOneSquare )
+				return false;
+			else
+			{
+				foundOneSquare = true;
+				foundRight = true;
+			}
+		}
+
+	//down
+	if( !maxY )
+		if( Grid::TILE_WALL != grid.GetTile( x, y + 1 ) )
+		{
+			if( foundOneSquare )
+				return false;
+			else
+			{
+				foundOneSquare = true;
+				foundDown = true;
+			}
+		}
+
+	//left
+	if( !minX )
+		if( Grid::TILE_WALL != grid.GetTile( x - 1, y ) )
+		{
+			if( foundOneSquare )
+				return false;
+			else
+			{
+				foundOneSquare = true;
+				foundLeft = true;
+			}
+		}
+
+	//add some constraints to creating diagonals as this results in ugly mazes
+	//upper-left
+	if( !minY && !minX )
+		if( Grid::TILE_WALL != grid.GetTile( x - 1, y - 1 ) )
+		{
+			if( ! foundLeft && ! foundUp )
+				return false;
+			else
+				foundOneSquare = true;
+		}
+
+	//upper-right
+	if( !minY && !maxX )
+		if( Grid::TILE_WALL != grid.GetTile( x + 1, y - 1 ) )
+		{
+			if( ! foundRight && ! foundUp )
+				return false;
+			else
+				foundOneSquare = true;
+		}
+
+	//lower-right
+	if( !maxY && !maxX )
+		if( Grid::TILE_WALL != grid.GetTile( x + 1, y + 1 ) )
+		{
+			if( ! foundRight && ! foundDown )
+				return false;
+			else
+				foundOneSquare = true;
+		}
+
+	//lower-left
+	if( !minX && !maxY )
+		if( Grid::TILE_WALL != grid.GetTile( x - 1, y + 1 ) )
+		{
+			if( ! foundLeft && ! foundDown )
+				return false;
+			else
+				foundOneSquare = true;
+		}
+
+	//must be a valid place to put a path
+	return true;
+}
+
+//------------------------------------------------------------------------------
+// Name: MazeGrow()
+// Desc: Grows a perfect maze out from a random square in the left hand column
+//		 of a grid already filled with walls. path holds the squares that may
+//		 still be grown from, and needs room for every cell of the grid. It
+//		 needs begin(), size(), push_back() and erase() as vector has. The
+//		 goal is the first square grown into the right hand column. Each
+//		 step is recorded into pTrace if there is one
+//------------------------------------------------------------------------------
+template< class GridType, class SquareList >
+void MazeGrow( GridType& grid, Random& random, SquareList& path,
+			   int& startY, int& goalY, GridStats& stats, MazeTrace* pTrace = NULL )
+{
+	//offsets for each move, in the order of Grid::Direction
+	static const int moveX[ 4 ] = { 0, 1, 0, -1 };
+	static const int moveY[ 4 ] = { 1, 0, -1, 0 };
+
+	bool foundExit = false; //have we found an exit
+
+	//pick a random starting point in the left hand column
+	startY = int( random.Next( grid.GetHeight() ) );
+	GRID_STAT_INC( stats, randomDraws );
+	grid.SetTile( 0, startY, Grid::TILE_START );
+	if( pTrace != NULL )
+		pTrace->RecordStart( startY );
+
+	//record this square
+	path.push_back( MazeSquare( 0, startY ) );
+
+	//now grow the paths from here
+	while( path.size() > 0 )
+	{
+		//take a random square from the path list
+		const int index = int( random.Next( (unsigned int)( path.size() ) ) );
+		typename SquareList::iterator currentSquare = path.begin() + index;
+		GRID_STAT_INC( stats, randomDraws );
+
+		const MazeSquare square = *currentSquare;
+
+		//pick a random direction to move in from this square, then try the
+		// others in turn
+		const int firstDirection = int( random.Next( 4 ) );
+		GRID_STAT_INC( stats, randomDraws );
+
+		int x = 0;
+		int y = 0;
+		bool placed = false;
+		int i = 0;
+		for( ; i < 4 && ! placed; ++i )
+		{
+			const int d = ( firstDirection + i ) % 4;
+			x = square.x + moveX[ d ];
+			y = square.y + moveY[ d ];
+
+			placed = MazeCanPlacePath( grid, x, y );
+			if( ! placed )
+				GRID_STAT_INC( stats, placementsRejected );
+		}
+
+		//the loop has gone one past the direction taken, or through all four
+		if( pTrace != NULL )
+			pTrace->RecordStep( index, firstDirection, placed ? i - 1 : MazeTrace::OUTCOME_ERASED );
+
+		if( ! placed )
+		{
+			//all four directions tried, so this path is useless
+			//remove it from the places-to-try list
+			path.erase( currentSquare );
+			GRID_STAT_INC( stats, frontierErasures );
+			continue;
+		}
+
+		//if we get this far, x,y should contain the location of the next square
+		// to add to the path
+		grid.SetTile( x, y, Grid::TILE_PATH );
+		path.push_back( MazeSquare( x, y ) );
+
+		//see if this path is a valid exit, if we haven't already found one
+		if( x == ( grid.GetWidth() - 1 ) && ! foundExit )
+		{
+			grid.SetTile( x, y, Grid::TILE_GOAL );
+			goalY = y;
+
+			//the maze is complete, but continue until all possible squares have
+			// been used so we don't end up with large areas of wall
+			foundExit = true;
+		}
+	}
+}
+
+//------------------------------------------------------------------------------
+// Name: MazeFindPath()
+// Desc: A* search from a cell to the nearest of several goal cells, ending as
+//		 soon as any goal comes off the open list. The heuristic should bound
+//		 the cost to the nearest goal. openQueue must be sized for every cell
+//		 and for steps of twice MAX_WEIGHT, as the heuristic may be a landmark
+//		 bound. Fills in pCost and pParent for every cell reached, pCost being
+//		 -1 for the rest, and returns the index of the goal reached, or -1
+//------------------------------------------------------------------------------
+template< class GridType, class Heuristic >
+int MazeFindPath( const GridType& grid, const int startCell, const int* pGoalCells,
+				  const int numGoals, const Heuristic& heuristic, BucketQueue& openQueue,
+				  int* pCost, int* pParent, GridStats& stats )
+{
+	//offsets for each move, in the order of Grid::Direction
+	static const int moveX[ 4 ] = { 0, 1, 0, -1 };
+	static const int moveY[ 4 ] = { 1, 0, -1, 0 };
+
+	const int numCells = grid.GetNumCells();
+	for( int i = 0; i < numCells; ++i )
+	{
+		pCost[ i ] = -1;
+		pParent[ i ] = -1;
+	}
+
+	pCost[ startCell ] = 0;
+	openQueue.Push( startCell, heuristic( grid.GetCellX( startCell ), grid.GetCellY( startCell ) ) );
+	GRID_STAT_INC( stats, heuristicCalls );
+	GRID_STAT_MAX( stats, peakOpenList, (unsigned int)( openQueue.GetSize() ) );
+
+	int found = -1;
+	while( ! openQueue.IsEmpty() )
+	{
+		const int cell = openQueue.Pop();
+		GRID_STAT_INC( stats, nodesExpanded );
+
+		//if the current node is one of the goals, we have finished
+		for( int i = 0; i < numGoals && found < 0; ++i )
+			if( cell == pGoalCells[ i ] )
+				found = i;
+		if( found >= 0 )
+			break;
+
+		//for all valid neighbouring nodes...
+		const int cellX = grid.GetCellX( cell );
+		const int cellY = grid.GetCellY( cell );
+		for( int i = 0; i < 4; ++i )
+		{
+			const int x = cellX + moveX[ i ];
+			const int y = cellY + moveY[ i ];
+			if( ! grid.IsPath( x, y ) )
+				continue;
+
+			//skip the neighbour unless this is a cheaper way to reach it
+			const int next = grid.GetCellIndex( x, y );
+			const int cost = pCost[ cell ] + grid.GetWeight( x, y );
+			if( pCost[ next ] >= 0 && pCost[ next ] <= cost )
+				continue;
+
+			if( pCost[ next ] >= 0 && ! openQueue.Contains( next ) )
+				GRID_STAT_INC( stats, nodesReopened );
+
+			pCost[ next ] = cost;
+			pParent[ next ] = cell;
+			openQueue.Push( next, cost + heuristic( x, y ) );
+			GRID_STAT_INC( stats, heuristicCalls );
+			GRID_STAT_MAX( stats, peakOpenList, (unsigned int)( openQueue.GetSize() ) );
+		}
+	}
+
+	openQueue.Clear();
+
+	return found;
+}
+
+
+#endif //INCLUSIONGUARD_MAZEALGORITHMS_H
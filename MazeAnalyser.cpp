@@ -0,0 +1,273 @@
+//------------------------------------------------------------------------------
+// File: MazeAnalyser.cpp
+// Desc: Shape measurements of a maze, for choosing mazes by difficulty
+//
+// Created: 20 October 2026 01:39:15
+//
+// (c)2002 Neil Wakefield
+//------------------------------------------------------------------------------
+
+
+//------------------------------------------------------------------------------
+// Included files:
+//------------------------------------------------------------------------------
+#include "MazeAnalyser.h"
+#include "Grid.h"
+
+
+//------------------------------------------------------------------------------
+// Globals:
+//------------------------------------------------------------------------------
+namespace
+{
+	//grids smaller than this are scanned on one thread, as starting the
+	// others would cost more than they save
+	const int g_parallelCells = 256 * 256;
+
+	//offsets for each move, in the order of Grid::Direction
+	const int g_moveX[ 4 ] = { 0, 1, 0, -1 };
+	const int g_moveY[ 4 ] = { 1, 0, -1, 0 };
+
+	//--------------------------------------------------------------------------
+	// Name: IsTerminal()
+	// Desc: Checks for the entrance or an exit, which open to the outside
+	//--------------------------------------------------------------------------
+	bool IsTerminal( const Grid& grid, const int x, const int y )
+	{
+		const Grid::GridTile tile = grid.GetTile( x, y );
+		return Grid::TILE_START == tile || Grid::TILE_GOAL == tile;
+	}
+}
+
+
+//------------------------------------------------------------------------------
+// Definitions:
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Name: MazeAnalyser()
+// Desc: Constructor for the analyser object
+//------------------------------------------------------------------------------
+MazeAnalyser::MazeAnalyser()
+{
+	m_numThreads = GetNumProcessors();
+}
+
+//------------------------------------------------------------------------------
+// Name: ~MazeAnalyser()
+// Desc: Destructor for the analyser object
+//------------------------------------------------------------------------------
+MazeAnalyser::~MazeAnalyser()
+{
+	for( size_t i = 0; i < m_bands.size(); ++i )
+		delete m_bands[ i ];
+}
+
+//------------------------------------------------------------------------------
+// Name: Analyse()
+// Desc: Measures a maze
+//------------------------------------------------------------------------------
+void MazeAnalyser::Analyse( const Grid& grid, MazeAnalysis& analysis )
+{
+	const int width = grid.GetWidth();
+	const int height = grid.GetHeight();
+
+	//split the rows into bands, one per thread
+	int numBands = 1;
+	if( width * height >= g_parallelCells )
+		numBands = ( m_numThreads < height ) ? m_numThreads : height;
+
+	while( int( m_bands.size() ) < numBands )
+		m_bands.push_back( new Band );
+	for( int i = 0; i < numBands; ++i )
+	{
+		Band& band = *m_bands[ i ];
+		band.pGrid = &grid;
+		band.firstRow = height * i / numBands;
+		band.endRow = height * ( i + 1 ) / numBands;
+		band.topRun.resize( width );
+		band.bottomRun.resize( width );
+	}
+
+	for( int i = 1; i < numBands; ++i )
+		if( ! m_bands[ i ]->thread.Start( ScanBand, m_bands[ i ] ) )
+			ScanBand( m_bands[ i ] );
+	ScanBand( m_bands[ 0 ] );
+	for( int i = 1; i < numBands; ++i )
+		m_bands[ i ]->thread.Join();
+
+	//add up the bands, joining vertical runs that cross from one to the next
+	analysis.numCells = width * height;
+	analysis.numPathCells = 0;
+	analysis.numDeadEnds = 0;
+	analysis.numJunctions = 0;
+	analysis.longestCorridor = 0;
+
+	int numEdges = 0;
+	int numChoices = 0;
+	vector< int >& carried = m_queue;	//free until the sweeps
+	carried.assign( width, 0 );
+	for( int i = 0; i < numBands; ++i )
+	{
+		const Band& band = *m_bands[ i ];
+		const int bandHeight = band.endRow - band.firstRow;
+
+		analysis.numPathCells += band.numPathCells;
+		analysis.numDeadEnds += band.numDeadEnds;
+		analysis.numJunctions += band.numJunctions;
+		numEdges += band.numEdges;
+		numChoices += band.numChoices;
+		if( band.longestRun > analysis.longestCorridor )
+			analysis.longestCorridor = band.longestRun;
+
+		for( int x = 0; x < width; ++x )
+		{
+			const int joined = carried[ x ] + band.topRun[ x ];
+			if( joined > analysis.longestCorridor )
+				analysis.longestCorridor = joined;
+			carried[ x ] = ( band.topRun[ x ] == bandHeight ) ? joined : band.bottomRun[ x ];
+		}
+	}
+
+	analysis.coverage = float( analysis.numPathCells ) / float( analysis.numCells );
+	analysis.branchingFactor = ( analysis.numJunctions > 0 )
+							   ? float( numChoices ) / float( analysis.numJunctions ) : 0.0f;
+
+	//sweep from the entrance for the solution, then from the far end of that
+	// sweep for the diameter
+	int furthest = -1;
+	int numReached = 0;
+	const int startCell = grid.GetCellIndex( 0, grid.GetStartY() );
+	Sweep( grid, startCell, furthest, numReached );
+
+	analysis.solutionLength = -1;
+	for( int i = 0; i < grid.GetNumExits(); ++i )
+	{
+		const MazeSquare exit = grid.GetExit( i );
+		const int distance = m_distance[ grid.GetCellIndex( exit.x, exit.y ) ];
+		if( distance >= 0 && ( analysis.solutionLength < 0 || distance < analysis.solutionLength ) )
+			analysis.solutionLength = distance;
+	}
+	analysis.solutionRatio = ( analysis.solutionLength >= 0 && analysis.numPathCells > 0 )
+							 ? float( analysis.solutionLength + 1 ) / float( analysis.numPathCells )
+							 : 0.0f;
+
+	analysis.isPerfect = ( numReached == analysis.numPathCells &&
+						   numEdges == analysis.numPathCells - 1 );
+
+	analysis.diameter = ( furthest >= 0 ) ? Sweep( grid, furthest, furthest, numReached ) : 0;
+}
+
+//------------------------------------------------------------------------------
+// Name: ScanBand()
+// Desc: Counts the cells, edges, dead ends and junctions in a band of rows,
+//		 and measures its straight runs
+//------------------------------------------------------------------------------
+void MazeAnalyser::ScanBand( void* pBand )
+{
+	Band& band = *( (Band*)( pBand ) );
+	const Grid& grid = *band.pGrid;
+	const int width = grid.GetWidth();
+
+	band.numPathCells = 0;
+	band.numEdges = 0;
+	band.numDeadEnds = 0;
+	band.numJunctions = 0;
+	band.numChoices = 0;
+	band.longestRun = 0;
+
+	//bottomRun holds the vertical run ending on the current row until the end
+	for( int x = 0; x < width; ++x )
+	{
+		band.topRun[ x ] = 0;
+		band.bottomRun[ x ] = 0;
+	}
+
+	for( int y = band.firstRow; y < band.endRow; ++y )
+	{
+		int run = 0;
+		for( int x = 0; x < width; ++x )
+		{
+			if( ! grid.IsPath( x, y ) )
+			{
+				run = 0;
+				band.bottomRun[ x ] = 0;
+				continue;
+			}
+
+			++band.numPathCells;
+
+			//count each edge once, from the cell on its left or below
+			const bool right = grid.IsPath( x + 1, y );
+			const bool up = grid.IsPath( x, y + 1 );
+			band.numEdges += ( right ? 1 : 0 ) + ( up ? 1 : 0 );
+
+			int degree = ( right ? 1 : 0 ) + ( up ? 1 : 0 ) +
+						 ( grid.IsPath( x - 1, y ) ? 1 : 0 ) + ( grid.IsPath( x, y - 1 ) ? 1 : 0 );
+			if( IsTerminal( grid, x, y ) )
+				++degree;
+
+			if( 1 == degree )
+				++band.numDeadEnds;
+			else if( degree >= 3 )
+			{
+				++band.numJunctions;
+				band.numChoices += degree - 1;
+			}
+
+			if( ++run > band.longestRun )
+				band.longestRun = run;
+
+			const int vertical = ++band.bottomRun[ x ];
+			if( vertical > band.longestRun )
+				band.longestRun = vertical;
+			if( vertical == y - band.firstRow + 1 )
+				band.topRun[ x ] = vertical;
+		}
+	}
+}
+
+//------------------------------------------------------------------------------
+// Name: Sweep()
+// Desc: Breadth-first search over the path cells from one cell, filling in
+//		 the step count to each. Returns the largest, with the cell it was
+//		 found at and the number of cells reached
+//------------------------------------------------------------------------------
+int MazeAnalyser::Sweep( const Grid& grid, const int fromCell, int& furthestCell, int& numReached )
+{
+	m_distance.assign( grid.GetNumCells(), -1 );
+	m_queue.resize( grid.GetNumCells() );
+
+	int head = 0;
+	int tail = 0;
+	m_queue[ tail++ ] = fromCell;
+	m_distance[ fromCell ] = 0;
+	furthestCell = fromCell;
+
+	while( head < tail )
+	{
+		const int cell = m_queue[ head++ ];
+		const int distance = m_distance[ cell ];
+		furthestCell = cell;	//the queue comes out in order of distance
+
+		const int cellX = grid.GetCellX( cell );
+		const int cellY = grid.GetCellY( cell );
+		for( int i = 0; i < 4; ++i )
+		{
+			const int x = cellX + g_moveX[ i ];
+			const int y = cellY + g_moveY[ i ];
+			if( ! grid.IsPath( x, y ) )
+				continue;
+
+			const int next = grid.GetCellIndex( x, y );
+			if( m_distance[ next ] >= 0 )
+				continue;
+
+			m_distance[ next ] = distance + 1;
+			m_queue[ tail++ ] = next;
+		}
+	}
+
+	numReached = tail;
+	return m_distance[ furthestCell ];
+}
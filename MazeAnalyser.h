@@ -0,0 +1,114 @@
+//------------------------------------------------------------------------------
+// File: MazeAnalyser.h
+// Desc: Shape measurements of a maze, for choosing mazes by difficulty
+//
+// Created: 20 October 2026 01:26:44
+//
+// (c)2002 Neil Wakefield
+//------------------------------------------------------------------------------
+
+
+#ifndef INCLUSIONGUARD_MAZEANALYSER_H
+#define INCLUSIONGUARD_MAZEANALYSER_H
+
+
+//------------------------------------------------------------------------------
+// Included files:
+//------------------------------------------------------------------------------
+#include "Threading.h"
+
+#include <vector>
+using namespace std;
+
+
+//------------------------------------------------------------------------------
+// Prototypes and declarations:
+//------------------------------------------------------------------------------
+class Grid;
+
+//------------------------------------------------------------------------------
+// Name: struct MazeAnalysis
+// Desc: Measurements of one maze. Lengths count single steps and ignore the
+//		 weights, and the entrance and exits count as open to the outside
+//------------------------------------------------------------------------------
+struct MazeAnalysis
+{
+	int numCells;
+	int numPathCells;
+	float coverage;				//fraction of cells that are path
+
+	int numDeadEnds;			//path cells with one way out
+	int numJunctions;			//path cells with three or four ways out
+	float branchingFactor;		//ways on from a junction, not counting the way in
+
+	int longestCorridor;		//longest straight run of path cells
+	int diameter;				//steps between the two path cells furthest apart
+	int solutionLength;			//steps from the entrance to the nearest exit, -1 if none
+	float solutionRatio;		//squares on the solution over all path cells
+
+	bool isPerfect;				//every path cell joined by exactly one route
+};
+
+//------------------------------------------------------------------------------
+// Name: class MazeAnalyser
+// Desc: Measures mazes. The counts and corridors come from a single scan of
+//		 the rows, split into bands across threads on big grids, and the
+//		 solution length and diameter from two breadth-first sweeps - the
+//		 first from the entrance, the second from the cell the first reached
+//		 last. In a perfect maze that gives the exact diameter, and in a
+//		 braided one a lower bound. The workspace is kept between calls, so
+//		 analysing a stream of mazes of one size doesn't allocate
+//------------------------------------------------------------------------------
+class MazeAnalyser
+{
+
+public:
+	MazeAnalyser();
+	~MazeAnalyser();
+
+	//threads the row scan may use, the calling thread included
+	void SetNumThreads( const int numThreads ) { m_numThreads = ( numThreads > 1 ) ? numThreads : 1; }
+	int GetNumThreads() const { return m_numThreads; }
+
+	void Analyse( const Grid& grid, MazeAnalysis& analysis );
+
+private:
+	//what one band of rows finds, with the vertical runs touching its top and
+	// bottom kept so they can be joined to the neighbouring bands
+	struct Band
+	{
+		const Grid* pGrid;
+		int firstRow;
+		int endRow;
+
+		int numPathCells;
+		int numEdges;
+		int numDeadEnds;
+		int numJunctions;
+		int numChoices;
+		int longestRun;
+
+		vector< int > topRun;		//open cells down from the first row, per column
+		vector< int > bottomRun;	//open cells up from the last row, per column
+
+		Thread thread;
+	};
+
+	int m_numThreads;
+	vector< Band* > m_bands;
+
+	//breadth-first workspace
+	vector< int > m_distance;
+	vector< int > m_queue;
+
+	static void ScanBand( void* pBand );
+	int Sweep( const Grid& grid, const int fromCell, int& furthestCell, int& numReached );
+
+	//not copyable, as the bands hold threads
+	MazeAnalyser( const MazeAnalyser& );
+	MazeAnalyser& operator=( const MazeAnalyser& );
+
+};
+
+
+#endif //INCLUSIONGUARD_MAZEANALYSER_H
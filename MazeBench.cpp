@@ -0,0 +1,271 @@
+//------------------------------------------------------------------------------
+// File: MazeBench.cpp
+// Desc: Times building and solving mazes, and reports the memory they take
+//
+// Created: 20 October 2026 07:52:33
+//
+// (c)2002 Neil Wakefield
+//------------------------------------------------------------------------------
+
+
+//------------------------------------------------------------------------------
+// Included files:
+//------------------------------------------------------------------------------
+#include "DistanceMatrix.h"
+#include "Grid.h"
+#include "MazeTrace.h"
+#include "MemoryArena.h"
+#include "MemoryTracker.h"
+#include "Random.h"
+#include "Timer.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+//------------------------------------------------------------------------------
+// Globals:
+//------------------------------------------------------------------------------
+namespace
+{
+	//in Grid::Layout order
+	const char* g_layoutNames[] = { "row", "blocked", "morton" };
+	const int NUM_LAYOUTS = sizeof( g_layoutNames ) / sizeof( g_layoutNames[ 0 ] );
+
+	//--------------------------------------------------------------------------
+	// Name: PrintUsage()
+	// Desc: Explains the command line
+	//--------------------------------------------------------------------------
+	void PrintUsage()
+	{
+		fprintf( stderr, "usage: MazeBench [-s size] [-n mazes] [-S solver] [-t threads]\n"
+						 "                 [-l row|blocked|morton] [-p points] [-r] [-a]\n" );
+	}
+}
+
+
+//------------------------------------------------------------------------------
+// Definitions:
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Name: main()
+// Desc: Entry point - builds and solves a run of mazes, each in a new Grid as
+//		 an embedding engine would, then prints the timings and memory report.
+//		 With -a the grids allocate from an arena that is reset between mazes.
+//		 With -t each maze is solved with 1, 2, 4 and so on up to that many
+//		 threads, and the speedup over one thread is printed for each. -l
+//		 picks the order the grid's cells are stored in, and -p times a
+//		 distance matrix between that many open cells picked at random. -r
+//		 generates each maze again with and without a trace attached, to
+//		 time the recording, then replays the trace
+//------------------------------------------------------------------------------
+int main( int argc, char* argv[] )
+{
+	int size = Grid::GRID_SIZE;
+	int numMazes = 20;
+	int solver = Grid::SOLVER_ASTAR;
+	int maxThreads = 0;
+	int layout = Grid::LAYOUT_ROW_MAJOR;
+	int numPoints = 0;
+	bool useTrace = false;
+	bool useArena = false;
+
+	for( int i = 1; i < argc; ++i )
+	{
+		const bool hasValue = ( i + 1 < argc );
+		if( 0 == strcmp( argv[ i ], "-s" ) && hasValue )
+			size = atoi( argv[ ++i ] );
+		else if( 0 == strcmp( argv[ i ], "-n" ) && hasValue )
+			numMazes = atoi( argv[ ++i ] );
+		else if( 0 == strcmp( argv[ i ], "-S" ) && hasValue )
+			solver = atoi( argv[ ++i ] );
+		else if( 0 == strcmp( argv[ i ], "-t" ) && hasValue )
+		{
+			maxThreads = atoi( argv[ ++i ] );
+			if( maxThreads <= 0 )
+			{
+				PrintUsage();
+				return 1;
+			}
+		}
+		else if( 0 == strcmp( argv[ i ], "-l" ) && hasValue )
+		{
+			++i;
+			layout = -1;
+			for( int l = 0; l < NUM_LAYOUTS; ++l )
+				if( 0 == strcmp( argv[ i ], g_layoutNames[ l ] ) )
+					layout = l;
+
+			if( layout < 0 )
+			{
+				PrintUsage();
+				return 1;
+			}
+		}
+		else if( 0 == strcmp( argv[ i ], "-p" ) && hasValue )
+			numPoints = atoi( argv[ ++i ] );
+		else if( 0 == strcmp( argv[ i ], "-r" ) )
+			useTrace = true;
+		else if( 0 == strcmp( argv[ i ], "-a" ) )
+			useArena = true;
+		else
+		{
+			PrintUsage();
+			return 1;
+		}
+	}
+
+	if( size < 3 || numMazes <= 0 || numPoints < 0 || solver < Grid::SOLVER_ASTAR || solver > Grid::SOLVER_PARALLEL )
+	{
+		PrintUsage();
+		return 1;
+	}
+
+	MemoryArena arena;
+	if( useArena && ! arena.Install() )
+	{
+		fprintf( stderr, "MazeBench: can't install the arena\n" );
+		return 1;
+	}
+
+	//without -t the Grid keeps its own thread count
+	vector< int > threadCounts;
+	if( maxThreads > 0 )
+	{
+		for( int threads = 1; threads < maxThreads; threads *= 2 )
+			threadCounts.push_back( threads );
+		threadCounts.push_back( maxThreads );
+	}
+	const size_t numRuns = threadCounts.empty() ? 1 : threadCounts.size();
+
+	double generateSeconds = 0.0;
+	double distanceSeconds = 0.0;
+	bool usedTree = true;
+	double untracedSeconds = 0.0;
+	double recordSeconds = 0.0;
+	double replaySeconds = 0.0;
+	double traceBytes = 0.0;
+	double traceSteps = 0.0;
+	bool replayed = true;
+	vector< double > solveSeconds( numRuns, 0.0 );
+	size_t arenaPeak = 0;
+	unsigned int totalLength = 0;
+
+	Timer total;
+	for( int i = 0; i < numMazes; ++i )
+	{
+		{
+			Grid grid( size, size, Grid::Layout( layout ) );
+			grid.SetSolver( Grid::Solver( solver ) );
+
+			Timer timer;
+			grid.GenerateMaze( i + 1 );
+			generateSeconds += timer.Lap();
+			for( size_t r = 0; r < numRuns; ++r )
+			{
+				if( ! threadCounts.empty() )
+					grid.SetNumThreads( threadCounts[ r ] );
+
+				grid.GenerateSolution();
+				solveSeconds[ r ] += timer.Lap();
+			}
+			totalLength += (unsigned int)( grid.GetSolution().size() );
+
+			if( numPoints > 0 )
+			{
+				Random random( i + 1 );
+				vector< MazeSquare > points;
+				while( int( points.size() ) < numPoints )
+				{
+					const int x = int( random.Next( (unsigned int)( size ) ) );
+					const int y = int( random.Next( (unsigned int)( size ) ) );
+					if( Grid::TILE_WALL != grid.GetTile( x, y ) )
+						points.push_back( MazeSquare( x, y ) );
+				}
+
+				timer.Start();
+				DistanceMatrix matrix;
+				matrix.Compute( grid, points );
+				distanceSeconds += timer.Lap();
+				usedTree = usedTree && matrix.GetUsedTree();
+			}
+
+			//both generations run on a grid that has held this maze already,
+			// so neither pays for first touching its memory
+			if( useTrace )
+			{
+				const uint64 hash = grid.GetHash();
+				MazeTrace trace;
+
+				timer.Start();
+				grid.GenerateMaze( i + 1 );
+				untracedSeconds += timer.Lap();
+				grid.SetTrace( &trace );
+				grid.GenerateMaze( i + 1 );
+				recordSeconds += timer.Lap();
+				grid.SetTrace( NULL );
+
+				MazeReplayer replayer( trace, grid );
+				timer.Start();
+				replayed = replayer.Seek( trace.GetNumSteps() ) && replayed;
+				replaySeconds += timer.Lap();
+				replayed = replayed && grid.GetHash() == hash;
+
+				traceBytes += double( trace.GetSize() );
+				traceSteps += double( trace.GetNumSteps() );
+			}
+		}
+
+		//the grid has gone, so everything it held can go in one step
+		if( useArena )
+		{
+			if( arena.GetNumBytesUsed() > arenaPeak )
+				arenaPeak = arena.GetNumBytesUsed();
+			arena.Reset();
+		}
+	}
+	const double totalSeconds = total.GetSeconds();
+
+	printf( "%d mazes of %dx%d, %s layout, solver %d, %s\n", numMazes, size, size,
+			g_layoutNames[ layout ], solver, useArena ? "arena" : "heap" );
+	printf( "generate %9.3f ms per maze\n", generateSeconds * 1000.0 / numMazes );
+	printf( "solve    %9.3f ms per maze\n", solveSeconds[ numRuns - 1 ] * 1000.0 / numMazes );
+	if( numPoints > 0 )
+	{
+		printf( "distance %9.3f ms per maze, %d points by %s\n", distanceSeconds * 1000.0 / numMazes,
+				numPoints, usedTree ? "tree walk" : "searches" );
+	}
+	if( useTrace )
+	{
+		printf( "record   %9.3f ms per maze, %+.1f%% on %.3f ms untraced, %.2f bytes per step\n",
+				recordSeconds * 1000.0 / numMazes, ( recordSeconds / untracedSeconds - 1.0 ) * 100.0,
+				untracedSeconds * 1000.0 / numMazes, traceBytes / traceSteps );
+		printf( "replay   %9.3f ms per maze, %.0f%% of generating%s\n", replaySeconds * 1000.0 / numMazes,
+				replaySeconds / untracedSeconds * 100.0, replayed ? "" : ", NOT THE SAME MAZE" );
+	}
+	printf( "total    %9.3f ms per maze, average solution %u squares\n",
+			totalSeconds * 1000.0 / numMazes, totalLength / numMazes );
+
+	if( numRuns > 1 )
+	{
+		printf( "\nthreads   solve ms  speedup\n" );
+		for( size_t r = 0; r < numRuns; ++r )
+		{
+			const double speedup = ( solveSeconds[ r ] > 0.0 ) ? solveSeconds[ 0 ] / solveSeconds[ r ] : 0.0;
+			printf( "%7d %10.3f %7.2fx\n", threadCounts[ r ], solveSeconds[ r ] * 1000.0 / numMazes,
+					speedup );
+		}
+	}
+
+	printf( "\n%s", MemoryTracker::GetReport().c_str() );
+
+	if( useArena )
+	{
+		printf( "arena      %.1f MB reserved, %.1f MB used at most per maze\n",
+				arena.GetNumBytesReserved() / ( 1024.0 * 1024.0 ), arenaPeak / ( 1024.0 * 1024.0 ) );
+	}
+
+	return 0;
+}
@@ -0,0 +1,870 @@
+//------------------------------------------------------------------------------
+// File: MazeCheck.cpp
+// Desc: Headless checks of the parts of the game that don't need Direct3D
+//
+// Created: 20 October 2026 09:12:06
+//
+// (c)2002 Neil Wakefield
+//------------------------------------------------------------------------------
+
+
+//------------------------------------------------------------------------------
+// Included files:
+//------------------------------------------------------------------------------
+#include "DistanceMatrix.h"
+#include "Grid.h"
+#include "Histogram.h"
+#include "MazeAnalyser.h"
+#include "MazeAlgorithms.h"
+#include "MazeTrace.h"
+#include "MazeValidator.h"
+#include "MazeWorld.h"
+#include "Random.h"
+#include "Simulation.h"
+#include "Timer.h"
+#include "WallMesh.h"
+
+#include <algorithm>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+
+//------------------------------------------------------------------------------
+// Globals:
+//------------------------------------------------------------------------------
+namespace
+{
+	int g_numFailed = 0;
+
+	//no estimate at all, so MazeFindPath is Dijkstra's search
+	struct ZeroHeuristic
+	{
+		int operator()( const int, const int ) const { return 0; }
+	};
+
+	//--------------------------------------------------------------------------
+	// Name: Check()
+	// Desc: Reports one check, remembering if it failed
+	//--------------------------------------------------------------------------
+	void Check( const bool passed, const char* pName )
+	{
+		printf( "%-4s %s\n", passed ? "ok" : "FAIL", pName );
+		if( ! passed )
+			++g_numFailed;
+	}
+
+	//--------------------------------------------------------------------------
+	// Name: Check()
+	// Desc: Reports one check made on a maze of the given size
+	//--------------------------------------------------------------------------
+	void Check( const bool passed, const char* pName, const int size )
+	{
+		char name[ 128 ];
+		sprintf( name, "%-40s %dx%d", pName, size, size );
+		Check( passed, name );
+	}
+
+	//--------------------------------------------------------------------------
+	// Name: CheckHistogram()
+	// Desc: Checks that every duration lands in the bucket whose range holds
+	//		 it, and that percentiles over a known spread of samples are no
+	//		 lower than the true value and no more than 25% above it
+	//--------------------------------------------------------------------------
+	void CheckHistogram()
+	{
+		bool placed = true;
+		int lastBucket = 0;
+		for( unsigned int us = 0; us < 1000000; us += 1 + us / 64 )
+		{
+			const int bucket = Histogram::GetBucket( us );
+			if( bucket < lastBucket || bucket >= Histogram::NUM_BUCKETS ||
+				us > Histogram::GetBucketUpperBound( bucket ) ||
+				( bucket > 0 && us <= Histogram::GetBucketUpperBound( bucket - 1 ) ) )
+				placed = false;
+			lastBucket = bucket;
+		}
+		const int top = Histogram::GetBucket( 0xffffffff );
+		if( top >= Histogram::NUM_BUCKETS || Histogram::GetBucketUpperBound( top ) != 0xffffffff )
+			placed = false;
+		Check( placed, "histogram bucket placement" );
+
+		//1 to 1000 us, recorded in two halves and merged
+		Histogram low;
+		Histogram high;
+		for( unsigned int us = 1; us <= 1000; ++us )
+			( us <= 500 ? low : high ).RecordMicroseconds( us );
+		Histogram all = low;
+		all.Merge( high );
+
+		const double p50 = all.GetPercentile( 50.0 ) * 1.0e6;
+		const double p99 = all.GetPercentile( 99.0 ) * 1.0e6;
+		const double p100 = all.GetPercentile( 100.0 ) * 1.0e6;
+		Check( 1000 == all.GetCount() && fabs( all.GetMean() * 1.0e6 - 500.5 ) < 0.01,
+			   "histogram count and mean" );
+		Check( p50 >= 500.0 - 0.5 && p50 <= 500.0 * 1.25, "histogram p50" );
+		Check( p99 >= 990.0 - 0.5 && p99 <= 990.0 * 1.25, "histogram p99" );
+		Check( fabs( p100 - 1000.0 ) < 0.5 && fabs( all.GetMax() * 1.0e6 - 1000.0 ) < 0.5,
+			   "histogram max" );
+
+		all.Clear();
+		Check( 0 == all.GetCount() && 0.0 == all.GetPercentile( 99.0 ), "histogram clear" );
+	}
+
+	//--------------------------------------------------------------------------
+	// Name: CheckSmoothedCost()
+	// Desc: Solves a braided, weighted maze with every solver, with and
+	//		 without path smoothing, and checks that they all report the same
+	//		 cost. Smoothing keeps only the waypoints, so the cost has to come
+	//		 from the path before it
+	//--------------------------------------------------------------------------
+	void CheckSmoothedCost( const int size, const unsigned int seed )
+	{
+		Grid grid( size, size );
+		grid.SetBraidFactor( 0.5f );
+		grid.GenerateMaze( seed );
+
+		int expected = -1;
+		bool same = true;
+		for( int solver = Grid::SOLVER_ASTAR; solver <= Grid::SOLVER_PARALLEL; ++solver )
+		{
+			for( int smooth = 0; smooth < 2; ++smooth )
+			{
+				grid.SetSolver( Grid::Solver( solver ) );
+				grid.SetPathSmoothing( 1 == smooth );
+				grid.GenerateSolution();
+
+				if( expected < 0 )
+					expected = grid.GetSolutionCost();
+				else if( grid.GetSolutionCost() != expected )
+					same = false;
+			}
+		}
+
+		Check( expected > 0 && same, "smoothed and unsmoothed costs match", size );
+	}
+
+	//--------------------------------------------------------------------------
+	// Name: CountSolidCells()
+	// Desc: Counts the walls and the border cubes around the grid, leaving out
+	//		 the gaps for the entrance and exits
+	//--------------------------------------------------------------------------
+	int CountSolidCells( const Grid& grid )
+	{
+		const int width = grid.GetWidth();
+		const int height = grid.GetHeight();
+
+		int count = 0;
+		for( int y = 0; y < height; ++y )
+			for( int x = 0; x < width; ++x )
+				if( Grid::TILE_WALL == grid.GetTile( x, y ) )
+					++count;
+
+		count += 2 * ( width + 2 ) + 2 * height;
+		count -= 1 + grid.GetNumExits();
+
+		return count;
+	}
+
+	//--------------------------------------------------------------------------
+	// Name: CheckWallMesh()
+	// Desc: Builds the walls of a whole maze and checks that every part's
+	//		 indices stay in range, that the mesh is closed and faces outwards,
+	//		 and that merging has cut the triangles well below a box per cell.
+	//		 Greedy meshing leaves T-junctions, so edges can't be matched up.
+	//		 Instead the area vectors of a closed surface cancel out, and the
+	//		 volume it encloses is one per solid cell
+	//--------------------------------------------------------------------------
+	void CheckWallMesh( const int size, const unsigned int seed )
+	{
+		Grid grid( size, size );
+		grid.GenerateMaze( seed );
+
+		WallMesh mesh;
+		mesh.Build( grid );
+
+		bool inRange = true;
+		int numTriangles = 0;
+		double area[ 3 ] = { 0.0, 0.0, 0.0 };
+		for( int l = 0; l < WallMesh::NUM_LAYERS; ++l )
+		{
+			const WallMesh::Layer layer = WallMesh::Layer( l );
+			const WallVertex* pVertices = mesh.GetVertices( layer );
+			const unsigned short* pIndices = mesh.GetIndices( layer );
+			const vector< WallMeshPart >& parts = mesh.GetParts( layer );
+			numTriangles += mesh.GetNumTriangles( layer );
+
+			int numIndices = 0;
+			for( size_t p = 0; p < parts.size(); ++p )
+			{
+				const WallMeshPart& part = parts[ p ];
+				numIndices += part.numIndices;
+				if( part.numVertices > WallMesh::MAX_PART_VERTICES ||
+					part.firstVertex + part.numVertices > mesh.GetNumVertices( layer ) )
+					inRange = false;
+
+				for( int t = part.firstIndex; t + 2 < part.firstIndex + part.numIndices; t += 3 )
+				{
+					if( pIndices[ t ] >= part.numVertices || pIndices[ t + 1 ] >= part.numVertices ||
+						pIndices[ t + 2 ] >= part.numVertices )
+					{
+						inRange = false;
+						continue;
+					}
+
+					const WallVertex& a = pVertices[ part.firstVertex + pIndices[ t ] ];
+					const WallVertex& b = pVertices[ part.firstVertex + pIndices[ t + 1 ] ];
+					const WallVertex& c = pVertices[ part.firstVertex + pIndices[ t + 2 ] ];
+					const double ux = b.x - a.x, uy = b.y - a.y, uz = b.z - a.z;
+					const double vx = c.x - a.x, vy = c.y - a.y, vz = c.z - a.z;
+					area[ 0 ] += uy * vz - uz * vy;
+					area[ 1 ] += uz * vx - ux * vz;
+					area[ 2 ] += ux * vy - uy * vx;
+				}
+			}
+			if( numIndices != mesh.GetNumIndices( layer ) )
+				inRange = false;
+		}
+
+		const int numSolid = CountSolidCells( grid );
+		const bool closed = ( fabs( area[ 0 ] ) < 0.5 && fabs( area[ 1 ] ) < 0.5 &&
+							  fabs( area[ 2 ] ) < 0.5 );
+		Check( inRange, "wall mesh indices in range", size );
+		Check( closed, "wall mesh closed", size );
+		Check( fabs( mesh.ComputeVolume() - numSolid ) < 0.5f, "wall mesh volume matches cells", size );
+		Check( numTriangles > 0 && numTriangles < 12 * numSolid, "wall mesh fewer triangles than boxes", size );
+		printf( "     %d solid cells, %d triangles, %d wall parts\n", numSolid, numTriangles,
+				int( mesh.GetParts( WallMesh::LAYER_WALL ).size() ) );
+	}
+
+	//--------------------------------------------------------------------------
+	// Name: IsOpen()
+	// Desc: Checks to see if a cell is in the grid and not a wall
+	//--------------------------------------------------------------------------
+	bool IsOpen( const Grid& grid, const int x, const int y )
+	{
+		return x >= 0 && x < grid.GetWidth() && y >= 0 && y < grid.GetHeight() &&
+			   Grid::TILE_WALL != grid.GetTile( x, y );
+	}
+
+	//--------------------------------------------------------------------------
+	// Name: ReportHas()
+	// Desc: Checks that a report holds exactly the given number of errors of
+	//		 up to two kinds, and none of any other
+	//--------------------------------------------------------------------------
+	bool ReportHas( const MazeReport& report, const MazeError::Kind kindA, const int countA,
+					const MazeError::Kind kindB = MazeError::NUM_KINDS, const int countB = 0 )
+	{
+		for( int k = 0; k < MazeError::NUM_KINDS; ++k )
+		{
+			const int expected = ( kindA == k ) ? countA : ( kindB == k ) ? countB : 0;
+			if( report.counts[ k ] != expected )
+				return false;
+		}
+
+		return report.numErrors == countA + countB;
+	}
+
+	//--------------------------------------------------------------------------
+	// Name: FindStraightCell()
+	// Desc: Finds a cell on the solution, from halfway along, with open cells
+	//		 on two opposite sides and walls on the other two. Walling it up
+	//		 cuts the maze in two without leaving cells meeting at a corner
+	//--------------------------------------------------------------------------
+	bool FindStraightCell( const Grid& grid, int& cellX, int& cellY )
+	{
+		const SquareVector& solution = grid.GetSolution();
+		for( size_t i = solution.size() / 2; i + 1 < solution.size(); ++i )
+		{
+			const int x = solution[ i ].x;
+			const int y = solution[ i ].y;
+			const bool across = IsOpen( grid, x - 1, y ) && IsOpen( grid, x + 1, y );
+			const bool down = IsOpen( grid, x, y - 1 ) && IsOpen( grid, x, y + 1 );
+			const bool sideways = IsOpen( grid, x - 1, y ) || IsOpen( grid, x + 1, y );
+			const bool upright = IsOpen( grid, x, y - 1 ) || IsOpen( grid, x, y + 1 );
+			if( Grid::TILE_PATH == grid.GetTile( x, y ) &&
+				( ( across && ! upright ) || ( down && ! sideways ) ) )
+			{
+				cellX = x;
+				cellY = y;
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	//--------------------------------------------------------------------------
+	// Name: FindBend()
+	// Desc: Finds a bend whose inside corner, at x + 1, y + 1, is a wall with
+	//		 walls all round it but for the bend. Opening it makes exactly one
+	//		 2x2 block and one loop
+	//--------------------------------------------------------------------------
+	bool FindBend( const Grid& grid, int& bendX, int& bendY )
+	{
+		for( int y = 0; y + 2 < grid.GetHeight(); ++y )
+		{
+			for( int x = 0; x + 2 < grid.GetWidth(); ++x )
+			{
+				if( IsOpen( grid, x, y ) && IsOpen( grid, x + 1, y ) && IsOpen( grid, x, y + 1 ) &&
+					! IsOpen( grid, x + 1, y + 1 ) && ! IsOpen( grid, x + 2, y + 1 ) &&
+					! IsOpen( grid, x + 1, y + 2 ) && ! IsOpen( grid, x + 2, y ) &&
+					! IsOpen( grid, x, y + 2 ) && ! IsOpen( grid, x + 2, y + 2 ) )
+				{
+					bendX = x;
+					bendY = y;
+					return true;
+				}
+			}
+		}
+
+		return false;
+	}
+
+	//--------------------------------------------------------------------------
+	// Name: CheckValidator()
+	// Desc: Checks that generated mazes validate clean, then breaks one in
+	//		 known ways and checks the validator reports exactly those errors.
+	//		 A width over 64 cells makes the rows span several bitboard words
+	//--------------------------------------------------------------------------
+	void CheckValidator( const int size, const unsigned int seed )
+	{
+		MazeValidator validator;
+		MazeReport report;
+
+		Grid grid( size, size );
+		grid.GenerateMaze( seed );
+		grid.GenerateSolution();
+		Check( validator.Validate( grid, report ) && 1 == report.numComponents && 0 == report.numLoops,
+			   "validator passes a generated maze", size );
+
+		//a 2x2 block, which also closes a loop
+		int x = 0, y = 0;
+		bool found = FindBend( grid, x, y );
+		if( found )
+		{
+			grid.SetTile( x + 1, y + 1, Grid::TILE_PATH );
+			validator.Validate( grid, report );
+			found = ReportHas( report, MazeError::ERROR_OPEN_BLOCK, 1, MazeError::ERROR_LOOP, 1 ) &&
+					MazeError::ERROR_OPEN_BLOCK == report.errors.back().kind &&
+					x == report.errors.back().x && y == report.errors.back().y;
+			grid.SetTile( x + 1, y + 1, Grid::TILE_WALL );
+		}
+		Check( found, "validator finds an open block", size );
+
+		//a corridor on the solution cut, leaving the exit's side on its own
+		found = FindStraightCell( grid, x, y );
+		if( found )
+		{
+			grid.SetTile( x, y, Grid::TILE_WALL );
+			validator.Validate( grid, report );
+			found = ReportHas( report, MazeError::ERROR_UNREACHABLE_CELL, 1,
+							   MazeError::ERROR_UNREACHABLE_EXIT, 1 ) && 2 == report.numComponents;
+
+			//the same cell as a second entrance
+			grid.SetTile( x, y, Grid::TILE_START );
+			validator.Validate( grid, report );
+			found = found && ReportHas( report, MazeError::ERROR_START_PLACEMENT, 1 ) &&
+					x == report.errors[ 0 ].x && y == report.errors[ 0 ].y;
+			grid.SetTile( x, y, Grid::TILE_PATH );
+		}
+		Check( found, "validator finds a cut corridor and second start", size );
+
+		Check( validator.Validate( grid, report ), "validator passes the mended maze", size );
+
+		//braiding makes loops, and may open cells meeting only at a corner
+		grid.SetBraidFactor( 0.5f );
+		grid.GenerateMaze( seed );
+		validator.Validate( grid, report );
+		const int numLoops = report.numLoops;
+		Check( numLoops > 0 && report.counts[ MazeError::ERROR_LOOP ] == numLoops &&
+			   report.numErrors == numLoops + report.counts[ MazeError::ERROR_DIAGONAL ],
+			   "validator finds loops in a braided maze", size );
+
+		validator.SetAllowLoops( true );
+		Check( validator.Validate( grid, report ) && report.numLoops == numLoops,
+			   "validator passes it with loops allowed", size );
+	}
+
+	//--------------------------------------------------------------------------
+	// Name: CheckDistanceMatrix()
+	// Desc: Weights a maze at random, then checks every entry of a distance
+	//		 matrix against a search between that pair alone. A perfect maze
+	//		 goes by the tree walk and a braided one by the searches. One point
+	//		 is put in a wall, and must be unreachable both ways
+	//--------------------------------------------------------------------------
+	void CheckDistanceMatrix( const int size, const unsigned int seed, const bool braided )
+	{
+		Grid grid( size, size );
+		grid.SetBraidFactor( braided ? 0.5f : 0.0f );
+		grid.GenerateMaze( seed );
+
+		Random random( seed );
+		vector< MazeSquare > points;
+		for( int y = 0; y < size; ++y )
+			for( int x = 0; x < size; ++x )
+				if( Grid::TILE_WALL != grid.GetTile( x, y ) )
+					grid.SetWeight( x, y, Grid::MIN_WEIGHT + int( random.Next( Grid::MAX_WEIGHT ) ) );
+
+		//numOpen open cells, then one wall
+		const int numOpen = 16;
+		while( int( points.size() ) <= numOpen )
+		{
+			const int x = int( random.Next( (unsigned int)( size ) ) );
+			const int y = int( random.Next( (unsigned int)( size ) ) );
+			const bool isWall = ( Grid::TILE_WALL == grid.GetTile( x, y ) );
+			if( isWall == ( int( points.size() ) == numOpen ) )
+				points.push_back( MazeSquare( x, y ) );
+		}
+
+		DistanceMatrix matrix;
+		matrix.Compute( grid, points );
+
+		const int numCells = grid.GetNumCells();
+		BucketQueue queue;
+		queue.Resize( numCells, Grid::MAX_WEIGHT + 1 );
+		vector< int > cost( numCells );
+		vector< int > parent( numCells );
+		GridStats stats;
+
+		bool same = ( numOpen + 1 == matrix.GetNumPoints() );
+		for( int from = 0; from < numOpen && same; ++from )
+		{
+			const int fromCell = grid.GetCellIndex( points[ from ].x, points[ from ].y );
+			for( int to = 0; to < numOpen; ++to )
+			{
+				const int toCell = grid.GetCellIndex( points[ to ].x, points[ to ].y );
+				MazeFindPath( grid, fromCell, &toCell, 1, ZeroHeuristic(), queue, &cost[ 0 ],
+							  &parent[ 0 ], stats );
+				if( matrix.GetDistance( from, to ) != cost[ toCell ] )
+					same = false;
+			}
+
+			if( matrix.GetDistance( from, numOpen ) != -1 || matrix.GetDistance( numOpen, from ) != -1 )
+				same = false;
+		}
+
+		Check( same && matrix.GetUsedTree() == ! braided,
+			   braided ? "distance matrix searches match" : "distance matrix tree walk matches", size );
+	}
+
+	//--------------------------------------------------------------------------
+	// Name: CheckTrace()
+	// Desc: Records a braided maze, saves and loads the trace, and checks that
+	//		 replaying it rebuilds the same maze. Then seeks back to a step
+	//		 partway through and on again, checking each against a second
+	//		 grid stepped there one step at a time
+	//--------------------------------------------------------------------------
+	void CheckTrace( const int size, const unsigned int seed )
+	{
+		MazeTrace trace;
+		Grid grid( size, size );
+		grid.SetBraidFactor( 0.3f );
+		grid.SetTrace( &trace );
+		grid.GenerateMaze( seed );
+		grid.SetTrace( NULL );
+
+		//a copy as it would come back from a file
+		MazeTrace loaded;
+		const vector< unsigned char > saved( trace.GetData(), trace.GetData() + trace.GetSize() );
+		const bool load = loaded.Load( &saved[ 0 ], saved.size() ) &&
+						  loaded.GetNumSteps() == trace.GetNumSteps();
+
+		Grid replayed( size, size );
+		MazeReplayer replayer( loaded, replayed );
+		const bool same = load && replayer.Seek( loaded.GetNumSteps() ) &&
+						  replayed.GetHash() == grid.GetHash() &&
+						  replayed.GetStartY() == grid.GetStartY() &&
+						  replayed.GetNumExits() == grid.GetNumExits();
+		Check( same, "trace replays to the same maze", size );
+
+		Grid stepped( size, size );
+		MazeReplayer stepper( loaded, stepped );
+		bool seek = stepper.Reset();
+
+		const int middle = loaded.GetNumSteps() / 2;
+		const int later = middle + loaded.GetNumSteps() / 4;
+		while( seek && stepper.GetStep() < middle )
+			seek = stepper.Step();
+		seek = seek && replayer.Seek( middle ) && middle == replayer.GetStep() &&
+			   replayed.GetHash() == stepped.GetHash();
+
+		while( seek && stepper.GetStep() < later )
+			seek = stepper.Step();
+		seek = seek && replayer.Seek( later ) && later == replayer.GetStep() &&
+			   replayed.GetHash() == stepped.GetHash();
+		Check( seek, "trace seeks back and forward", size );
+	}
+
+	//--------------------------------------------------------------------------
+	// Name: Sweep()
+	// Desc: Breadth-first search over the path cells from one cell, filling in
+	//		 the step count to each. Returns the cell reached last
+	//--------------------------------------------------------------------------
+	int Sweep( const Grid& grid, const int fromCell, vector< int >& distance )
+	{
+		static const int moveX[ 4 ] = { 0, 1, 0, -1 };
+		static const int moveY[ 4 ] = { 1, 0, -1, 0 };
+
+		distance.assign( grid.GetNumCells(), -1 );
+		vector< int > queue( 1, fromCell );
+		distance[ fromCell ] = 0;
+		for( size_t head = 0; head < queue.size(); ++head )
+		{
+			const int cell = queue[ head ];
+			for( int i = 0; i < 4; ++i )
+			{
+				const int x = grid.GetCellX( cell ) + moveX[ i ];
+				const int y = grid.GetCellY( cell ) + moveY[ i ];
+				if( ! grid.IsPath( x, y ) || distance[ grid.GetCellIndex( x, y ) ] >= 0 )
+					continue;
+
+				distance[ grid.GetCellIndex( x, y ) ] = distance[ cell ] + 1;
+				queue.push_back( grid.GetCellIndex( x, y ) );
+			}
+		}
+		return queue.back();
+	}
+
+	//--------------------------------------------------------------------------
+	// Name: SameAnalysis()
+	// Desc: Compares every field of two analyses
+	//--------------------------------------------------------------------------
+	bool SameAnalysis( const MazeAnalysis& a, const MazeAnalysis& b )
+	{
+		return a.numCells == b.numCells && a.numPathCells == b.numPathCells &&
+			   a.coverage == b.coverage && a.numDeadEnds == b.numDeadEnds &&
+			   a.numJunctions == b.numJunctions && a.branchingFactor == b.branchingFactor &&
+			   a.longestCorridor == b.longestCorridor && a.diameter == b.diameter &&
+			   a.solutionLength == b.solutionLength && a.solutionRatio == b.solutionRatio &&
+			   a.isPerfect == b.isPerfect;
+	}
+
+	//--------------------------------------------------------------------------
+	// Name: CheckAnalyser()
+	// Desc: Analyses one maze on a single band and split into bands of a few
+	//		 rows, so corridors cross several of them, and checks the two
+	//		 agree. Then checks the counts against a plain scan of the whole
+	//		 grid, and in a perfect maze the diameter and solution against
+	//		 two sweeps of its own
+	//--------------------------------------------------------------------------
+	void CheckAnalyser( const int size, const unsigned int seed, const bool braided )
+	{
+		Grid grid( size, size );
+		grid.SetBraidFactor( braided ? 0.3f : 0.0f );
+		grid.GenerateMaze( seed );
+
+		MazeAnalysis single;
+		MazeAnalyser analyser;
+		analyser.SetNumThreads( 1 );
+		analyser.Analyse( grid, single );
+
+		MazeAnalysis banded;
+		bool same = true;
+		const int numThreads[ 2 ] = { 7, size / 4 };
+		for( int i = 0; i < 2; ++i )
+		{
+			analyser.SetNumThreads( numThreads[ i ] );
+			analyser.Analyse( grid, banded );
+			same = same && SameAnalysis( single, banded );
+		}
+		Check( same, braided ? "analyser bands match, braided" : "analyser bands match", size );
+
+		//dead ends, junctions and straight runs, counted over the whole grid
+		int numDeadEnds = 0;
+		int numJunctions = 0;
+		int longestCorridor = 0;
+		vector< int > columnRun( size, 0 );
+		for( int y = 0; y < size; ++y )
+		{
+			int rowRun = 0;
+			for( int x = 0; x < size; ++x )
+			{
+				if( ! grid.IsPath( x, y ) )
+				{
+					rowRun = columnRun[ x ] = 0;
+					continue;
+				}
+
+				const Grid::GridTile tile = grid.GetTile( x, y );
+				const int degree = ( grid.IsPath( x + 1, y ) ? 1 : 0 ) + ( grid.IsPath( x - 1, y ) ? 1 : 0 ) +
+								   ( grid.IsPath( x, y + 1 ) ? 1 : 0 ) + ( grid.IsPath( x, y - 1 ) ? 1 : 0 ) +
+								   ( ( Grid::TILE_START == tile || Grid::TILE_GOAL == tile ) ? 1 : 0 );
+				if( 1 == degree )
+					++numDeadEnds;
+				else if( degree >= 3 )
+					++numJunctions;
+
+				++rowRun;
+				++columnRun[ x ];
+				if( rowRun > longestCorridor )
+					longestCorridor = rowRun;
+				if( columnRun[ x ] > longestCorridor )
+					longestCorridor = columnRun[ x ];
+			}
+		}
+		Check( single.numDeadEnds == numDeadEnds && single.numJunctions == numJunctions &&
+			   single.longestCorridor == longestCorridor,
+			   braided ? "analyser counts match a scan, braided" : "analyser counts match a scan", size );
+
+		if( braided )
+		{
+			Check( ! single.isPerfect, "analyser finds the loops", size );
+			return;
+		}
+
+		//in a perfect maze the second sweep gives the exact diameter
+		vector< int > distance;
+		const int furthest = Sweep( grid, grid.GetCellIndex( 0, grid.GetStartY() ), distance );
+		int solutionLength = -1;
+		for( int i = 0; i < grid.GetNumExits(); ++i )
+		{
+			const int exitDistance = distance[ grid.GetCellIndex( grid.GetExit( i ).x, grid.GetExit( i ).y ) ];
+			if( exitDistance >= 0 && ( solutionLength < 0 || exitDistance < solutionLength ) )
+				solutionLength = exitDistance;
+		}
+		const int diameter = distance[ Sweep( grid, furthest, distance ) ];
+		Check( single.isPerfect && single.diameter == diameter && single.solutionLength == solutionLength,
+			   "analyser diameter matches two sweeps", size );
+	}
+
+	//--------------------------------------------------------------------------
+	// Name: LoadArea()
+	// Desc: Requests the chunks within radius cells of x, y and waits for the
+	//		 workers to finish them
+	//--------------------------------------------------------------------------
+	void LoadArea( MazeWorld& world, const int x, const int y, const int radius )
+	{
+		world.RequestArea( x, y, radius );
+		world.Update();
+		while( world.GetNumPending() > 0 )
+		{
+			YieldThread();
+			world.Update();
+		}
+	}
+
+	//--------------------------------------------------------------------------
+	// Name: CheckWorld()
+	// Desc: Loads a square of chunks around the origin on one worker and on
+	//		 three, and checks both match chunks generated directly, so a
+	//		 chunk depends only on the seed and its coordinates. Then checks
+	//		 both sides of every edge are open at its opening, the square is
+	//		 one connected maze, and FindPath between cells chunks apart is
+	//		 as short as a breadth-first search over the same box
+	//--------------------------------------------------------------------------
+	void CheckWorld( const unsigned int seed, const int numChunks )
+	{
+		const int chunk = MazeWorld::CHUNK_SIZE;
+		const int radius = numChunks / 2 * chunk;
+		const int first = -radius;
+		const int size = ( numChunks / 2 * 2 + 1 ) * chunk;
+
+		MazeWorld one( seed, 1 );
+		MazeWorld three( seed, 3 );
+		LoadArea( one, 0, 0, radius );
+		LoadArea( three, 0, 0, radius );
+
+		Grid workspace( chunk, chunk );
+		vector< unsigned char > tiles( chunk * chunk );
+		bool same = true;
+		for( int chunkY = -numChunks / 2; chunkY <= numChunks / 2 && same; ++chunkY )
+		{
+			for( int chunkX = -numChunks / 2; chunkX <= numChunks / 2 && same; ++chunkX )
+			{
+				MazeWorld::GenerateChunk( seed, chunkX, chunkY, workspace, &tiles[ 0 ] );
+				for( int cell = 0; cell < chunk * chunk && same; ++cell )
+				{
+					const int x = chunkX * chunk + cell % chunk;
+					const int y = chunkY * chunk + cell / chunk;
+					same = one.IsLoaded( x, y ) && three.IsLoaded( x, y ) &&
+						   one.GetTile( x, y ) == three.GetTile( x, y ) &&
+						   Grid::GridTile( tiles[ cell ] ) == one.GetTile( x, y );
+				}
+			}
+		}
+		Check( same, "world chunks same on 1 and 3 workers", size );
+
+		//both sides open at each edge's opening
+		bool crossed = true;
+		for( int chunkY = -numChunks / 2; chunkY <= numChunks / 2; ++chunkY )
+		{
+			for( int chunkX = -numChunks / 2; chunkX <= numChunks / 2; ++chunkX )
+			{
+				const int left = chunkY * chunk + MazeWorld::GetOpening( seed, chunkX, chunkY, true );
+				const int bottom = chunkX * chunk + MazeWorld::GetOpening( seed, chunkX, chunkY, false );
+				if( chunkX > -numChunks / 2 )
+					crossed = crossed && one.IsPath( chunkX * chunk - 1, left ) && one.IsPath( chunkX * chunk, left );
+				if( chunkY > -numChunks / 2 )
+					crossed = crossed && one.IsPath( bottom, chunkY * chunk - 1 ) && one.IsPath( bottom, chunkY * chunk );
+			}
+		}
+		Check( crossed, "world chunk openings agree", size );
+
+		//one sweep of the square from its first open cell
+		vector< int > distance( size * size, -1 );
+		vector< int > queue;
+		int numOpen = 0;
+		for( int cell = 0; cell < size * size; ++cell )
+		{
+			if( ! one.IsPath( first + cell % size, first + cell / size ) )
+				continue;
+			if( queue.empty() )
+			{
+				queue.push_back( cell );
+				distance[ cell ] = 0;
+			}
+			++numOpen;
+		}
+		for( size_t head = 0; head < queue.size(); ++head )
+		{
+			const int cell = queue[ head ];
+			const int next[ 4 ] = { cell + size, cell + 1, cell - size, cell - 1 };
+			const bool inside[ 4 ] = { cell / size < size - 1, cell % size < size - 1, cell / size > 0,
+									   cell % size > 0 };
+			for( int i = 0; i < 4; ++i )
+			{
+				if( inside[ i ] && distance[ next[ i ] ] < 0 &&
+					one.IsPath( first + next[ i ] % size, first + next[ i ] / size ) )
+				{
+					distance[ next[ i ] ] = distance[ cell ] + 1;
+					queue.push_back( next[ i ] );
+				}
+			}
+		}
+		Check( numOpen > 0 && int( queue.size() ) == numOpen, "world chunks join into one maze", size );
+
+		//FindPath against a search of the same box, a chunk past both ends
+		Random random( seed );
+		bool shortest = true;
+		for( int i = 0; i < 20 && shortest; ++i )
+		{
+			const int fromCell = queue[ random.Next( (unsigned int)( queue.size() ) ) ];
+			const int toCell = queue[ random.Next( (unsigned int)( queue.size() ) ) ];
+			const int fromX = first + fromCell % size;
+			const int fromY = first + fromCell / size;
+			const int toX = first + toCell % size;
+			const int toY = first + toCell / size;
+
+			vector< MazeSquare > path;
+			shortest = three.FindPath( fromX, fromY, toX, toY, path ) && ! path.empty() &&
+					   path.front().x == fromX && path.front().y == fromY &&
+					   path.back().x == toX && path.back().y == toY;
+			for( size_t step = 1; step < path.size() && shortest; ++step )
+				shortest = three.IsPath( path[ step ].x, path[ step ].y ) &&
+						   abs( path[ step ].x - path[ step - 1 ].x ) + abs( path[ step ].y - path[ step - 1 ].y ) == 1;
+
+			//first is a chunk corner, so rounding down from it finds the chunks
+			const int boxX = ( min( fromX, toX ) - first ) / chunk * chunk + first - chunk;
+			const int boxY = ( min( fromY, toY ) - first ) / chunk * chunk + first - chunk;
+			const int boxWidth = ( ( max( fromX, toX ) - first ) / chunk + 2 ) * chunk + first - boxX;
+			const int boxHeight = ( ( max( fromY, toY ) - first ) / chunk + 2 ) * chunk + first - boxY;
+			vector< int > boxDistance( boxWidth * boxHeight, -1 );
+			vector< int > boxQueue( 1, ( fromY - boxY ) * boxWidth + fromX - boxX );
+			boxDistance[ boxQueue[ 0 ] ] = 0;
+			for( size_t head = 0; head < boxQueue.size(); ++head )
+			{
+				const int cell = boxQueue[ head ];
+				const int cellX = cell % boxWidth;
+				const int cellY = cell / boxWidth;
+				const int moveX[ 4 ] = { 0, 1, 0, -1 };
+				const int moveY[ 4 ] = { 1, 0, -1, 0 };
+				for( int d = 0; d < 4; ++d )
+				{
+					const int x = cellX + moveX[ d ];
+					const int y = cellY + moveY[ d ];
+					if( x < 0 || x >= boxWidth || y < 0 || y >= boxHeight ||
+						boxDistance[ y * boxWidth + x ] >= 0 || ! three.IsPath( boxX + x, boxY + y ) )
+						continue;
+					boxDistance[ y * boxWidth + x ] = boxDistance[ cell ] + 1;
+					boxQueue.push_back( y * boxWidth + x );
+				}
+			}
+			shortest = shortest &&
+					   int( path.size() ) == boxDistance[ ( toY - boxY ) * boxWidth + toX - boxX ] + 1;
+		}
+		Check( shortest, "world FindPath is shortest across chunks", size );
+	}
+
+	//--------------------------------------------------------------------------
+	// Name: CheckSimulation()
+	// Desc: Runs two simulations from the same seed, one ticked directly as a
+	//		 headless run would and one fed uneven frame times as the game
+	//		 would, and checks that they end up in the same place. The frames
+	//		 add up to half a tick more than numTicks, so rounding in the
+	//		 accumulated time can't lose the last tick
+	//--------------------------------------------------------------------------
+	void CheckSimulation( const unsigned int seed, const int size, const int numTicks )
+	{
+		Timer timer;
+		Simulation ticked( seed, size, size );
+		for( int i = 0; i < numTicks; ++i )
+			ticked.Tick();
+		const double seconds = timer.GetSeconds();
+
+		//frames of half a tick, two and a quarter, and one and a quarter
+		Simulation advanced( seed, size, size );
+		const float tick = advanced.GetTickLength();
+		const float frames[ 3 ] = { 0.5f * tick, 2.25f * tick, 1.25f * tick };
+		for( int i = 0; i < numTicks / 4; ++i )
+			for( int f = 0; f < 3; ++f )
+				advanced.Advance( frames[ f ] );
+		advanced.Advance( 0.5f * tick );
+
+		const Vector3 a = ticked.GetPlayer().GetPos();
+		const Vector3 b = advanced.GetPlayer().GetPos();
+		Check( ticked.GetTickCount() == (unsigned int)( numTicks ) &&
+			   advanced.GetTickCount() == ticked.GetTickCount() &&
+			   advanced.GetMazeCount() == ticked.GetMazeCount() &&
+			   a.x == b.x && a.y == b.y && a.z == b.z, "simulation same by tick and by frame", size );
+		printf( "     %d ticks, %u mazes, %.0f times real time\n", numTicks, ticked.GetMazeCount(),
+				numTicks * tick / seconds );
+	}
+}
+
+
+//------------------------------------------------------------------------------
+// Definitions:
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Name: main()
+// Desc: Entry point - runs every check, returning non-zero if any failed
+//------------------------------------------------------------------------------
+int main()
+{
+	CheckHistogram();
+	CheckSmoothedCost( 65, 7 );
+	CheckSmoothedCost( 257, 3 );
+
+	//257 needs more than 64k vertices, so the walls are split into parts
+	CheckWallMesh( 41, 1 );
+	CheckWallMesh( 257, 1 );
+
+	CheckValidator( 65, 2 );
+	CheckValidator( 201, 4 );
+
+	CheckDistanceMatrix( 129, 6, false );
+	CheckDistanceMatrix( 129, 6, true );
+
+	CheckTrace( 257, 8 );
+
+	//big enough for the analyser to split the rows into bands
+	CheckAnalyser( 513, 9, false );
+	CheckAnalyser( 513, 9, true );
+
+	//five chunks square, either side of the origin
+	CheckWorld( 10, 5 );
+
+	//ten minutes of play, numTicks a multiple of four for the frame pattern
+	CheckSimulation( 5, 65, 10 * 60 * CONST_TICK_RATE );
+
+	if( g_numFailed > 0 )
+	{
+		printf( "%d checks failed\n", g_numFailed );
+		return 1;
+	}
+
+	printf( "all checks passed\n" );
+	return 0;
+}
@@ -0,0 +1,114 @@
+//------------------------------------------------------------------------------
+// File: MazeDaemon.cpp
+// Desc: Entry point for the headless maze daemon
+//
+// Created: 19 October 2026 23:58:30
+//
+// (c)2002 Neil Wakefield
+//------------------------------------------------------------------------------
+
+
+//------------------------------------------------------------------------------
+// Included files:
+//------------------------------------------------------------------------------
+#include "MazeServer.h"
+#include "MemoryTracker.h"
+
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+//------------------------------------------------------------------------------
+// Globals:
+//------------------------------------------------------------------------------
+namespace
+{
+	MazeServer* g_pServer = NULL;
+
+	//--------------------------------------------------------------------------
+	// Name: OnSignal()
+	// Desc: Stops the server on SIGINT or SIGTERM
+	//--------------------------------------------------------------------------
+	void OnSignal( int )
+	{
+		if( g_pServer != NULL )
+			g_pServer->Stop();
+	}
+
+	//--------------------------------------------------------------------------
+	// Name: PrintUsage()
+	// Desc: Explains the command line
+	//--------------------------------------------------------------------------
+	void PrintUsage()
+	{
+		fprintf( stderr, "usage: MazeDaemon [-w workers] [-b max batch] [-t batch window us] socket\n" );
+	}
+}
+
+
+//------------------------------------------------------------------------------
+// Definitions:
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Name: main()
+// Desc: Serves until interrupted, then prints the final stats and memory
+//------------------------------------------------------------------------------
+int main( int argc, char* argv[] )
+{
+	MazeServer server;
+	const char* pPath = NULL;
+
+	for( int i = 1; i < argc; ++i )
+	{
+		const bool hasValue = ( i + 1 < argc );
+		if( 0 == strcmp( argv[ i ], "-w" ) && hasValue )
+			server.SetNumWorkers( atoi( argv[ ++i ] ) );
+		else if( 0 == strcmp( argv[ i ], "-b" ) && hasValue )
+			server.SetMaxBatch( atoi( argv[ ++i ] ) );
+		else if( 0 == strcmp( argv[ i ], "-t" ) && hasValue )
+			server.SetBatchWindow( atof( argv[ ++i ] ) * 1.0e-6 );
+		else if( argv[ i ][ 0 ] != '-' && pPath == NULL )
+			pPath = argv[ i ];
+		else
+		{
+			PrintUsage();
+			return 1;
+		}
+	}
+
+	if( pPath == NULL )
+	{
+		PrintUsage();
+		return 1;
+	}
+
+	if( ! server.Open( pPath ) )
+	{
+		fprintf( stderr, "MazeDaemon: can't listen on %s\n", pPath );
+		return 1;
+	}
+
+	g_pServer = &server;
+	signal( SIGPIPE, SIG_IGN );
+	signal( SIGINT, OnSignal );
+	signal( SIGTERM, OnSignal );
+
+	server.Run();
+
+	g_pServer = NULL;
+	server.Close();
+
+	unsigned int stats[ MAX_STATS ];
+	server.GetStats( stats );
+	printf( "requests %u in %u batches, %u served from a shared maze, peak queue %u\n",
+			stats[ STAT_REQUESTS ], stats[ STAT_BATCHES ], stats[ STAT_MAZES_SHARED ],
+			stats[ STAT_PEAK_QUEUE_DEPTH ] );
+	printf( "latency us: p50 %u p90 %u p99 %u max %u\n", stats[ STAT_LATENCY_P50 ],
+			stats[ STAT_LATENCY_P90 ], stats[ STAT_LATENCY_P99 ], stats[ STAT_LATENCY_MAX ] );
+	printf( "memory:\n%s", MemoryTracker::GetReport().c_str() );
+
+	return 0;
+}
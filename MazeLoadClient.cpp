@@ -0,0 +1,371 @@
+//------------------------------------------------------------------------------
+// File: MazeLoadClient.cpp
+// Desc: Load generator for benchmarking the maze daemon
+//
+// Created: 20 October 2026 00:14:52
+//
+// (c)2002 Neil Wakefield
+//------------------------------------------------------------------------------
+
+
+//------------------------------------------------------------------------------
+// Included files:
+//------------------------------------------------------------------------------
+#include "Histogram.h"
+#include "MazeProtocol.h"
+#include "Threading.h"
+#include "Timer.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <vector>
+using namespace std;
+
+
+//------------------------------------------------------------------------------
+// Globals:
+//------------------------------------------------------------------------------
+namespace
+{
+	//--------------------------------------------------------------------------
+	// Name: struct LoadSettings
+	// Desc: What every client connection sends
+	//--------------------------------------------------------------------------
+	struct LoadSettings
+	{
+		const char* pPath;
+		int numRequests;	//per connection
+		int depth;			//requests kept in flight per connection
+		int numSeeds;		//distinct mazes asked for, so batches can share them
+		MazeRequest request;
+		bool verify;
+	};
+
+	//--------------------------------------------------------------------------
+	// Name: struct LoadClient
+	// Desc: One connection's settings and results
+	//--------------------------------------------------------------------------
+	struct LoadClient
+	{
+		const LoadSettings* pSettings;
+		unsigned int seed;
+		Histogram latency;
+		int numReceived;
+		int numFailed;
+		Thread thread;
+	};
+
+	//--------------------------------------------------------------------------
+	// Name: Connect()
+	// Desc: Opens a blocking connection to the daemon
+	//--------------------------------------------------------------------------
+	int Connect( const char* pPath )
+	{
+		sockaddr_un address;
+		memset( &address, 0, sizeof( address ) );
+		address.sun_family = AF_UNIX;
+		if( strlen( pPath ) >= sizeof( address.sun_path ) )
+			return -1;
+		strcpy( address.sun_path, pPath );
+
+		const int socket = ::socket( AF_UNIX, SOCK_STREAM, 0 );
+		if( socket < 0 )
+			return -1;
+		if( connect( socket, (sockaddr*)( &address ), sizeof( address ) ) < 0 )
+		{
+			close( socket );
+			return -1;
+		}
+
+		return socket;
+	}
+
+	//--------------------------------------------------------------------------
+	// Name: SendAll()
+	// Desc: Writes a whole buffer to a blocking socket
+	//--------------------------------------------------------------------------
+	bool SendAll( const int socket, const vector< unsigned char >& buffer )
+	{
+		size_t sent = 0;
+		while( sent < buffer.size() )
+		{
+			const ssize_t count = send( socket, &buffer[ sent ], buffer.size() - sent, 0 );
+			if( count <= 0 )
+				return false;
+			sent += count;
+		}
+
+		return true;
+	}
+
+	//--------------------------------------------------------------------------
+	// Name: ReceiveMessage()
+	// Desc: Reads the next whole response body, buffering anything after it
+	//--------------------------------------------------------------------------
+	bool ReceiveMessage( const int socket, vector< unsigned char >& buffer,
+						 vector< unsigned char >& body )
+	{
+		for( ;; )
+		{
+			const int length = PeekMessageLength( buffer.empty() ? NULL : &buffer[ 0 ], buffer.size() );
+			if( length > PROTOCOL_MAX_MESSAGE )
+				return false;
+			if( length >= 0 && buffer.size() >= size_t( length ) + 4 )
+			{
+				body.assign( buffer.begin() + 4, buffer.begin() + 4 + length );
+				buffer.erase( buffer.begin(), buffer.begin() + 4 + length );
+				return true;
+			}
+
+			unsigned char chunk[ 1 << 14 ];
+			const ssize_t count = recv( socket, chunk, sizeof( chunk ), 0 );
+			if( count <= 0 )
+				return false;
+			buffer.insert( buffer.end(), chunk, chunk + count );
+		}
+	}
+
+	//--------------------------------------------------------------------------
+	// Name: CheckPath()
+	// Desc: Makes sure a solve response's path runs from the entrance through
+	//		 open squares to just outside its chosen exit
+	//--------------------------------------------------------------------------
+	bool CheckPath( const MazeResponse& response )
+	{
+		const vector< MazeSquare >& path = response.path;
+		if( ! response.hasMaze || path.size() < 3 ||
+			response.chosenExit >= int( response.exits.size() ) )
+			return false;
+
+		if( path[ 0 ].x != -1 || path[ 0 ].y != response.startY )
+			return false;
+		for( size_t i = 1; i + 1 < path.size(); ++i )
+		{
+			const MazeSquare& square = path[ i ];
+			if( square.x < 0 || square.x >= response.width ||
+				square.y < 0 || square.y >= response.height ||
+				! response.IsOpen( square.x, square.y ) )
+				return false;
+		}
+
+		const MazeSquare& exit = response.exits[ response.chosenExit ];
+		const MazeSquare& last = path[ path.size() - 2 ];
+		return last.x == exit.x && last.y == exit.y;
+	}
+
+	//--------------------------------------------------------------------------
+	// Name: RunClient()
+	// Desc: Keeps a connection's requests in flight until all are answered
+	//--------------------------------------------------------------------------
+	void RunClient( void* pClient )
+	{
+		LoadClient& client = *( (LoadClient*)( pClient ) );
+		const LoadSettings& settings = *client.pSettings;
+
+		const int socket = Connect( settings.pPath );
+		if( socket < 0 )
+		{
+			client.numFailed = settings.numRequests;
+			return;
+		}
+
+		vector< double > sendTimes( settings.numRequests );
+		vector< unsigned char > output;
+		vector< unsigned char > input;
+		vector< unsigned char > body;
+		MazeResponse response;
+
+		int numSent = 0;
+		while( client.numReceived + client.numFailed < settings.numRequests )
+		{
+			//top up the requests in flight
+			output.clear();
+			const double now = Timer::GetTime();
+			while( numSent < settings.numRequests &&
+				   numSent - client.numReceived - client.numFailed < settings.depth )
+			{
+				MazeRequest request = settings.request;
+				request.id = (unsigned int)( numSent );
+				request.seed = client.seed + (unsigned int)( numSent % settings.numSeeds );
+				WriteRequest( output, request );
+				sendTimes[ numSent++ ] = now;
+			}
+			if( ! output.empty() && ! SendAll( socket, output ) )
+				break;
+
+			if( ! ReceiveMessage( socket, input, body ) )
+				break;
+
+			if( ! ReadResponse( &body[ 0 ], body.size(), response ) ||
+				response.id >= (unsigned int)( numSent ) )
+			{
+				++client.numFailed;
+				continue;
+			}
+
+			client.latency.Record( Timer::GetTime() - sendTimes[ response.id ] );
+			if( STATUS_OK != response.status ||
+				( settings.verify && MESSAGE_SOLVE == response.type && ! CheckPath( response ) ) )
+				++client.numFailed;
+			else
+				++client.numReceived;
+		}
+
+		client.numFailed = settings.numRequests - client.numReceived;
+		close( socket );
+	}
+
+	//--------------------------------------------------------------------------
+	// Name: PrintServerStats()
+	// Desc: Asks the daemon for its own view of the run
+	//--------------------------------------------------------------------------
+	void PrintServerStats( const char* pPath )
+	{
+		const int socket = Connect( pPath );
+		if( socket < 0 )
+			return;
+
+		MazeRequest request;
+		request.type = MESSAGE_STATS;
+		vector< unsigned char > output;
+		WriteRequest( output, request );
+
+		vector< unsigned char > input;
+		vector< unsigned char > body;
+		MazeResponse response;
+		if( SendAll( socket, output ) && ReceiveMessage( socket, input, body ) &&
+			ReadResponse( &body[ 0 ], body.size(), response ) && STATUS_OK == response.status )
+		{
+			const unsigned int* pStats = response.stats;
+			printf( "server: %u requests in %u batches, %u from a shared maze, queue %u, peak %u\n",
+					pStats[ STAT_REQUESTS ], pStats[ STAT_BATCHES ], pStats[ STAT_MAZES_SHARED ],
+					pStats[ STAT_QUEUE_DEPTH ], pStats[ STAT_PEAK_QUEUE_DEPTH ] );
+			printf( "server latency us: p50 %u p90 %u p99 %u max %u\n", pStats[ STAT_LATENCY_P50 ],
+					pStats[ STAT_LATENCY_P90 ], pStats[ STAT_LATENCY_P99 ],
+					pStats[ STAT_LATENCY_MAX ] );
+		}
+
+		close( socket );
+	}
+
+	//--------------------------------------------------------------------------
+	// Name: PrintUsage()
+	// Desc: Explains the command line
+	//--------------------------------------------------------------------------
+	void PrintUsage()
+	{
+		fprintf( stderr, "usage: MazeLoadClient [-c connections] [-n requests per connection]\n"
+						 "                      [-d depth] [-s size] [-r distinct mazes]\n"
+						 "                      [-a solver] [-l (landmarks)] [-x exits]\n"
+						 "                      [-g (generate only)] [-v (verify)] socket\n" );
+	}
+}
+
+
+//------------------------------------------------------------------------------
+// Definitions:
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Name: main()
+// Desc: Runs the connections side by side and reports the round trip times
+//------------------------------------------------------------------------------
+int main( int argc, char* argv[] )
+{
+	int numConnections = 4;
+	int size = 64;
+
+	LoadSettings settings;
+	settings.pPath = NULL;
+	settings.numRequests = 1000;
+	settings.depth = 8;
+	settings.numSeeds = 16;
+	settings.request.type = MESSAGE_SOLVE;
+	settings.verify = false;
+
+	for( int i = 1; i < argc; ++i )
+	{
+		const bool hasValue = ( i + 1 < argc );
+		if( 0 == strcmp( argv[ i ], "-c" ) && hasValue )
+			numConnections = atoi( argv[ ++i ] );
+		else if( 0 == strcmp( argv[ i ], "-n" ) && hasValue )
+			settings.numRequests = atoi( argv[ ++i ] );
+		else if( 0 == strcmp( argv[ i ], "-d" ) && hasValue )
+			settings.depth = atoi( argv[ ++i ] );
+		else if( 0 == strcmp( argv[ i ], "-s" ) && hasValue )
+			size = atoi( argv[ ++i ] );
+		else if( 0 == strcmp( argv[ i ], "-r" ) && hasValue )
+			settings.numSeeds = atoi( argv[ ++i ] );
+		else if( 0 == strcmp( argv[ i ], "-a" ) && hasValue )
+			settings.request.solver = (unsigned char)( atoi( argv[ ++i ] ) );
+		else if( 0 == strcmp( argv[ i ], "-x" ) && hasValue )
+			settings.request.numExits = (unsigned char)( atoi( argv[ ++i ] ) );
+		else if( 0 == strcmp( argv[ i ], "-l" ) )
+			settings.request.heuristic = Grid::HEURISTIC_ALT;
+		else if( 0 == strcmp( argv[ i ], "-g" ) )
+			settings.request.type = MESSAGE_GENERATE;
+		else if( 0 == strcmp( argv[ i ], "-v" ) )
+			settings.verify = true;
+		else if( argv[ i ][ 0 ] != '-' && settings.pPath == NULL )
+			settings.pPath = argv[ i ];
+		else
+		{
+			PrintUsage();
+			return 1;
+		}
+	}
+
+	if( settings.pPath == NULL || numConnections < 1 || settings.numRequests < 1 ||
+		settings.depth < 1 || settings.numSeeds < 1 )
+	{
+		PrintUsage();
+		return 1;
+	}
+
+	settings.request.width = (unsigned short)( size );
+	settings.request.height = (unsigned short)( size );
+	if( settings.verify )
+		settings.request.flags |= FLAG_INCLUDE_MAZE;
+
+	vector< LoadClient* > clients;
+	const Timer timer;
+	for( int i = 0; i < numConnections; ++i )
+	{
+		LoadClient* pClient = new LoadClient;
+		pClient->pSettings = &settings;
+		pClient->seed = (unsigned int)( i ) * 7919u;
+		pClient->numReceived = 0;
+		pClient->numFailed = 0;
+		if( ! pClient->thread.Start( RunClient, pClient ) )
+			RunClient( pClient );
+		clients.push_back( pClient );
+	}
+
+	Histogram latency;
+	int numReceived = 0;
+	int numFailed = 0;
+	for( size_t i = 0; i < clients.size(); ++i )
+	{
+		clients[ i ]->thread.Join();
+		latency.Merge( clients[ i ]->latency );
+		numReceived += clients[ i ]->numReceived;
+		numFailed += clients[ i ]->numFailed;
+		delete clients[ i ];
+	}
+	const double seconds = timer.GetSeconds();
+
+	printf( "%d ok, %d failed in %.3f s - %.0f requests/s\n", numReceived, numFailed, seconds,
+			numReceived / ( ( seconds > 0.0 ) ? seconds : 1.0 ) );
+	printf( "round trip us: p50 %.0f p90 %.0f p99 %.0f max %.0f\n",
+			latency.GetPercentile( 50.0 ) * 1.0e6, latency.GetPercentile( 90.0 ) * 1.0e6,
+			latency.GetPercentile( 99.0 ) * 1.0e6, latency.GetMax() * 1.0e6 );
+
+	PrintServerStats( settings.pPath );
+
+	return ( 0 == numFailed ) ? 0 : 1;
+}
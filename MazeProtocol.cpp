@@ -0,0 +1,243 @@
+//------------------------------------------------------------------------------
+// File: MazeProtocol.cpp
+// Desc: Binary messages exchanged with the maze daemon
+//
+// Created: 19 October 2026 23:10:18
+//
+// (c)2002 Neil Wakefield
+//------------------------------------------------------------------------------
+
+
+//------------------------------------------------------------------------------
+// Included files:
+//------------------------------------------------------------------------------
+#include "MazeProtocol.h"
+
+
+//------------------------------------------------------------------------------
+// Globals:
+//------------------------------------------------------------------------------
+namespace
+{
+	//offsets for each step, in the order of Grid::Direction
+	const int g_moveX[ 4 ] = { 0, 1, 0, -1 };
+	const int g_moveY[ 4 ] = { 1, 0, -1, 0 };
+}
+
+
+//------------------------------------------------------------------------------
+// Definitions:
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Name: PutBits()
+// Desc: Appends the low bits of a value, flushing whole bytes as they fill
+//------------------------------------------------------------------------------
+void MessageWriter::PutBits( const unsigned int value, const int numBits )
+{
+	m_bits |= ( value & ( ( 1u << numBits ) - 1 ) ) << m_numBits;
+	m_numBits += numBits;
+
+	while( m_numBits >= 8 )
+	{
+		PutU8( m_bits );
+		m_bits >>= 8;
+		m_numBits -= 8;
+	}
+}
+
+//------------------------------------------------------------------------------
+// Name: FlushBits()
+// Desc: Writes out a part-filled byte, padded with zeroes
+//------------------------------------------------------------------------------
+void MessageWriter::FlushBits()
+{
+	if( m_numBits > 0 )
+		PutU8( m_bits );
+
+	m_bits = 0;
+	m_numBits = 0;
+}
+
+//------------------------------------------------------------------------------
+// Name: PatchU32()
+// Desc: Overwrites four bytes already written
+//------------------------------------------------------------------------------
+void MessageWriter::PatchU32( const size_t offset, const unsigned int value )
+{
+	for( int i = 0; i < 4; ++i )
+		m_buffer[ offset + i ] = (unsigned char)( value >> ( 8 * i ) );
+}
+
+//------------------------------------------------------------------------------
+// Name: GetU8()
+// Desc: Reads one byte, or fails the reader at the end of the message
+//------------------------------------------------------------------------------
+unsigned int MessageReader::GetU8()
+{
+	if( m_offset >= m_size )
+	{
+		m_valid = false;
+		return 0;
+	}
+
+	return m_pData[ m_offset++ ];
+}
+
+//------------------------------------------------------------------------------
+// Name: GetBits()
+// Desc: Reads a value packed by MessageWriter::PutBits
+//------------------------------------------------------------------------------
+unsigned int MessageReader::GetBits( const int numBits )
+{
+	while( m_numBits < numBits )
+	{
+		m_bits |= GetU8() << m_numBits;
+		m_numBits += 8;
+	}
+
+	const unsigned int value = m_bits & ( ( 1u << numBits ) - 1 );
+	m_bits >>= numBits;
+	m_numBits -= numBits;
+
+	return value;
+}
+
+//------------------------------------------------------------------------------
+// Name: PeekMessageLength()
+// Desc: Reads the length in front of a message body
+//------------------------------------------------------------------------------
+int PeekMessageLength( const unsigned char* pData, const size_t size )
+{
+	if( size < 4 )
+		return -1;
+
+	MessageReader reader( pData, 4 );
+	const unsigned int length = reader.GetU32();
+	return ( length > (unsigned int)( PROTOCOL_MAX_MESSAGE ) ) ? PROTOCOL_MAX_MESSAGE + 1
+															   : int( length );
+}
+
+//------------------------------------------------------------------------------
+// Name: WriteRequest()
+// Desc: Appends a request, with its length, to a send buffer
+//------------------------------------------------------------------------------
+void WriteRequest( vector< unsigned char >& buffer, const MazeRequest& request )
+{
+	MessageWriter writer( buffer );
+	writer.PutU32( MazeRequest::REQUEST_BYTES );
+	writer.PutU32( request.id );
+	writer.PutU8( request.type );
+	writer.PutU8( request.solver );
+	writer.PutU8( request.heuristic );
+	writer.PutU8( request.flags );
+	writer.PutU16( request.width );
+	writer.PutU16( request.height );
+	writer.PutU32( request.seed );
+	writer.PutU8( request.numExits );
+	writer.PutU8( request.braid );
+	writer.PutU16( 0 );
+}
+
+//------------------------------------------------------------------------------
+// Name: ReadRequest()
+// Desc: Decodes a request body. Only the framing is checked here - the
+//		 daemon decides whether the fields make sense
+//------------------------------------------------------------------------------
+bool ReadRequest( const unsigned char* pBody, const size_t size, MazeRequest& request )
+{
+	if( size != MazeRequest::REQUEST_BYTES )
+		return false;
+
+	MessageReader reader( pBody, size );
+	request.id = reader.GetU32();
+	request.type = (unsigned char)( reader.GetU8() );
+	request.solver = (unsigned char)( reader.GetU8() );
+	request.heuristic = (unsigned char)( reader.GetU8() );
+	request.flags = (unsigned char)( reader.GetU8() );
+	request.width = (unsigned short)( reader.GetU16() );
+	request.height = (unsigned short)( reader.GetU16() );
+	request.seed = reader.GetU32();
+	request.numExits = (unsigned char)( reader.GetU8() );
+	request.braid = (unsigned char)( reader.GetU8() );
+	reader.GetU16();
+
+	return reader.IsValid();
+}
+
+//------------------------------------------------------------------------------
+// Name: ReadResponse()
+// Desc: Decodes a response body, unpacking the path into squares
+//------------------------------------------------------------------------------
+bool ReadResponse( const unsigned char* pBody, const size_t size, MazeResponse& response )
+{
+	MessageReader reader( pBody, size );
+	response.id = reader.GetU32();
+	response.status = (unsigned char)( reader.GetU8() );
+	response.type = (unsigned char)( reader.GetU8() );
+	response.flags = (unsigned char)( reader.GetU8() );
+	response.hasMaze = false;
+	response.hasPath = false;
+	response.exits.clear();
+	response.openBits.clear();
+	response.path.clear();
+	for( int i = 0; i < MAX_STATS; ++i )
+		response.stats[ i ] = 0;
+
+	if( ! reader.IsValid() || STATUS_OK != response.status )
+		return reader.IsValid();
+
+	if( MESSAGE_STATS == response.type )
+	{
+		for( int i = 0; i < MAX_STATS; ++i )
+			response.stats[ i ] = reader.GetU32();
+		return reader.IsValid();
+	}
+
+	response.hasMaze = ( 0 != ( response.flags & FLAG_INCLUDE_MAZE ) );
+	if( response.hasMaze )
+	{
+		response.width = int( reader.GetU16() );
+		response.height = int( reader.GetU16() );
+		response.startY = int( reader.GetU16() );
+		const int numExits = int( reader.GetU8() );
+		for( int i = 0; i < numExits; ++i )
+		{
+			const int x = int( reader.GetU16() );
+			response.exits.push_back( MazeSquare( x, int( reader.GetU16() ) ) );
+		}
+
+		const size_t numBytes = ( size_t( response.width ) * response.height + 7 ) / 8;
+		if( numBytes > reader.GetRemaining() )
+			return false;
+
+		response.openBits.resize( numBytes );
+		for( size_t i = 0; i < numBytes; ++i )
+			response.openBits[ i ] = (unsigned char)( reader.GetU8() );
+	}
+
+	if( MESSAGE_SOLVE == response.type )
+	{
+		response.hasPath = true;
+		response.cost = reader.GetU32();
+		response.chosenExit = int( reader.GetU8() );
+		const unsigned int numSteps = reader.GetU32();
+		int x = short( reader.GetU16() );
+		int y = short( reader.GetU16() );
+		if( numSteps > 4 * reader.GetRemaining() )
+			return false;
+
+		response.path.reserve( numSteps + 1 );
+		response.path.push_back( MazeSquare( x, y ) );
+		for( unsigned int i = 0; i < numSteps; ++i )
+		{
+			const int d = int( reader.GetBits( 2 ) );
+			x += g_moveX[ d ];
+			y += g_moveY[ d ];
+			response.path.push_back( MazeSquare( x, y ) );
+		}
+		reader.AlignBits();
+	}
+
+	return reader.IsValid() && 0 == reader.GetRemaining();
+}
@@ -0,0 +1,199 @@
+//------------------------------------------------------------------------------
+// File: MazeProtocol.h
+// Desc: Binary messages exchanged with the maze daemon
+//
+// Created: 19 October 2026 23:02:41
+//
+// (c)2002 Neil Wakefield
+//------------------------------------------------------------------------------
+
+
+#ifndef INCLUSIONGUARD_MAZEPROTOCOL_H
+#define INCLUSIONGUARD_MAZEPROTOCOL_H
+
+
+//------------------------------------------------------------------------------
+// Included files:
+//------------------------------------------------------------------------------
+#include "Grid.h"
+
+#include <vector>
+using namespace std;
+
+
+//------------------------------------------------------------------------------
+// Prototypes and declarations:
+//
+// Every message is a little-endian 32 bit body length followed by the body.
+// A request body is always REQUEST_BYTES long:
+//
+//	u32 id, u8 type, u8 solver, u8 heuristic, u8 flags,
+//	u16 width, u16 height, u32 seed, u8 numExits, u8 braid, u16 reserved
+//
+// A response body starts with u32 id, u8 status, u8 type, u8 flags, the last
+// three echoing the request. A successful generate or solve then carries the
+// maze if it was asked for:
+//
+//	u16 width, u16 height, u16 startY, u8 numExits, numExits * ( u16 x, u16 y ),
+//	one bit per cell in row-major order, set for open cells
+//
+// and a successful solve carries the path after that:
+//
+//	u32 cost, u8 chosenExit, u32 numSteps, s16 x, s16 y of the square outside
+//	the entrance, then two bits per step in the order of Grid::Direction
+//
+// A stats response carries MAX_STATS u32 values indexed by StatIndex
+//------------------------------------------------------------------------------
+const int PROTOCOL_MAX_MESSAGE = 1 << 24;	//largest body either side accepts
+const int PROTOCOL_MAX_SIZE = 4096;			//largest maze side the daemon builds
+
+enum MessageType { MESSAGE_GENERATE = 1, MESSAGE_SOLVE, MESSAGE_STATS };
+enum MessageStatus { STATUS_OK, STATUS_BAD_REQUEST, STATUS_UNSOLVABLE };
+enum MessageFlags { FLAG_INCLUDE_MAZE = 1 };
+
+enum StatIndex
+{
+	STAT_QUEUE_DEPTH,
+	STAT_PEAK_QUEUE_DEPTH,
+	STAT_REQUESTS,
+	STAT_BATCHES,
+	STAT_MAZES_SHARED,	//requests served from a maze already built in the batch
+	STAT_LATENCY_P50,	//microseconds from arrival to response
+	STAT_LATENCY_P90,
+	STAT_LATENCY_P99,
+	STAT_LATENCY_MAX,
+	MAX_STATS
+};
+
+//------------------------------------------------------------------------------
+// Name: struct MazeRequest
+// Desc: A single request as it appears on the wire. The braid factor is
+//		 sent in 255ths
+//------------------------------------------------------------------------------
+struct MazeRequest
+{
+	MazeRequest() : id( 0 ), type( MESSAGE_GENERATE ), solver( Grid::SOLVER_ASTAR ),
+					heuristic( Grid::HEURISTIC_MANHATTAN ), flags( 0 ), width( 0 ),
+					height( 0 ), seed( 0 ), numExits( 1 ), braid( 0 ) {}
+
+	enum { REQUEST_BYTES = 20 };
+
+	unsigned int id;
+	unsigned char type;
+	unsigned char solver;
+	unsigned char heuristic;
+	unsigned char flags;
+	unsigned short width;
+	unsigned short height;
+	unsigned int seed;
+	unsigned char numExits;
+	unsigned char braid;
+};
+
+//------------------------------------------------------------------------------
+// Name: struct MazeResponse
+// Desc: A response decoded by a client
+//------------------------------------------------------------------------------
+struct MazeResponse
+{
+	unsigned int id;
+	unsigned char status;
+	unsigned char type;
+	unsigned char flags;
+
+	bool hasMaze;
+	int width;
+	int height;
+	int startY;
+	vector< MazeSquare > exits;
+	vector< unsigned char > openBits;
+
+	bool hasPath;
+	unsigned int cost;
+	int chosenExit;
+	vector< MazeSquare > path;	//from just outside the entrance
+
+	unsigned int stats[ MAX_STATS ];
+
+	bool IsOpen( const int x, const int y ) const
+	{
+		const int cell = y * width + x;
+		return 0 != ( openBits[ cell >> 3 ] & ( 1 << ( cell & 7 ) ) );
+	}
+};
+
+//------------------------------------------------------------------------------
+// Name: class MessageWriter
+// Desc: Appends little-endian fields to a message body
+//------------------------------------------------------------------------------
+class MessageWriter
+{
+
+public:
+	MessageWriter( vector< unsigned char >& buffer )
+		: m_buffer( buffer ), m_bits( 0 ), m_numBits( 0 ) {}
+
+	void PutU8( const unsigned int value ) { m_buffer.push_back( (unsigned char)( value ) ); }
+	void PutU16( const unsigned int value ) { PutU8( value ); PutU8( value >> 8 ); }
+	void PutU32( const unsigned int value ) { PutU16( value ); PutU16( value >> 16 ); }
+
+	//packs values of a few bits each, low bits first, padding the last byte
+	void PutBits( const unsigned int value, const int numBits );
+	void FlushBits();
+
+	size_t GetSize() const { return m_buffer.size(); }
+
+	//fills in a length reserved with a PutU32 at offset
+	void PatchU32( const size_t offset, const unsigned int value );
+
+private:
+	vector< unsigned char >& m_buffer;
+	unsigned int m_bits;
+	int m_numBits;
+
+	MessageWriter& operator=( const MessageWriter& );
+
+};
+
+//------------------------------------------------------------------------------
+// Name: class MessageReader
+// Desc: Reads little-endian fields from a message body. Reading past the end
+//		 returns zeroes and leaves the reader failed, so a whole message can be
+//		 decoded before checking IsValid once
+//------------------------------------------------------------------------------
+class MessageReader
+{
+
+public:
+	MessageReader( const unsigned char* pData, const size_t size )
+		: m_pData( pData ), m_size( size ), m_offset( 0 ), m_valid( true ), m_bits( 0 ),
+		  m_numBits( 0 ) {}
+
+	unsigned int GetU8();
+	unsigned int GetU16() { const unsigned int low = GetU8(); return low | ( GetU8() << 8 ); }
+	unsigned int GetU32() { const unsigned int low = GetU16(); return low | ( GetU16() << 16 ); }
+	unsigned int GetBits( const int numBits );
+	void AlignBits() { m_bits = 0; m_numBits = 0; }	//drops the rest of a part-read byte
+
+	bool IsValid() const { return m_valid; }
+	size_t GetRemaining() const { return m_size - m_offset; }
+
+private:
+	const unsigned char* m_pData;
+	size_t m_size;
+	size_t m_offset;
+	bool m_valid;
+	unsigned int m_bits;
+	int m_numBits;
+
+};
+
+void WriteRequest( vector< unsigned char >& buffer, const MazeRequest& request );
+bool ReadRequest( const unsigned char* pBody, const size_t size, MazeRequest& request );
+bool ReadResponse( const unsigned char* pBody, const size_t size, MazeResponse& response );
+
+//reads a length prefix, or returns -1 if fewer than four bytes are there
+int PeekMessageLength( const unsigned char* pData, const size_t size );
+
+
+#endif //INCLUSIONGUARD_MAZEPROTOCOL_H
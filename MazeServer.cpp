@@ -0,0 +1,727 @@
+//------------------------------------------------------------------------------
+// File: MazeServer.cpp
+// Desc: Headless maze daemon serving requests over a Unix domain socket
+//
+// Created: 19 October 2026 23:41:03
+//
+// (c)2002 Neil Wakefield
+//------------------------------------------------------------------------------
+
+
+//------------------------------------------------------------------------------
+// Included files:
+//------------------------------------------------------------------------------
+#include "MazeServer.h"
+#include "Grid.h"
+#include "SolutionCache.h"
+#include "Timer.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <algorithm>
+
+
+//------------------------------------------------------------------------------
+// Globals:
+//------------------------------------------------------------------------------
+namespace
+{
+	const int g_receiveChunk = 1 << 16;
+
+#ifdef MSG_NOSIGNAL
+	const int g_sendFlags = MSG_NOSIGNAL;
+#else
+	const int g_sendFlags = 0;	//the daemon ignores SIGPIPE instead
+#endif
+
+	//--------------------------------------------------------------------------
+	// Name: SetNonBlocking()
+	// Desc: Stops reads and writes on a descriptor from waiting
+	//--------------------------------------------------------------------------
+	bool SetNonBlocking( const int descriptor )
+	{
+		const int flags = fcntl( descriptor, F_GETFL, 0 );
+		return flags >= 0 && fcntl( descriptor, F_SETFL, flags | O_NONBLOCK ) >= 0;
+	}
+
+	//--------------------------------------------------------------------------
+	// Name: IsValidRequest()
+	// Desc: Checks that a generate or solve request asks for something Grid
+	//		 can build
+	//--------------------------------------------------------------------------
+	bool IsValidRequest( const MazeRequest& request )
+	{
+		if( MESSAGE_GENERATE != request.type && MESSAGE_SOLVE != request.type )
+			return false;
+		if( request.width < 2 || request.width > PROTOCOL_MAX_SIZE ||
+			request.height < 2 || request.height > PROTOCOL_MAX_SIZE )
+			return false;
+		if( request.solver > Grid::SOLVER_PARALLEL || request.heuristic > Grid::HEURISTIC_ALT )
+			return false;
+
+		return request.numExits >= 1;
+	}
+
+	//--------------------------------------------------------------------------
+	// Name: SameMaze()
+	// Desc: Checks whether two requests describe the same maze
+	//--------------------------------------------------------------------------
+	bool SameMaze( const MazeRequest& a, const MazeRequest& b )
+	{
+		return a.width == b.width && a.height == b.height && a.seed == b.seed &&
+			   a.numExits == b.numExits && a.braid == b.braid;
+	}
+
+	//--------------------------------------------------------------------------
+	// Name: WriteHeader()
+	// Desc: Starts a response, leaving room for its length at the front
+	//--------------------------------------------------------------------------
+	void WriteHeader( MessageWriter& writer, const MazeRequest& request, const int status )
+	{
+		writer.PutU32( 0 );
+		writer.PutU32( request.id );
+		writer.PutU8( status );
+		writer.PutU8( request.type );
+		writer.PutU8( request.flags );
+	}
+}
+
+
+//------------------------------------------------------------------------------
+// Definitions:
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Name: MazeServer()
+// Desc: Constructor for the server object
+//------------------------------------------------------------------------------
+MazeServer::MazeServer()
+{
+	m_listenSocket = -1;
+	m_wakePipe[ 0 ] = -1;
+	m_wakePipe[ 1 ] = -1;
+	m_stopping = 0;
+
+	m_numWorkers = GetNumProcessors();
+	m_maxBatch = 32;
+	m_batchWindow = 0.0005;
+
+	m_nextConnection = 0;
+	m_fillingStart = 0.0;
+
+	pthread_mutex_init( &m_lock, NULL );
+	pthread_cond_init( &m_batchReady, NULL );
+	m_queueDepth = 0;
+	m_peakQueueDepth = 0;
+	m_numRequests = 0;
+	m_numBatches = 0;
+	m_numShared = 0;
+}
+
+//------------------------------------------------------------------------------
+// Name: ~MazeServer()
+// Desc: Destructor for the server object
+//------------------------------------------------------------------------------
+MazeServer::~MazeServer()
+{
+	Close();
+
+	pthread_cond_destroy( &m_batchReady );
+	pthread_mutex_destroy( &m_lock );
+}
+
+//------------------------------------------------------------------------------
+// Name: Open()
+// Desc: Starts listening on a socket path, replacing anything already there
+//------------------------------------------------------------------------------
+bool MazeServer::Open( const char* pPath )
+{
+	Close();
+
+	sockaddr_un address;
+	memset( &address, 0, sizeof( address ) );
+	address.sun_family = AF_UNIX;
+	if( strlen( pPath ) >= sizeof( address.sun_path ) )
+		return false;
+	strcpy( address.sun_path, pPath );
+
+	if( pipe( m_wakePipe ) < 0 )
+	{
+		m_wakePipe[ 0 ] = m_wakePipe[ 1 ] = -1;
+		return false;
+	}
+	SetNonBlocking( m_wakePipe[ 0 ] );
+	SetNonBlocking( m_wakePipe[ 1 ] );
+
+	m_listenSocket = socket( AF_UNIX, SOCK_STREAM, 0 );
+	if( m_listenSocket < 0 )
+	{
+		Close();
+		return false;
+	}
+
+	unlink( pPath );
+	if( bind( m_listenSocket, (sockaddr*)( &address ), sizeof( address ) ) < 0 ||
+		listen( m_listenSocket, SOMAXCONN ) < 0 || ! SetNonBlocking( m_listenSocket ) )
+	{
+		Close();
+		return false;
+	}
+
+	m_path = pPath;
+	return true;
+}
+
+//------------------------------------------------------------------------------
+// Name: Close()
+// Desc: Drops every connection and removes the socket
+//------------------------------------------------------------------------------
+void MazeServer::Close()
+{
+	map< unsigned int, Connection >::iterator iter;
+	for( iter = m_connections.begin(); iter != m_connections.end(); ++iter )
+		close( iter->second.socket );
+	m_connections.clear();
+
+	if( m_listenSocket >= 0 )
+	{
+		close( m_listenSocket );
+		unlink( m_path.c_str() );
+		m_listenSocket = -1;
+	}
+
+	for( int i = 0; i < 2; ++i )
+	{
+		if( m_wakePipe[ i ] >= 0 )
+			close( m_wakePipe[ i ] );
+		m_wakePipe[ i ] = -1;
+	}
+}
+
+//------------------------------------------------------------------------------
+// Name: Stop()
+// Desc: Asks Run to return. Only sets a flag and writes to a pipe, so it may
+//		 be called from a signal handler
+//------------------------------------------------------------------------------
+void MazeServer::Stop()
+{
+	m_stopping = 1;
+
+	const char wake = 0;
+	if( m_wakePipe[ 1 ] >= 0 )
+		write( m_wakePipe[ 1 ], &wake, 1 );
+}
+
+//------------------------------------------------------------------------------
+// Name: GetStats()
+// Desc: Fills in MAX_STATS values indexed by StatIndex
+//------------------------------------------------------------------------------
+void MazeServer::GetStats( unsigned int* pStats )
+{
+	pthread_mutex_lock( &m_lock );
+
+	pStats[ STAT_QUEUE_DEPTH ] = (unsigned int)( m_queueDepth );
+	pStats[ STAT_PEAK_QUEUE_DEPTH ] = (unsigned int)( m_peakQueueDepth );
+	pStats[ STAT_REQUESTS ] = m_numRequests;
+	pStats[ STAT_BATCHES ] = m_numBatches;
+	pStats[ STAT_MAZES_SHARED ] = m_numShared;
+	pStats[ STAT_LATENCY_P50 ] = (unsigned int)( m_latency.GetPercentile( 50.0 ) * 1.0e6 + 0.5 );
+	pStats[ STAT_LATENCY_P90 ] = (unsigned int)( m_latency.GetPercentile( 90.0 ) * 1.0e6 + 0.5 );
+	pStats[ STAT_LATENCY_P99 ] = (unsigned int)( m_latency.GetPercentile( 99.0 ) * 1.0e6 + 0.5 );
+	pStats[ STAT_LATENCY_MAX ] = (unsigned int)( m_latency.GetMax() * 1.0e6 + 0.5 );
+
+	pthread_mutex_unlock( &m_lock );
+}
+
+//------------------------------------------------------------------------------
+// Name: Run()
+// Desc: Starts the workers and serves the socket until Stop is called. The
+//		 workers finish any batches already queued before this returns
+//------------------------------------------------------------------------------
+void MazeServer::Run()
+{
+	if( m_listenSocket < 0 )
+		return;
+
+	vector< Worker* > workers;
+	for( int i = 0; i < m_numWorkers; ++i )
+	{
+		Worker* pWorker = new Worker;
+		pWorker->pServer = this;
+		pWorker->pGrid = NULL;
+		pWorker->hasMaze = false;
+		pWorker->pCache = new SolutionCache( CONST_SOLUTION_CACHE_BYTES );
+		if( ! pWorker->thread.Start( WorkerMain, pWorker ) )
+		{
+			delete pWorker->pCache;
+			delete pWorker;
+			break;
+		}
+		workers.push_back( pWorker );
+	}
+
+	vector< pollfd > polls;
+	vector< unsigned int > pollConnections;
+	while( ! m_stopping && ! workers.empty() )
+	{
+		polls.clear();
+		pollConnections.clear();
+
+		pollfd entry;
+		entry.fd = m_listenSocket;
+		entry.events = POLLIN;
+		entry.revents = 0;
+		polls.push_back( entry );
+		entry.fd = m_wakePipe[ 0 ];
+		polls.push_back( entry );
+
+		map< unsigned int, Connection >::iterator iter;
+		for( iter = m_connections.begin(); iter != m_connections.end(); ++iter )
+		{
+			entry.fd = iter->second.socket;
+			entry.events = POLLIN;
+			if( iter->second.outputSent < iter->second.output.size() )
+				entry.events |= POLLOUT;
+			polls.push_back( entry );
+			pollConnections.push_back( iter->first );
+		}
+
+		//wake in time to send off a part-filled batch
+		int timeout = -1;
+		if( ! m_filling.empty() )
+		{
+			const double remaining = m_fillingStart + m_batchWindow - Timer::GetTime();
+			timeout = ( remaining > 0.0 ) ? int( remaining * 1000.0 ) + 1 : 0;
+		}
+
+		if( poll( &polls[ 0 ], polls.size(), timeout ) < 0 && EINTR != errno )
+			break;
+
+		if( polls[ 1 ].revents & POLLIN )
+		{
+			char drain[ 64 ];
+			while( read( m_wakePipe[ 0 ], drain, sizeof( drain ) ) > 0 )
+				;
+		}
+
+		for( size_t i = 0; i < pollConnections.size(); ++i )
+		{
+			const short events = polls[ i + 2 ].revents;
+			if( 0 == events )
+				continue;
+
+			const unsigned int id = pollConnections[ i ];
+			Connection& connection = m_connections[ id ];
+			bool open = true;
+			if( events & ( POLLIN | POLLHUP | POLLERR ) )
+				open = Receive( connection, id );
+			if( open && ( events & POLLOUT ) )
+				open = Send( connection );
+
+			if( ! open )
+			{
+				close( connection.socket );
+				m_connections.erase( id );
+			}
+		}
+
+		if( polls[ 0 ].revents & POLLIN )
+			Accept();
+
+		//requests read in the same pass always share a batch, and the window
+		// lets a few more catch up
+		if( ! m_filling.empty() && Timer::GetTime() - m_fillingStart >= m_batchWindow )
+			FlushBatch();
+
+		CollectResponses();
+	}
+
+	FlushBatch();
+
+	pthread_mutex_lock( &m_lock );
+	m_stopping = 1;
+	pthread_cond_broadcast( &m_batchReady );
+	pthread_mutex_unlock( &m_lock );
+
+	for( size_t i = 0; i < workers.size(); ++i )
+	{
+		workers[ i ]->thread.Join();
+		delete workers[ i ]->pGrid;
+		delete workers[ i ]->pCache;
+		delete workers[ i ];
+	}
+}
+
+//------------------------------------------------------------------------------
+// Name: Accept()
+// Desc: Takes every connection waiting on the listening socket
+//------------------------------------------------------------------------------
+void MazeServer::Accept()
+{
+	for( ;; )
+	{
+		const int socket = accept( m_listenSocket, NULL, NULL );
+		if( socket < 0 )
+			return;
+
+		if( ! SetNonBlocking( socket ) )
+		{
+			close( socket );
+			continue;
+		}
+
+		Connection& connection = m_connections[ m_nextConnection++ ];
+		connection.socket = socket;
+		connection.outputSent = 0;
+	}
+}
+
+//------------------------------------------------------------------------------
+// Name: Receive()
+// Desc: Reads whatever a connection has sent and queues each whole request.
+//		 Returns false once the connection should be closed
+//------------------------------------------------------------------------------
+bool MazeServer::Receive( Connection& connection, const unsigned int id )
+{
+	bool open = true;
+	for( ;; )
+	{
+		const size_t used = connection.input.size();
+		connection.input.resize( used + g_receiveChunk );
+		const ssize_t received = recv( connection.socket, &connection.input[ used ],
+									   g_receiveChunk, 0 );
+		connection.input.resize( used + ( ( received > 0 ) ? received : 0 ) );
+
+		if( received > 0 )
+			continue;
+		if( received < 0 && ( EAGAIN == errno || EWOULDBLOCK == errno || EINTR == errno ) )
+			break;
+
+		//closed or failed - anything it sent is still queued, but the answers
+		// will have nowhere to go
+		open = false;
+		break;
+	}
+
+	const double now = Timer::GetTime();
+	size_t offset = 0;
+	for( ;; )
+	{
+		const unsigned char* pData = connection.input.empty() ? NULL : &connection.input[ offset ];
+		const size_t available = connection.input.size() - offset;
+		const int length = PeekMessageLength( pData, available );
+		if( length < 0 || size_t( length ) + 4 > available )
+		{
+			//a body too big to ever accept can't be skipped safely
+			if( length > PROTOCOL_MAX_MESSAGE )
+				return false;
+			break;
+		}
+
+		Job job;
+		if( ! ReadRequest( pData + 4, length, job.request ) )
+			return false;
+		offset += 4 + length;
+
+		if( MESSAGE_STATS == job.request.type )
+		{
+			unsigned int stats[ MAX_STATS ];
+			GetStats( stats );
+
+			MessageWriter writer( connection.output );
+			const size_t start = writer.GetSize();
+			WriteHeader( writer, job.request, STATUS_OK );
+			for( int i = 0; i < MAX_STATS; ++i )
+				writer.PutU32( stats[ i ] );
+			writer.PatchU32( start, (unsigned int)( writer.GetSize() - start - 4 ) );
+			continue;
+		}
+
+		job.connection = id;
+		job.arrival = now;
+		Submit( job );
+	}
+	connection.input.erase( connection.input.begin(), connection.input.begin() + offset );
+
+	//stats answers go straight back
+	return open && Send( connection );
+}
+
+//------------------------------------------------------------------------------
+// Name: Send()
+// Desc: Writes as much waiting output as the socket takes. Returns false if
+//		 the connection has failed
+//------------------------------------------------------------------------------
+bool MazeServer::Send( Connection& connection )
+{
+	while( connection.outputSent < connection.output.size() )
+	{
+		const ssize_t sent = send( connection.socket, &connection.output[ connection.outputSent ],
+								   connection.output.size() - connection.outputSent, g_sendFlags );
+		if( sent < 0 )
+			return ( EAGAIN == errno || EWOULDBLOCK == errno || EINTR == errno );
+
+		connection.outputSent += sent;
+	}
+
+	connection.output.clear();
+	connection.outputSent = 0;
+	return true;
+}
+
+//------------------------------------------------------------------------------
+// Name: Submit()
+// Desc: Adds a request to the batch being filled, sending the batch off
+//		 once it is full
+//------------------------------------------------------------------------------
+void MazeServer::Submit( const Job& job )
+{
+	if( m_filling.empty() )
+		m_fillingStart = job.arrival;
+	m_filling.push_back( job );
+
+	pthread_mutex_lock( &m_lock );
+	++m_numRequests;
+	++m_queueDepth;
+	if( m_queueDepth > m_peakQueueDepth )
+		m_peakQueueDepth = m_queueDepth;
+	pthread_mutex_unlock( &m_lock );
+
+	if( int( m_filling.size() ) >= m_maxBatch )
+		FlushBatch();
+}
+
+//------------------------------------------------------------------------------
+// Name: FlushBatch()
+// Desc: Hands the batch being filled to the workers
+//------------------------------------------------------------------------------
+void MazeServer::FlushBatch()
+{
+	if( m_filling.empty() )
+		return;
+
+	pthread_mutex_lock( &m_lock );
+	m_batches.push_back( Batch() );
+	m_batches.back().swap( m_filling );
+	++m_numBatches;
+	pthread_cond_signal( &m_batchReady );
+	pthread_mutex_unlock( &m_lock );
+}
+
+//------------------------------------------------------------------------------
+// Name: CollectResponses()
+// Desc: Moves finished responses onto their connections and starts sending
+//		 them. Responses for connections that have gone are dropped
+//------------------------------------------------------------------------------
+void MazeServer::CollectResponses()
+{
+	vector< Response > responses;
+	pthread_mutex_lock( &m_lock );
+	responses.swap( m_responses );
+	pthread_mutex_unlock( &m_lock );
+
+	for( size_t i = 0; i < responses.size(); ++i )
+	{
+		map< unsigned int, Connection >::iterator iter = m_connections.find( responses[ i ].connection );
+		if( iter == m_connections.end() )
+			continue;
+
+		vector< unsigned char >& output = iter->second.output;
+		output.insert( output.end(), responses[ i ].message.begin(), responses[ i ].message.end() );
+	}
+
+	map< unsigned int, Connection >::iterator iter = m_connections.begin();
+	while( iter != m_connections.end() )
+	{
+		if( iter->second.outputSent < iter->second.output.size() && ! Send( iter->second ) )
+		{
+			close( iter->second.socket );
+			m_connections.erase( iter++ );
+		}
+		else
+			++iter;
+	}
+}
+
+//------------------------------------------------------------------------------
+// Name: WorkerMain()
+// Desc: Serves batches until the server stops and the queue is empty
+//------------------------------------------------------------------------------
+void MazeServer::WorkerMain( void* pWorker )
+{
+	Worker& worker = *( (Worker*)( pWorker ) );
+	MazeServer& server = *worker.pServer;
+
+	for( ;; )
+	{
+		Batch batch;
+
+		pthread_mutex_lock( &server.m_lock );
+		while( ! server.m_stopping && server.m_batches.empty() )
+			pthread_cond_wait( &server.m_batchReady, &server.m_lock );
+		if( server.m_batches.empty() )
+		{
+			pthread_mutex_unlock( &server.m_lock );
+			return;
+		}
+		batch.swap( server.m_batches.front() );
+		server.m_batches.pop_front();
+		server.m_queueDepth -= int( batch.size() );
+		pthread_mutex_unlock( &server.m_lock );
+
+		server.ServeBatch( worker, batch );
+	}
+}
+
+//------------------------------------------------------------------------------
+// Name: ServeBatch()
+// Desc: Answers every request in a batch, building each distinct maze once
+//------------------------------------------------------------------------------
+void MazeServer::ServeBatch( Worker& worker, Batch& batch )
+{
+	//bring requests for the same maze together, keeping their order otherwise
+	for( size_t i = 1; i < batch.size(); ++i )
+	{
+		size_t match = i;
+		for( size_t j = 0; j < i && match == i; ++j )
+			if( SameMaze( batch[ j ].request, batch[ i ].request ) )
+				match = j;
+		if( match == i )
+			continue;
+
+		while( match + 1 < i && SameMaze( batch[ match + 1 ].request, batch[ i ].request ) )
+			++match;
+		rotate( batch.begin() + match + 1, batch.begin() + i, batch.begin() + i + 1 );
+	}
+
+	vector< Response > responses( batch.size() );
+	vector< double > latencies( batch.size() );
+	unsigned int numShared = 0;
+	for( size_t i = 0; i < batch.size(); ++i )
+	{
+		if( i > 0 && SameMaze( batch[ i - 1 ].request, batch[ i ].request ) &&
+			IsValidRequest( batch[ i ].request ) )
+			++numShared;
+
+		responses[ i ].connection = batch[ i ].connection;
+		ServeJob( worker, batch[ i ], responses[ i ].message );
+		latencies[ i ] = Timer::GetTime() - batch[ i ].arrival;
+	}
+
+	pthread_mutex_lock( &m_lock );
+	for( size_t i = 0; i < responses.size(); ++i )
+	{
+		m_responses.push_back( Response() );
+		m_responses.back().connection = responses[ i ].connection;
+		m_responses.back().message.swap( responses[ i ].message );
+		m_latency.Record( latencies[ i ] );
+	}
+	m_numShared += numShared;
+	pthread_mutex_unlock( &m_lock );
+
+	const char wake = 0;
+	write( m_wakePipe[ 1 ], &wake, 1 );
+}
+
+//------------------------------------------------------------------------------
+// Name: ServeJob()
+// Desc: Builds the response to a single request, reusing the worker's grid
+//		 if it already holds the maze asked for
+//------------------------------------------------------------------------------
+void MazeServer::ServeJob( Worker& worker, const Job& job, vector< unsigned char >& message )
+{
+	const MazeRequest& request = job.request;
+	MessageWriter writer( message );
+
+	if( ! IsValidRequest( request ) )
+	{
+		WriteHeader( writer, request, STATUS_BAD_REQUEST );
+		writer.PatchU32( 0, (unsigned int)( writer.GetSize() - 4 ) );
+		return;
+	}
+
+	Grid*& pGrid = worker.pGrid;
+	if( pGrid == NULL || pGrid->GetWidth() != request.width || pGrid->GetHeight() != request.height )
+	{
+		delete pGrid;
+		pGrid = new Grid( request.width, request.height );
+		pGrid->SetPathSmoothing( false );
+		pGrid->SetNumThreads( 1 );	//the workers already fill the processors
+		pGrid->SetSolutionCache( worker.pCache );
+		worker.hasMaze = false;
+	}
+
+	//the grid keeps the last maze it built, even from an earlier batch
+	if( ! worker.hasMaze || ! SameMaze( worker.lastMaze, request ) )
+	{
+		pGrid->SetNumExits( request.numExits );
+		pGrid->SetBraidFactor( request.braid / 255.0f );
+		pGrid->GenerateMaze( request.seed );
+		worker.lastMaze = request;
+		worker.hasMaze = true;
+	}
+
+	int status = STATUS_OK;
+	worker.path.clear();
+	if( MESSAGE_SOLVE == request.type )
+	{
+		pGrid->SetSolver( Grid::Solver( request.solver ) );
+		pGrid->SetHeuristic( Grid::Heuristic( request.heuristic ) );
+		pGrid->GenerateSolution();
+
+		MazeSquare square;
+		while( pGrid->PopNextSolution( square ) )
+			worker.path.push_back( square );
+		if( worker.path.size() < 2 )
+			status = STATUS_UNSOLVABLE;
+	}
+
+	WriteHeader( writer, request, status );
+	if( STATUS_OK == status && ( request.flags & FLAG_INCLUDE_MAZE ) )
+	{
+		const int numExits = ( pGrid->GetNumExits() < 255 ) ? pGrid->GetNumExits() : 255;
+		writer.PutU16( request.width );
+		writer.PutU16( request.height );
+		writer.PutU16( pGrid->GetStartY() );
+		writer.PutU8( numExits );
+		for( int i = 0; i < numExits; ++i )
+		{
+			writer.PutU16( pGrid->GetExit( i ).x );
+			writer.PutU16( pGrid->GetExit( i ).y );
+		}
+
+		for( int y = 0; y < request.height; ++y )
+			for( int x = 0; x < request.width; ++x )
+				writer.PutBits( pGrid->IsPath( x, y ) ? 1 : 0, 1 );
+		writer.FlushBits();
+	}
+
+	if( STATUS_OK == status && MESSAGE_SOLVE == request.type )
+	{
+		const vector< MazeSquare >& path = worker.path;
+		writer.PutU32( pGrid->GetSolutionCost() );
+		writer.PutU8( pGrid->GetChosenExit() );
+		writer.PutU32( (unsigned int)( path.size() - 1 ) );
+		writer.PutU16( (unsigned int)( path[ 0 ].x ) & 0xffff );
+		writer.PutU16( (unsigned int)( path[ 0 ].y ) & 0xffff );
+
+		//steps are single squares, in the order of Grid::Direction
+		for( size_t i = 1; i < path.size(); ++i )
+		{
+			const int dx = path[ i ].x - path[ i - 1 ].x;
+			const int dy = path[ i ].y - path[ i - 1 ].y;
+			const int direction = ( dy > 0 ) ? Grid::DIR_UP : ( dx > 0 ) ? Grid::DIR_RIGHT :
+								  ( dy < 0 ) ? Grid::DIR_DOWN : Grid::DIR_LEFT;
+			writer.PutBits( direction, 2 );
+		}
+		writer.FlushBits();
+	}
+
+	writer.PatchU32( 0, (unsigned int)( writer.GetSize() - 4 ) );
+}
@@ -0,0 +1,147 @@
+//------------------------------------------------------------------------------
+// File: MazeServer.h
+// Desc: Headless maze daemon serving requests over a Unix domain socket
+//
+// Created: 19 October 2026 23:24:56
+//
+// (c)2002 Neil Wakefield
+//------------------------------------------------------------------------------
+
+
+#ifndef INCLUSIONGUARD_MAZESERVER_H
+#define INCLUSIONGUARD_MAZESERVER_H
+
+
+//------------------------------------------------------------------------------
+// Included files:
+//------------------------------------------------------------------------------
+#include "Histogram.h"
+#include "MazeProtocol.h"
+#include "Threading.h"
+
+#include <pthread.h>
+
+#include <deque>
+#include <map>
+#include <string>
+#include <vector>
+using namespace std;
+
+
+//------------------------------------------------------------------------------
+// Prototypes and declarations:
+//------------------------------------------------------------------------------
+class Grid;
+class SolutionCache;
+
+//------------------------------------------------------------------------------
+// Name: class MazeServer
+// Desc: Serves MazeProtocol requests on a Unix domain socket. The thread that
+//		 calls Run does all of the socket work with poll, gathering requests
+//		 that arrive within a short window of each other into batches. Worker
+//		 threads take whole batches, build each distinct maze in the batch
+//		 once, and solve from a Grid and solution cache they keep between
+//		 batches, so a steady stream of similar requests never reallocates.
+//		 Stats requests are answered straight away with the queue depth and
+//		 latency percentiles. POSIX only
+//------------------------------------------------------------------------------
+class MazeServer
+{
+
+public:
+	MazeServer();
+	~MazeServer();
+
+	bool Open( const char* pPath );
+	void Close();
+
+	void SetNumWorkers( const int numWorkers ) { m_numWorkers = ( numWorkers > 1 ) ? numWorkers : 1; }
+	void SetMaxBatch( const int maxBatch ) { m_maxBatch = ( maxBatch > 1 ) ? maxBatch : 1; }
+	void SetBatchWindow( const double seconds ) { m_batchWindow = seconds; }
+
+	//serves until Stop is called, which is safe from a signal handler
+	void Run();
+	void Stop();
+
+	void GetStats( unsigned int* pStats );
+
+private:
+	struct Job
+	{
+		MazeRequest request;
+		unsigned int connection;
+		double arrival;
+	};
+	typedef vector< Job > Batch;
+
+	struct Connection
+	{
+		int socket;
+		vector< unsigned char > input;
+		vector< unsigned char > output;
+		size_t outputSent;
+	};
+
+	struct Response
+	{
+		unsigned int connection;
+		vector< unsigned char > message;
+	};
+
+	struct Worker
+	{
+		MazeServer* pServer;
+		Grid* pGrid;
+		SolutionCache* pCache;
+		MazeRequest lastMaze;	//what pGrid holds, if hasMaze
+		bool hasMaze;
+		vector< MazeSquare > path;
+		Thread thread;
+	};
+
+	string m_path;
+	int m_listenSocket;
+	int m_wakePipe[ 2 ];
+	volatile long m_stopping;
+
+	int m_numWorkers;
+	int m_maxBatch;
+	double m_batchWindow;
+
+	//owned by the Run thread
+	map< unsigned int, Connection > m_connections;
+	unsigned int m_nextConnection;
+	Batch m_filling;
+	double m_fillingStart;
+
+	//shared with the workers, under m_lock
+	pthread_mutex_t m_lock;
+	pthread_cond_t m_batchReady;
+	deque< Batch > m_batches;
+	vector< Response > m_responses;
+	int m_queueDepth;
+	int m_peakQueueDepth;
+	unsigned int m_numRequests;
+	unsigned int m_numBatches;
+	unsigned int m_numShared;
+	Histogram m_latency;
+
+	static void WorkerMain( void* pWorker );
+	void ServeBatch( Worker& worker, Batch& batch );
+	void ServeJob( Worker& worker, const Job& job, vector< unsigned char >& message );
+
+	void Accept();
+	bool Receive( Connection& connection, const unsigned int id );
+	bool Send( Connection& connection );
+	void Submit( const Job& job );
+	void FlushBatch();
+	void CollectResponses();
+
+	//not copyable
+	MazeServer( const MazeServer& );
+	MazeServer& operator=( const MazeServer& );
+
+};
+
+
+#endif //INCLUSIONGUARD_MAZESERVER_H
@@ -0,0 +1,314 @@
+//------------------------------------------------------------------------------
+// File: MazeTrace.cpp
+// Desc: Compact record of the generator's decisions, and a replayer for it
+//
+// Created: 20 October 2026 03:11:42
+//
+// (c)2002 Neil Wakefield
+//------------------------------------------------------------------------------
+
+
+//------------------------------------------------------------------------------
+// Included files:
+//------------------------------------------------------------------------------
+#include "MazeTrace.h"
+
+
+//------------------------------------------------------------------------------
+// Globals:
+//------------------------------------------------------------------------------
+namespace
+{
+	//offsets for each move, in the order of Grid::Direction
+	const int g_moveX[ 4 ] = { 0, 1, 0, -1 };
+	const int g_moveY[ 4 ] = { 1, 0, -1, 0 };
+
+	//varints before the first step - width, height and entrance row
+	const int g_headerLength = 3;
+
+	//--------------------------------------------------------------------------
+	// Name: ZigZag()
+	// Desc: Folds a signed change into an unsigned one, small either way
+	//--------------------------------------------------------------------------
+	unsigned int ZigZag( const int value )
+	{
+		return ( (unsigned int)( value ) << 1 ) ^ (unsigned int)( value >> 31 );
+	}
+
+	//--------------------------------------------------------------------------
+	// Name: UnZigZag()
+	// Desc: Undoes ZigZag
+	//--------------------------------------------------------------------------
+	int UnZigZag( const unsigned int value )
+	{
+		return int( value >> 1 ) ^ -int( value & 1 );
+	}
+}
+
+
+//------------------------------------------------------------------------------
+// Definitions:
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Name: MazeTrace()
+// Desc: Constructor for the trace object
+//------------------------------------------------------------------------------
+MazeTrace::MazeTrace()
+{
+	Clear();
+}
+
+//------------------------------------------------------------------------------
+// Name: Clear()
+// Desc: Empties the trace, keeping its memory for the next recording
+//------------------------------------------------------------------------------
+void MazeTrace::Clear()
+{
+	m_data.clear();
+	m_numSteps = 0;
+	m_width = 0;
+	m_lastCell = 0;
+}
+
+//------------------------------------------------------------------------------
+// Name: Load()
+// Desc: Copies in a saved stream, counting its steps
+//------------------------------------------------------------------------------
+bool MazeTrace::Load( const unsigned char* pData, const size_t size )
+{
+	Clear();
+	int width = 0;
+
+	//every varint ends in a byte with the top bit clear, and a tile change
+	// is two of them
+	int numVarints = 0;
+	int numTiles = 0;
+	bool tileNext = false;
+	unsigned int first = 0;
+	int shift = 0;
+	for( size_t i = 0; i < size; ++i )
+	{
+		if( shift >= 35 )
+			return false;
+
+		first |= (unsigned int)( pData[ i ] & 0x7f ) << shift;
+		shift += 7;
+		if( pData[ i ] & 0x80 )
+			continue;
+
+		if( numVarints >= g_headerLength && ! tileNext &&
+			OUTCOME_TILE == ( ( first >> OUTCOME_SHIFT ) & 7 ) )
+		{
+			tileNext = true;
+			++numTiles;
+		}
+		else
+			tileNext = false;
+
+		if( 0 == numVarints )
+			width = int( first );
+		++numVarints;
+		first = 0;
+		shift = 0;
+	}
+
+	if( numVarints < g_headerLength || 0 != shift || tileNext )
+		return false;
+
+	m_data.assign( pData, pData + size );
+	m_width = width;
+	m_numSteps = numVarints - g_headerLength - numTiles;
+	return true;
+}
+
+//------------------------------------------------------------------------------
+// Name: Begin()
+// Desc: Starts a new recording for a grid of the given size
+//------------------------------------------------------------------------------
+void MazeTrace::Begin( const int width, const int height )
+{
+	Clear();
+	m_width = width;
+
+	//most steps fit in one or two bytes, so this saves regrowing the buffer
+	// on all but the first maze of a size
+	m_data.reserve( width * height * 2 );
+
+	PutVarint( (unsigned int)( width ) );
+	PutVarint( (unsigned int)( height ) );
+}
+
+//------------------------------------------------------------------------------
+// Name: RecordTile()
+// Desc: Records a tile changed after growth
+//------------------------------------------------------------------------------
+void MazeTrace::RecordTile( const int x, const int y, const int tile )
+{
+	const int cell = y * m_width + x;
+	PutVarint( ( OUTCOME_TILE << OUTCOME_SHIFT ) | (unsigned int)( tile ) );
+	PutVarint( ZigZag( cell - m_lastCell ) );
+	m_lastCell = cell;
+	++m_numSteps;
+}
+
+//------------------------------------------------------------------------------
+// Name: MazeReplayer()
+// Desc: Constructor for the replayer object
+//------------------------------------------------------------------------------
+MazeReplayer::MazeReplayer( const MazeTrace& trace, Grid& grid )
+	: m_trace( trace ), m_grid( grid )
+{
+	m_offset = 0;
+	m_step = 0;
+	m_valid = false;
+	m_foundExit = false;
+	m_lastCell = 0;
+}
+
+//------------------------------------------------------------------------------
+// Name: Reset()
+// Desc: Clears the grid back to walls and the entrance, ready for step 0
+//------------------------------------------------------------------------------
+bool MazeReplayer::Reset()
+{
+	m_offset = 0;
+	m_step = 0;
+	m_valid = false;
+	m_foundExit = false;
+	m_lastCell = 0;
+	m_frontier.clear();
+
+	unsigned int width = 0;
+	unsigned int height = 0;
+	unsigned int startY = 0;
+	if( ! GetVarint( width ) || ! GetVarint( height ) || ! GetVarint( startY ) )
+		return false;
+	if( int( width ) != m_grid.GetWidth() || int( height ) != m_grid.GetHeight() ||
+		int( startY ) >= m_grid.GetHeight() )
+		return false;
+
+	m_grid.ResetMaze();
+	m_grid.m_startY = int( startY );
+	m_grid.SetTile( 0, int( startY ), Grid::TILE_START );
+	m_frontier.push_back( MazeSquare( 0, int( startY ) ) );
+
+	m_valid = true;
+	return true;
+}
+
+//------------------------------------------------------------------------------
+// Name: Step()
+// Desc: Applies the next growth step or tile change to the grid
+//------------------------------------------------------------------------------
+bool MazeReplayer::Step()
+{
+	if( ! m_valid || m_step >= m_trace.GetNumSteps() )
+		return false;
+
+	unsigned int value = 0;
+	m_valid = GetVarint( value );
+	if( ! m_valid )
+		return false;
+
+	const int outcome = int( value >> MazeTrace::OUTCOME_SHIFT ) & 7;
+	if( MazeTrace::OUTCOME_TILE == outcome )
+	{
+		unsigned int change = 0;
+		m_valid = GetVarint( change );
+		const int cell = m_lastCell + UnZigZag( change );
+		const int x = ( m_valid && cell >= 0 ) ? cell % m_grid.GetWidth() : -1;
+		const int y = ( m_valid && cell >= 0 ) ? cell / m_grid.GetWidth() : -1;
+		m_valid = ( x >= 0 && y >= 0 && y < m_grid.GetHeight() );
+		if( ! m_valid )
+			return false;
+
+		const Grid::GridTile tile = Grid::GridTile( value & 3 );
+		m_grid.SetTile( x, y, tile );
+		if( Grid::TILE_GOAL == tile )
+		{
+			m_grid.m_exits.push_back( MazeSquare( x, y ) );
+			m_grid.m_exitCells.push_back( m_grid.GetCellIndex( x, y ) );
+		}
+		m_lastCell = cell;
+	}
+	else
+	{
+		const unsigned int index = value >> MazeTrace::INDEX_SHIFT;
+		m_valid = ( index < m_frontier.size() && outcome <= MazeTrace::OUTCOME_ERASED );
+		if( ! m_valid )
+			return false;
+
+		if( MazeTrace::OUTCOME_ERASED == outcome )
+			m_frontier.erase( m_frontier.begin() + index );
+		else
+		{
+			const int d = ( int( value ) + outcome ) & 3;
+			const int x = m_frontier[ index ].x + g_moveX[ d ];
+			const int y = m_frontier[ index ].y + g_moveY[ d ];
+			m_valid = ( x >= 0 && x < m_grid.GetWidth() && y >= 0 && y < m_grid.GetHeight() );
+			if( ! m_valid )
+				return false;
+
+			m_grid.SetTile( x, y, Grid::TILE_PATH );
+			m_frontier.push_back( MazeSquare( x, y ) );
+
+			//the first square grown into the right hand column is the goal
+			if( x == m_grid.GetWidth() - 1 && ! m_foundExit )
+			{
+				m_grid.SetTile( x, y, Grid::TILE_GOAL );
+				m_grid.m_goalY = y;
+				m_grid.m_exits.assign( 1, MazeSquare( x, y ) );
+				m_grid.m_exitCells.assign( 1, m_grid.GetCellIndex( x, y ) );
+				m_foundExit = true;
+			}
+		}
+	}
+
+	++m_step;
+	return true;
+}
+
+//------------------------------------------------------------------------------
+// Name: Seek()
+// Desc: Moves the grid to the state it was in after a given number of steps
+//------------------------------------------------------------------------------
+bool MazeReplayer::Seek( const int step )
+{
+	const int target = ( step < GetNumSteps() ) ? step : GetNumSteps();
+
+	if( ! m_valid || target < m_step )
+	{
+		if( ! Reset() )
+			return false;
+	}
+
+	while( m_step < target )
+	{
+		if( ! Step() )
+			return false;
+	}
+
+	return true;
+}
+
+//------------------------------------------------------------------------------
+// Name: GetVarint()
+// Desc: Reads the next varint of the trace, returning false if it runs out
+//------------------------------------------------------------------------------
+bool MazeReplayer::GetVarint( unsigned int& value )
+{
+	const unsigned char* pData = m_trace.GetData();
+	const size_t size = m_trace.GetSize();
+
+	value = 0;
+	for( int shift = 0; m_offset < size && shift < 35; shift += 7 )
+	{
+		const unsigned char byte = pData[ m_offset++ ];
+		value |= (unsigned int)( byte & 0x7f ) << shift;
+		if( 0 == ( byte & 0x80 ) )
+			return true;
+	}
+
+	return false;
+}
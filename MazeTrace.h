@@ -0,0 +1,148 @@
+//------------------------------------------------------------------------------
+// File: MazeTrace.h
+// Desc: Compact record of the generator's decisions, and a replayer for it
+//
+// Created: 20 October 2026 02:58:06
+//
+// (c)2002 Neil Wakefield
+//------------------------------------------------------------------------------
+
+
+#ifndef INCLUSIONGUARD_MAZETRACE_H
+#define INCLUSIONGUARD_MAZETRACE_H
+
+
+//------------------------------------------------------------------------------
+// Included files:
+//------------------------------------------------------------------------------
+#include "Grid.h"
+
+#include <stddef.h>
+#include <vector>
+using namespace std;
+
+
+//------------------------------------------------------------------------------
+// Prototypes and declarations:
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Name: class MazeTrace
+// Desc: The decisions GenerateMaze made, as a stream of varints. The stream
+//		 opens with the width, height and entrance row. Each step of growth
+//		 is then one varint holding the frontier index picked, the first
+//		 direction tried and what came of it - the number of directions
+//		 refused before one was taken, or OUTCOME_ERASED if all four were.
+//		 Tiles changed after growth, for the extra exits and braiding, are
+//		 a varint marked OUTCOME_TILE holding the new tile, then the change
+//		 in row-major cell index from the tile changed before, zigzagged so
+//		 small steps back stay small too
+//------------------------------------------------------------------------------
+class MazeTrace
+{
+
+public:
+	enum
+	{
+		OUTCOME_ERASED = 4,		//every direction refused, square dropped
+		OUTCOME_TILE = 7,		//not a growth step but a tile change
+		OUTCOME_SHIFT = 2,
+		INDEX_SHIFT = 5
+	};
+
+	MazeTrace();
+
+	void Clear();
+
+	//takes a stream saved from GetData, returning false if it is malformed -
+	// shorter than the header, or ending part way through a varint or a tile
+	// change. The stream holds no step count, so one cut off between steps
+	// can't be told from a shorter maze, and loads
+	bool Load( const unsigned char* pData, const size_t size );
+
+	void Begin( const int width, const int height );
+	void RecordStart( const int startY ) { PutVarint( (unsigned int)( startY ) ); }
+	void RecordStep( const int index, const int firstDirection, const int outcome )
+	{
+		PutVarint( ( (unsigned int)( index ) << INDEX_SHIFT ) |
+				   ( (unsigned int)( outcome ) << OUTCOME_SHIFT ) | (unsigned int)( firstDirection ) );
+		++m_numSteps;
+	}
+	void RecordTile( const int x, const int y, const int tile );
+
+	//growth steps and tile changes together
+	int GetNumSteps() const { return m_numSteps; }
+
+	const unsigned char* GetData() const { return m_data.empty() ? NULL : &m_data[ 0 ]; }
+	size_t GetSize() const { return m_data.size(); }
+
+private:
+	vector< unsigned char > m_data;
+	int m_numSteps;
+
+	int m_width;
+	int m_lastCell;		//row-major index of the last tile change
+
+	void PutVarint( unsigned int value )
+	{
+		while( value >= 0x80 )
+		{
+			m_data.push_back( (unsigned char)( value | 0x80 ) );
+			value >>= 7;
+		}
+		m_data.push_back( (unsigned char)( value ) );
+	}
+
+};
+
+//------------------------------------------------------------------------------
+// Name: class MazeReplayer
+// Desc: Rebuilds a maze on a grid from a trace, one step at a time. A step
+//		 is a handful of sums on the frontier with no random numbers or
+//		 placement checks, so replaying is much quicker than generating.
+//		 Seeking forward carries on from the current step, and seeking back
+//		 starts again from the entrance. The trace must outlive the replayer
+//		 and must not be recorded into while it is used
+//------------------------------------------------------------------------------
+class MazeReplayer
+{
+
+public:
+	MazeReplayer( const MazeTrace& trace, Grid& grid );
+
+	//back to step 0, with only the entrance open. Returns false if the trace
+	// is for a grid of a different size
+	bool Reset();
+
+	//applies the next step, returning false at the end or on a bad trace
+	bool Step();
+
+	//steps forward or back to a step, clamped to the end of the trace.
+	// Returns false if the trace couldn't be replayed that far
+	bool Seek( const int step );
+
+	int GetStep() const { return m_step; }
+	int GetNumSteps() const { return m_trace.GetNumSteps(); }
+
+private:
+	const MazeTrace& m_trace;
+	Grid& m_grid;
+
+	size_t m_offset;		//next byte of the trace to read
+	int m_step;
+	bool m_valid;			//Reset succeeded and no step has failed since
+
+	vector< MazeSquare > m_frontier;
+	bool m_foundExit;
+	int m_lastCell;
+
+	bool GetVarint( unsigned int& value );
+
+	//not copyable, as it holds references
+	MazeReplayer( const MazeReplayer& );
+	MazeReplayer& operator=( const MazeReplayer& );
+
+};
+
+
+#endif //INCLUSIONGUARD_MAZETRACE_H
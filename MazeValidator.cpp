@@ -0,0 +1,515 @@
+//------------------------------------------------------------------------------
+// File: MazeValidator.cpp
+// Desc: Structural checks on generated mazes
+//
+// Created: 20 October 2026 02:19:48
+//
+// (c)2002 Neil Wakefield
+//------------------------------------------------------------------------------
+
+
+//------------------------------------------------------------------------------
+// Included files:
+//------------------------------------------------------------------------------
+#include "MazeValidator.h"
+#include "Grid.h"
+#include "Threading.h"
+
+#include <algorithm>
+
+
+//------------------------------------------------------------------------------
+// Globals:
+//------------------------------------------------------------------------------
+namespace
+{
+	//errors listed in a report unless SetMaxErrors says otherwise
+	const int g_defaultMaxErrors = 16;
+
+	//--------------------------------------------------------------------------
+	// Name: LowestBit()
+	// Desc: Index of the lowest set bit of a non-zero word
+	//--------------------------------------------------------------------------
+	int LowestBit( const uint64 bits )
+	{
+#ifdef __GNUC__
+		return __builtin_ctzll( bits );
+#else
+		int index = 0;
+		uint64 rest = bits;
+		if( 0 == ( rest & 0xffffffff ) ) { index += 32; rest >>= 32; }
+		if( 0 == ( rest & 0xffff ) ) { index += 16; rest >>= 16; }
+		if( 0 == ( rest & 0xff ) ) { index += 8; rest >>= 8; }
+		if( 0 == ( rest & 0xf ) ) { index += 4; rest >>= 4; }
+		if( 0 == ( rest & 0x3 ) ) { index += 2; rest >>= 2; }
+		if( 0 == ( rest & 0x1 ) ) { index += 1; }
+		return index;
+#endif
+	}
+
+	//the grids and reports shared by the threads of one batch
+	struct BatchJob
+	{
+		const vector< const Grid* >* pGrids;
+		vector< MazeReport >* pReports;
+		volatile long next;
+		volatile long numInvalid;
+	};
+
+	//one thread of a batch, with its own workspace
+	struct BatchWorker
+	{
+		MazeValidator validator;
+		BatchJob* pJob;
+		Thread thread;
+	};
+
+	//--------------------------------------------------------------------------
+	// Name: RunBatchWorker()
+	// Desc: Validates grids from a batch until there are none left
+	//--------------------------------------------------------------------------
+	void RunBatchWorker( void* pWorker )
+	{
+		BatchWorker& worker = *( (BatchWorker*)( pWorker ) );
+		BatchJob& job = *worker.pJob;
+		const long numGrids = long( job.pGrids->size() );
+
+		while( true )
+		{
+			const long index = AtomicIncrement( &job.next ) - 1;
+			if( index >= numGrids )
+				break;
+
+			if( ! worker.validator.Validate( *( *job.pGrids )[ index ], ( *job.pReports )[ index ] ) )
+				AtomicIncrement( &job.numInvalid );
+		}
+	}
+}
+
+
+//------------------------------------------------------------------------------
+// Definitions:
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Name: GetName()
+// Desc: Returns a short name for a kind of error, for logs
+//------------------------------------------------------------------------------
+const char* MazeError::GetName( const Kind kind )
+{
+	switch( kind )
+	{
+	case ERROR_START_PLACEMENT:		return "start placement";
+	case ERROR_EXIT_PLACEMENT:		return "exit placement";
+	case ERROR_UNREACHABLE_EXIT:	return "unreachable exit";
+	case ERROR_UNREACHABLE_CELL:	return "unreachable cell";
+	case ERROR_LOOP:				return "loop";
+	case ERROR_OPEN_BLOCK:			return "open block";
+	case ERROR_DIAGONAL:			return "diagonal";
+	default:						return "unknown";
+	}
+}
+
+//------------------------------------------------------------------------------
+// Name: MazeValidator()
+// Desc: Constructor for the validator object
+//------------------------------------------------------------------------------
+MazeValidator::MazeValidator()
+{
+	m_allowLoops = false;
+	m_maxErrors = g_defaultMaxErrors;
+	m_numThreads = GetNumProcessors();
+	m_wordsPerRow = 0;
+}
+
+//------------------------------------------------------------------------------
+// Name: Validate()
+// Desc: Checks a maze, filling in the report. Returns true if nothing was
+//		 found wrong
+//------------------------------------------------------------------------------
+bool MazeValidator::Validate( const Grid& grid, MazeReport& report )
+{
+	report.numErrors = 0;
+	for( int i = 0; i < MazeError::NUM_KINDS; ++i )
+		report.counts[ i ] = 0;
+	report.errors.clear();
+	report.numComponents = 0;
+	report.numLoops = 0;
+
+	const int width = grid.GetWidth();
+	const int height = grid.GetHeight();
+	m_wordsPerRow = ( width + 63 ) / 64;
+
+	BuildBitboard( grid, report );
+	CheckPlacement( grid, report );
+	FindRuns( width, height );
+	JoinRuns( height, report );
+	CheckCorners( height, report );
+	CheckReachable( grid, report );
+
+	return report.IsValid();
+}
+
+//------------------------------------------------------------------------------
+// Name: ValidateBatch()
+// Desc: Validates a batch of grids across threads
+//------------------------------------------------------------------------------
+int MazeValidator::ValidateBatch( const vector< const Grid* >& grids, vector< MazeReport >& reports ) const
+{
+	reports.resize( grids.size() );
+
+	BatchJob job;
+	job.pGrids = &grids;
+	job.pReports = &reports;
+	job.next = 0;
+	job.numInvalid = 0;
+
+	const int numWorkers = ( m_numThreads < int( grids.size() ) ) ? m_numThreads : int( grids.size() );
+	vector< BatchWorker* > workers( numWorkers );
+	for( int i = 0; i < numWorkers; ++i )
+	{
+		workers[ i ] = new BatchWorker;
+		workers[ i ]->validator.SetAllowLoops( m_allowLoops );
+		workers[ i ]->validator.SetMaxErrors( m_maxErrors );
+		workers[ i ]->pJob = &job;
+	}
+
+	//the calling thread takes a share too, and picks up the lot if no other
+	// thread starts
+	for( int i = 1; i < numWorkers; ++i )
+		workers[ i ]->thread.Start( RunBatchWorker, workers[ i ] );
+	if( numWorkers > 0 )
+		RunBatchWorker( workers[ 0 ] );
+
+	for( int i = 0; i < numWorkers; ++i )
+	{
+		workers[ i ]->thread.Join();
+		delete workers[ i ];
+	}
+
+	return int( job.numInvalid );
+}
+
+//------------------------------------------------------------------------------
+// Name: AddError()
+// Desc: Counts an error, and lists it if the report has room
+//------------------------------------------------------------------------------
+void MazeValidator::AddError( MazeReport& report, const MazeError::Kind kind,
+							  const int x, const int y ) const
+{
+	++report.numErrors;
+	++report.counts[ kind ];
+	if( int( report.errors.size() ) < m_maxErrors )
+		report.errors.push_back( MazeError( kind, x, y ) );
+}
+
+//------------------------------------------------------------------------------
+// Name: BuildBitboard()
+// Desc: Packs the open cells into bits, one row at a time with any spare
+//		 bits at the end of a row left clear. Entrance tiles other than the
+//		 grid's own are errors, and goal tiles are kept to check against the
+//		 exits
+//------------------------------------------------------------------------------
+void MazeValidator::BuildBitboard( const Grid& grid, MazeReport& report )
+{
+	const int width = grid.GetWidth();
+	const int height = grid.GetHeight();
+	const int startY = grid.GetStartY();
+
+	m_open.assign( height * m_wordsPerRow, 0 );
+	m_goals.clear();
+
+	for( int y = 0; y < height; ++y )
+	{
+		const int rowBase = y * m_wordsPerRow;
+		for( int x = 0; x < width; ++x )
+		{
+			const Grid::GridTile tile = grid.GetTile( x, y );
+			if( Grid::TILE_WALL == tile )
+				continue;
+
+			m_open[ rowBase + ( x >> 6 ) ] |= uint64( 1 ) << ( x & 63 );
+
+			if( Grid::TILE_START == tile && ( x != 0 || y != startY ) )
+				AddError( report, MazeError::ERROR_START_PLACEMENT, x, y );
+			else if( Grid::TILE_GOAL == tile )
+				m_goals.push_back( y * width + x );
+		}
+	}
+}
+
+//------------------------------------------------------------------------------
+// Name: CheckPlacement()
+// Desc: Checks the entrance is in the left hand column, that every exit is a
+//		 distinct goal tile on the border with the first in the right hand
+//		 column, and that there are no goal tiles but the exits
+//------------------------------------------------------------------------------
+void MazeValidator::CheckPlacement( const Grid& grid, MazeReport& report )
+{
+	const int width = grid.GetWidth();
+	const int height = grid.GetHeight();
+	const int startY = grid.GetStartY();
+
+	if( startY < 0 || startY >= height || Grid::TILE_START != grid.GetTile( 0, startY ) )
+		AddError( report, MazeError::ERROR_START_PLACEMENT, 0, startY );
+
+	const int numExits = grid.GetNumExits();
+	if( 0 == numExits )
+		AddError( report, MazeError::ERROR_EXIT_PLACEMENT, -1, -1 );
+
+	for( int i = 0; i < numExits; ++i )
+	{
+		const MazeSquare exit = grid.GetExit( i );
+
+		bool placed = ( exit.x >= 0 && exit.x < width && exit.y >= 0 && exit.y < height );
+		placed = placed && Grid::TILE_GOAL == grid.GetTile( exit.x, exit.y );
+		placed = placed && ( 0 == exit.x || width - 1 == exit.x || 0 == exit.y || height - 1 == exit.y );
+		placed = placed && ( i > 0 || width - 1 == exit.x );
+		for( int j = 0; j < i && placed; ++j )
+			placed = ( grid.GetExit( j ).x != exit.x || grid.GetExit( j ).y != exit.y );
+
+		if( ! placed )
+			AddError( report, MazeError::ERROR_EXIT_PLACEMENT, exit.x, exit.y );
+	}
+
+	for( size_t i = 0; i < m_goals.size(); ++i )
+	{
+		const int x = m_goals[ i ] % width;
+		const int y = m_goals[ i ] / width;
+
+		bool isExit = false;
+		for( int j = 0; j < numExits && ! isExit; ++j )
+			isExit = ( grid.GetExit( j ).x == x && grid.GetExit( j ).y == y );
+
+		if( ! isExit )
+			AddError( report, MazeError::ERROR_EXIT_PLACEMENT, x, y );
+	}
+}
+
+//------------------------------------------------------------------------------
+// Name: FindRuns()
+// Desc: Splits each row into runs of open cells. A run starts or ends
+//		 wherever a bit differs from the one before it, so the changes are
+//		 found a word at a time and read off lowest first
+//------------------------------------------------------------------------------
+void MazeValidator::FindRuns( const int width, const int height )
+{
+	m_runStart.clear();
+	m_runEnd.clear();
+	m_rowRuns.resize( height + 1 );
+
+	for( int y = 0; y < height; ++y )
+	{
+		m_rowRuns[ y ] = int( m_runStart.size() );
+
+		const int rowBase = y * m_wordsPerRow;
+		bool inRun = false;
+		uint64 carry = 0;	//last bit of the word before
+		for( int w = 0; w < m_wordsPerRow; ++w )
+		{
+			const uint64 bits = m_open[ rowBase + w ];
+			uint64 changes = bits ^ ( ( bits << 1 ) | carry );
+			carry = bits >> 63;
+
+			while( 0 != changes )
+			{
+				const int x = ( w << 6 ) + LowestBit( changes );
+				changes &= changes - 1;
+
+				if( inRun )
+					m_runEnd.push_back( x );
+				else
+					m_runStart.push_back( x );
+				inRun = ! inRun;
+			}
+		}
+
+		//only a run reaching the last bit of the last word is still open
+		if( inRun )
+			m_runEnd.push_back( width );
+	}
+
+	m_rowRuns[ height ] = int( m_runStart.size() );
+}
+
+//------------------------------------------------------------------------------
+// Name: JoinRuns()
+// Desc: Joins each run to the runs it overlaps on the row below. Every cell
+//		 of overlap is an edge of the maze, and any edge between two runs
+//		 already joined closes a loop
+//------------------------------------------------------------------------------
+void MazeValidator::JoinRuns( const int height, MazeReport& report )
+{
+	const int numRuns = int( m_runStart.size() );
+	m_parent.resize( numRuns );
+	m_rank.assign( numRuns, 0 );
+	for( int i = 0; i < numRuns; ++i )
+		m_parent[ i ] = i;
+
+	for( int y = 1; y < height; ++y )
+	{
+		int below = m_rowRuns[ y - 1 ];
+		const int belowEnd = m_rowRuns[ y ];
+		int above = m_rowRuns[ y ];
+		const int aboveEnd = m_rowRuns[ y + 1 ];
+
+		while( below < belowEnd && above < aboveEnd )
+		{
+			int x = max( m_runStart[ below ], m_runStart[ above ] );
+			const int overlapEnd = min( m_runEnd[ below ], m_runEnd[ above ] );
+			if( x < overlapEnd )
+			{
+				const int rootBelow = FindRoot( below );
+				const int rootAbove = FindRoot( above );
+				if( rootBelow != rootAbove )
+				{
+					//union by rank
+					if( m_rank[ rootBelow ] < m_rank[ rootAbove ] )
+						m_parent[ rootBelow ] = rootAbove;
+					else
+					{
+						m_parent[ rootAbove ] = rootBelow;
+						if( m_rank[ rootBelow ] == m_rank[ rootAbove ] )
+							++m_rank[ rootBelow ];
+					}
+					++x;
+				}
+
+				if( m_allowLoops )
+					report.numLoops += overlapEnd - x;
+				else
+				{
+					for( ; x < overlapEnd; ++x )
+					{
+						++report.numLoops;
+						AddError( report, MazeError::ERROR_LOOP, x, y );
+					}
+				}
+			}
+
+			if( m_runEnd[ below ] < m_runEnd[ above ] )
+				++below;
+			else
+				++above;
+		}
+	}
+
+	for( int i = 0; i < numRuns; ++i )
+		if( m_parent[ i ] == i )
+			++report.numComponents;
+}
+
+//------------------------------------------------------------------------------
+// Name: CheckCorners()
+// Desc: Looks at every 2x2 block for one left fully open, and unless loops
+//		 are allowed for two path cells meeting only at a corner. Each pair
+//		 of rows is compared with itself shifted one cell along, so a word
+//		 checks 64 blocks at once
+//------------------------------------------------------------------------------
+void MazeValidator::CheckCorners( const int height, MazeReport& report )
+{
+	for( int y = 1; y < height; ++y )
+	{
+		const int belowBase = ( y - 1 ) * m_wordsPerRow;
+		const int aboveBase = y * m_wordsPerRow;
+		for( int w = 0; w < m_wordsPerRow; ++w )
+		{
+			//each bit with the cell to its right, pulled in from the next word
+			// across the boundary
+			const uint64 below = m_open[ belowBase + w ];
+			const uint64 above = m_open[ aboveBase + w ];
+			uint64 belowRight = below >> 1;
+			uint64 aboveRight = above >> 1;
+			if( w + 1 < m_wordsPerRow )
+			{
+				belowRight |= m_open[ belowBase + w + 1 ] << 63;
+				aboveRight |= m_open[ aboveBase + w + 1 ] << 63;
+			}
+
+			uint64 blocks = below & belowRight & above & aboveRight;
+			while( 0 != blocks )
+			{
+				AddError( report, MazeError::ERROR_OPEN_BLOCK, ( w << 6 ) + LowestBit( blocks ), y - 1 );
+				blocks &= blocks - 1;
+			}
+
+			if( m_allowLoops )
+				continue;
+
+			uint64 corners = ( below & aboveRight & ~belowRight & ~above ) |
+							 ( belowRight & above & ~below & ~aboveRight );
+			while( 0 != corners )
+			{
+				AddError( report, MazeError::ERROR_DIAGONAL, ( w << 6 ) + LowestBit( corners ), y - 1 );
+				corners &= corners - 1;
+			}
+		}
+	}
+}
+
+//------------------------------------------------------------------------------
+// Name: CheckReachable()
+// Desc: Reports every part of the maze and every exit not joined to the
+//		 entrance. Skipped if there is no entrance to measure from, as that
+//		 has been reported already
+//------------------------------------------------------------------------------
+void MazeValidator::CheckReachable( const Grid& grid, MazeReport& report )
+{
+	const int startY = grid.GetStartY();
+	if( startY < 0 || startY >= grid.GetHeight() )
+		return;
+
+	const int startRun = FindRun( 0, startY );
+	if( startRun < 0 )
+		return;
+	const int startRoot = FindRoot( startRun );
+
+	for( int y = 0; y < grid.GetHeight(); ++y )
+		for( int run = m_rowRuns[ y ]; run < m_rowRuns[ y + 1 ]; ++run )
+			if( m_parent[ run ] == run && run != startRoot )
+				AddError( report, MazeError::ERROR_UNREACHABLE_CELL, m_runStart[ run ], y );
+
+	for( int i = 0; i < grid.GetNumExits(); ++i )
+	{
+		const MazeSquare exit = grid.GetExit( i );
+		if( exit.y < 0 || exit.y >= grid.GetHeight() )
+			continue;
+
+		const int exitRun = FindRun( exit.x, exit.y );
+		if( exitRun >= 0 && FindRoot( exitRun ) != startRoot )
+			AddError( report, MazeError::ERROR_UNREACHABLE_EXIT, exit.x, exit.y );
+	}
+}
+
+//------------------------------------------------------------------------------
+// Name: FindRun()
+// Desc: Returns the run holding a cell, or -1 if the cell is a wall
+//------------------------------------------------------------------------------
+int MazeValidator::FindRun( const int x, const int y ) const
+{
+	const vector< int >::const_iterator first = m_runStart.begin() + m_rowRuns[ y ];
+	const vector< int >::const_iterator last = m_runStart.begin() + m_rowRuns[ y + 1 ];
+
+	//the last run starting at or before x
+	const vector< int >::const_iterator after = upper_bound( first, last, x );
+	if( after == first )
+		return -1;
+
+	const int run = int( after - m_runStart.begin() ) - 1;
+	return ( x < m_runEnd[ run ] ) ? run : -1;
+}
+
+//------------------------------------------------------------------------------
+// Name: FindRoot()
+// Desc: Finds the run standing for a run's group, halving the path to it on
+//		 the way
+//------------------------------------------------------------------------------
+int MazeValidator::FindRoot( int run )
+{
+	while( m_parent[ run ] != run )
+	{
+		m_parent[ run ] = m_parent[ m_parent[ run ] ];
+		run = m_parent[ run ];
+	}
+	return run;
+}
@@ -0,0 +1,141 @@
+//------------------------------------------------------------------------------
+// File: MazeValidator.h
+// Desc: Structural checks on generated mazes
+//
+// Created: 20 October 2026 02:07:31
+//
+// (c)2002 Neil Wakefield
+//------------------------------------------------------------------------------
+
+
+#ifndef INCLUSIONGUARD_MAZEVALIDATOR_H
+#define INCLUSIONGUARD_MAZEVALIDATOR_H
+
+
+//------------------------------------------------------------------------------
+// Included files:
+//------------------------------------------------------------------------------
+#include "Types.h"
+
+#include <vector>
+using namespace std;
+
+
+//------------------------------------------------------------------------------
+// Prototypes and declarations:
+//------------------------------------------------------------------------------
+class Grid;
+
+//------------------------------------------------------------------------------
+// Name: struct MazeError
+// Desc: One problem found in a maze, at the cell it was found. Corner and
+//		 2x2 problems give the lower left cell of the block, and a missing
+//		 exit gives -1, -1
+//------------------------------------------------------------------------------
+struct MazeError
+{
+	enum Kind
+	{
+		ERROR_START_PLACEMENT,	//entrance missing, doubled or off the left hand column
+		ERROR_EXIT_PLACEMENT,	//exit not a goal tile on the border, or a stray goal tile
+		ERROR_UNREACHABLE_EXIT,	//no route from the entrance to this exit
+		ERROR_UNREACHABLE_CELL,	//one cell of each part cut off from the entrance
+		ERROR_LOOP,				//a second route between two cells
+		ERROR_OPEN_BLOCK,		//2x2 block of path, which neither generator nor braider makes
+		ERROR_DIAGONAL,			//path cells touching only at a corner
+		NUM_KINDS
+	};
+
+	MazeError() : kind( ERROR_LOOP ), x( 0 ), y( 0 ) {}
+	MazeError( const Kind newKind, const int newX, const int newY )
+		: kind( newKind ), x( newX ), y( newY ) {}
+
+	static const char* GetName( const Kind kind );
+
+	Kind kind;
+	int x, y;
+};
+
+//------------------------------------------------------------------------------
+// Name: struct MazeReport
+// Desc: Everything found wrong with a maze. Only the first few errors are
+//		 listed, but all of them are counted
+//------------------------------------------------------------------------------
+struct MazeReport
+{
+	bool IsValid() const { return 0 == numErrors; }
+
+	int numErrors;
+	int counts[ MazeError::NUM_KINDS ];
+	vector< MazeError > errors;
+
+	int numComponents;	//separate groups of connected path cells
+	int numLoops;		//independent cycles - zero in a perfect maze
+};
+
+//------------------------------------------------------------------------------
+// Name: class MazeValidator
+// Desc: Checks that a maze is connected, loop free, has its entrance and
+//		 exits where the generator puts them, and keeps MazeCanPlacePath's
+//		 rule against path cells meeting only at a corner. The open cells are
+//		 packed into one bitboard row per line of the grid. Each row's runs
+//		 of open cells are read straight off the words and joined to the
+//		 runs they overlap on the row above with a union-find, which gives
+//		 connectivity and every loop in one pass. The corner and 2x2 checks
+//		 compare neighbouring rows 64 cells at a time
+//------------------------------------------------------------------------------
+class MazeValidator
+{
+
+public:
+	MazeValidator();
+
+	//braided mazes have loops on purpose, and the braider may open cells
+	// that meet others only at a corner, so neither is an error
+	void SetAllowLoops( const bool allowLoops ) { m_allowLoops = allowLoops; }
+	bool GetAllowLoops() const { return m_allowLoops; }
+
+	void SetMaxErrors( const int maxErrors ) { m_maxErrors = maxErrors; }
+	int GetMaxErrors() const { return m_maxErrors; }
+
+	//threads ValidateBatch may use, the calling thread included
+	void SetNumThreads( const int numThreads ) { m_numThreads = ( numThreads > 1 ) ? numThreads : 1; }
+	int GetNumThreads() const { return m_numThreads; }
+
+	bool Validate( const Grid& grid, MazeReport& report );
+
+	//validates every grid, sharing them out between threads that each have
+	// a copy of this validator. Returns the number found invalid
+	int ValidateBatch( const vector< const Grid* >& grids, vector< MazeReport >& reports ) const;
+
+private:
+	bool m_allowLoops;
+	int m_maxErrors;
+	int m_numThreads;
+
+	//workspace, kept between calls
+	int m_wordsPerRow;
+	vector< uint64 > m_open;		//one bit per cell, m_wordsPerRow words per row
+	vector< int > m_runStart;		//runs of open cells, row by row
+	vector< int > m_runEnd;			//one past the last cell of each run
+	vector< int > m_rowRuns;		//index of each row's first run, plus an end marker
+	vector< int > m_parent;			//union-find over the runs
+	vector< int > m_rank;
+	vector< int > m_goals;			//goal tiles seen while packing, as y * width + x
+
+	void AddError( MazeReport& report, const MazeError::Kind kind, const int x, const int y ) const;
+
+	void BuildBitboard( const Grid& grid, MazeReport& report );
+	void FindRuns( const int width, const int height );
+	void JoinRuns( const int height, MazeReport& report );
+	void CheckCorners( const int height, MazeReport& report );
+	void CheckPlacement( const Grid& grid, MazeReport& report );
+	void CheckReachable( const Grid& grid, MazeReport& report );
+
+	int FindRun( const int x, const int y ) const;
+	int FindRoot( int run );
+
+};
+
+
+#endif //INCLUSIONGUARD_MAZEVALIDATOR_H
@@ -0,0 +1,501 @@
+//------------------------------------------------------------------------------
+// File: MazeWorld.cpp
+// Desc: Unbounded maze built from chunks generated on demand
+//
+// Created: 20 October 2026 03:58:51
+//
+// (c)2002 Neil Wakefield
+//------------------------------------------------------------------------------
+
+
+//------------------------------------------------------------------------------
+// Included files:
+//------------------------------------------------------------------------------
+#include "MazeWorld.h"
+
+#include <algorithm>
+#include <stdlib.h>
+
+
+//------------------------------------------------------------------------------
+// Globals:
+//------------------------------------------------------------------------------
+namespace
+{
+	const int g_size = MazeWorld::CHUNK_SIZE;
+
+	//kept apart so a chunk's seed and its edges' openings don't line up
+	enum { SALT_CHUNK = 1, SALT_VERTICAL_EDGE = 2, SALT_HORIZONTAL_EDGE = 3 };
+
+	//--------------------------------------------------------------------------
+	// Name: Mix()
+	// Desc: Scrambles the bits of a word, so that nearby inputs give
+	//		 unrelated outputs
+	//--------------------------------------------------------------------------
+	unsigned int Mix( unsigned int h )
+	{
+		h ^= h >> 16;
+		h *= 0x85ebca6bu;
+		h ^= h >> 13;
+		h *= 0xc2b2ae35u;
+		h ^= h >> 16;
+		return h;
+	}
+
+	//--------------------------------------------------------------------------
+	// Name: HashCoords()
+	// Desc: Hash of the world seed and a pair of coordinates
+	//--------------------------------------------------------------------------
+	unsigned int HashCoords( const unsigned int seed, const int a, const int b, const int salt )
+	{
+		unsigned int h = Mix( seed ^ ( (unsigned int)( salt ) * 0x9e3779b9u ) );
+		h = Mix( h + (unsigned int)( a ) );
+		return Mix( h + (unsigned int)( b ) );
+	}
+
+	//--------------------------------------------------------------------------
+	// Name: FloorDiv()
+	// Desc: Divides, rounding towards minus infinity so that negative cells
+	//		 land in the right chunk
+	//--------------------------------------------------------------------------
+	int FloorDiv( const int value, const int divisor )
+	{
+		return ( value >= 0 ) ? value / divisor : -( ( -value + divisor - 1 ) / divisor );
+	}
+
+	//--------------------------------------------------------------------------
+	// Name: IsOpen()
+	// Desc: Checks a cell of a chunk's tiles, treating outside as wall
+	//--------------------------------------------------------------------------
+	bool IsOpen( const unsigned char* pTiles, const int x, const int y )
+	{
+		if( x < 0 || x >= g_size || y < 0 || y >= g_size )
+			return false;
+		return Grid::TILE_WALL != pTiles[ y * g_size + x ];
+	}
+
+	//--------------------------------------------------------------------------
+	// Name: CarveOpening()
+	// Desc: Opens a border cell and carries on inwards until the corridor
+	//		 touches the maze already there
+	//--------------------------------------------------------------------------
+	void CarveOpening( unsigned char* pTiles, int x, int y, const int dx, const int dy )
+	{
+		for( int i = 0; i < g_size; ++i, x += dx, y += dy )
+		{
+			const bool wasOpen = IsOpen( pTiles, x, y );
+			pTiles[ y * g_size + x ] = (unsigned char)( Grid::TILE_PATH );
+			if( wasOpen )
+				break;
+
+			//ahead or to either side, but not back the way we came
+			if( IsOpen( pTiles, x + dx, y + dy ) ||
+				IsOpen( pTiles, x + dy, y + dx ) || IsOpen( pTiles, x - dy, y - dx ) )
+				break;
+		}
+	}
+}
+
+
+//------------------------------------------------------------------------------
+// Definitions:
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Name: MazeWorld()
+// Desc: Constructor for the world, starting the generator threads
+//------------------------------------------------------------------------------
+MazeWorld::MazeWorld( const unsigned int seed, const int numThreads )
+	: m_grid( CHUNK_SIZE, CHUNK_SIZE )
+{
+	m_seed = seed;
+	SetMemoryBudget( CONST_WORLD_MEMORY_BYTES );
+	m_pLastChunk = NULL;
+	m_nextWorker = 0;
+	m_stop = 0;
+	m_maxSearchCells = CONST_WORLD_SEARCH_CELLS;
+
+	int count = numThreads;
+	if( count <= 0 )
+		count = GetNumProcessors() - 1;
+	if( count < 1 )
+		count = 1;
+
+	for( int i = 0; i < count; ++i )
+	{
+		Worker* pWorker = new Worker;
+		pWorker->pWorld = this;
+		if( ! pWorker->thread.Start( RunWorker, pWorker ) )
+		{
+			delete pWorker;
+			break;
+		}
+		m_workers.push_back( pWorker );
+	}
+}
+
+//------------------------------------------------------------------------------
+// Name: ~MazeWorld()
+// Desc: Destructor for the world, stopping the threads and freeing chunks
+//------------------------------------------------------------------------------
+MazeWorld::~MazeWorld()
+{
+	AtomicIncrement( &m_stop );
+	for( size_t i = 0; i < m_workers.size(); ++i )
+	{
+		m_workers[ i ]->wake.Post();
+		m_workers[ i ]->thread.Join();
+
+		//anything still queued was never started
+		MpscNode* pNode;
+		while( ( pNode = m_workers[ i ]->requests.Pop() ) != NULL )
+			delete (Chunk*)( pNode );
+		delete m_workers[ i ];
+	}
+
+	MpscNode* pNode;
+	while( ( pNode = m_finished.Pop() ) != NULL )
+		delete (Chunk*)( pNode );
+
+	for( map< uint64, Chunk* >::iterator it = m_chunks.begin(); it != m_chunks.end(); ++it )
+		delete it->second;
+}
+
+//------------------------------------------------------------------------------
+// Name: SetMemoryBudget()
+// Desc: Sets the memory chunks may use, which is at least one chunk
+//------------------------------------------------------------------------------
+void MazeWorld::SetMemoryBudget( const size_t bytes )
+{
+	m_memoryBudget = bytes;
+	m_maxChunks = int( bytes / sizeof( Chunk ) );
+	if( m_maxChunks < 1 )
+		m_maxChunks = 1;
+}
+
+//------------------------------------------------------------------------------
+// Name: RequestArea()
+// Desc: Marks the loaded chunks around a cell as used, and queues the rest,
+//		 working out from the middle so the nearest are ready first
+//------------------------------------------------------------------------------
+void MazeWorld::RequestArea( const int x, const int y, const int radius )
+{
+	const int minX = FloorDiv( x - radius, CHUNK_SIZE );
+	const int maxX = FloorDiv( x + radius, CHUNK_SIZE );
+	const int minY = FloorDiv( y - radius, CHUNK_SIZE );
+	const int maxY = FloorDiv( y + radius, CHUNK_SIZE );
+	const int centreX = FloorDiv( x, CHUNK_SIZE );
+	const int centreY = FloorDiv( y, CHUNK_SIZE );
+
+	const int rings = max( max( centreX - minX, maxX - centreX ), max( centreY - minY, maxY - centreY ) );
+	for( int ring = 0; ring <= rings; ++ring )
+	{
+		for( int chunkY = max( minY, centreY - ring ); chunkY <= min( maxY, centreY + ring ); ++chunkY )
+		{
+			for( int chunkX = max( minX, centreX - ring ); chunkX <= min( maxX, centreX + ring ); ++chunkX )
+			{
+				//only the cells on the edge of this ring
+				if( abs( chunkX - centreX ) != ring && abs( chunkY - centreY ) != ring )
+					continue;
+
+				const uint64 key = GetKey( chunkX, chunkY );
+				map< uint64, Chunk* >::iterator it = m_chunks.find( key );
+				if( it != m_chunks.end() )
+				{
+					Touch( it->second );
+					continue;
+				}
+				if( m_workers.empty() || ! m_pending.insert( key ).second )
+					continue;
+
+				Chunk* pChunk = new Chunk;
+				pChunk->chunkX = chunkX;
+				pChunk->chunkY = chunkY;
+
+				Worker* pWorker = m_workers[ m_nextWorker ];
+				m_nextWorker = ( m_nextWorker + 1 ) % int( m_workers.size() );
+				pWorker->requests.Push( pChunk );
+				pWorker->wake.Post();
+			}
+		}
+	}
+}
+
+//------------------------------------------------------------------------------
+// Name: Update()
+// Desc: Takes in the chunks the workers have finished, then evicts the least
+//		 recently used until the world is back in budget
+//------------------------------------------------------------------------------
+void MazeWorld::Update()
+{
+	MpscNode* pNode;
+	while( ( pNode = m_finished.Pop() ) != NULL )
+	{
+		Chunk* pChunk = (Chunk*)( pNode );
+		const uint64 key = GetKey( pChunk->chunkX, pChunk->chunkY );
+		m_pending.erase( key );
+
+		//FindPath may have needed it first
+		if( m_chunks.find( key ) != m_chunks.end() )
+			delete pChunk;
+		else
+			Insert( pChunk );
+	}
+
+	while( int( m_chunks.size() ) > m_maxChunks )
+	{
+		Chunk* pChunk = m_used.back();
+		m_used.pop_back();
+		m_chunks.erase( GetKey( pChunk->chunkX, pChunk->chunkY ) );
+		if( m_pLastChunk == pChunk )
+			m_pLastChunk = NULL;
+		delete pChunk;
+	}
+}
+
+//------------------------------------------------------------------------------
+// Name: GetTile()
+// Desc: Returns the tile at a world cell
+//------------------------------------------------------------------------------
+Grid::GridTile MazeWorld::GetTile( const int x, const int y ) const
+{
+	const Chunk* pChunk = FindChunk( x, y );
+	if( NULL == pChunk )
+		return Grid::TILE_WALL;
+
+	const int localX = x - pChunk->chunkX * CHUNK_SIZE;
+	const int localY = y - pChunk->chunkY * CHUNK_SIZE;
+	return Grid::GridTile( pChunk->tiles[ localY * CHUNK_SIZE + localX ] );
+}
+
+//------------------------------------------------------------------------------
+// Name: FindPath()
+// Desc: A* search between two cells, inside a box of whole chunks reaching a
+//		 chunk past both ends in every direction
+//------------------------------------------------------------------------------
+bool MazeWorld::FindPath( const int fromX, const int fromY, const int toX, const int toY,
+						  vector< MazeSquare >& path )
+{
+	path.clear();
+
+	const int minChunkX = FloorDiv( min( fromX, toX ), CHUNK_SIZE ) - 1;
+	const int maxChunkX = FloorDiv( max( fromX, toX ), CHUNK_SIZE ) + 1;
+	const int minChunkY = FloorDiv( min( fromY, toY ), CHUNK_SIZE ) - 1;
+	const int maxChunkY = FloorDiv( max( fromY, toY ), CHUNK_SIZE ) + 1;
+	const int chunksX = maxChunkX - minChunkX + 1;
+	const int chunksY = maxChunkY - minChunkY + 1;
+	const int width = chunksX * CHUNK_SIZE;
+	const int height = chunksY * CHUNK_SIZE;
+	if( double( width ) * double( height ) > double( m_maxSearchCells ) )
+		return false;
+
+	m_searchChunks.resize( chunksX * chunksY );
+	for( int chunkY = 0; chunkY < chunksY; ++chunkY )
+		for( int chunkX = 0; chunkX < chunksX; ++chunkX )
+			m_searchChunks[ chunkY * chunksX + chunkX ] = LoadChunk( minChunkX + chunkX, minChunkY + chunkY );
+
+	//cells of the box, counted from its bottom left corner
+	const int originX = minChunkX * CHUNK_SIZE;
+	const int originY = minChunkY * CHUNK_SIZE;
+	const int startX = fromX - originX;
+	const int startY = fromY - originY;
+	const int goalX = toX - originX;
+	const int goalY = toY - originY;
+
+	//an offset for each move, in the order of Grid::Direction
+	const int moveX[ 4 ] = { 0, 1, 0, -1 };
+	const int moveY[ 4 ] = { 1, 0, -1, 0 };
+
+	const int numCells = width * height;
+	m_searchCost.assign( numCells, -1 );
+	m_searchParent.resize( numCells );
+	m_openQueue.Resize( numCells, 2 );
+
+	if( ! IsPath( fromX, fromY ) || ! IsPath( toX, toY ) )
+		return false;
+
+	const int startCell = startY * width + startX;
+	const int goalCell = goalY * width + goalX;
+	m_searchCost[ startCell ] = 0;
+	m_searchParent[ startCell ] = -1;
+	m_openQueue.Push( startCell, abs( goalX - startX ) + abs( goalY - startY ) );
+
+	bool found = false;
+	while( ! m_openQueue.IsEmpty() )
+	{
+		const int cell = m_openQueue.Pop();
+		if( cell == goalCell )
+		{
+			found = true;
+			break;
+		}
+
+		const int cellX = cell % width;
+		const int cellY = cell / width;
+		const int cost = m_searchCost[ cell ] + 1;
+		for( int d = 0; d < 4; ++d )
+		{
+			const int x = cellX + moveX[ d ];
+			const int y = cellY + moveY[ d ];
+			if( x < 0 || x >= width || y < 0 || y >= height )
+				continue;
+
+			const Chunk* pChunk = m_searchChunks[ ( y / CHUNK_SIZE ) * chunksX + x / CHUNK_SIZE ];
+			if( Grid::TILE_WALL == pChunk->tiles[ ( y % CHUNK_SIZE ) * CHUNK_SIZE + x % CHUNK_SIZE ] )
+				continue;
+
+			const int next = y * width + x;
+			if( m_searchCost[ next ] >= 0 && m_searchCost[ next ] <= cost )
+				continue;
+
+			//with unit steps and a consistent heuristic, a cell is never
+			// reached more cheaply once it has been expanded
+			if( m_openQueue.Contains( next ) )
+				m_openQueue.Remove( next );
+			m_searchCost[ next ] = cost;
+			m_searchParent[ next ] = cell;
+			m_openQueue.Push( next, cost + abs( goalX - x ) + abs( goalY - y ) );
+		}
+	}
+
+	if( ! found )
+		return false;
+
+	for( int cell = goalCell; cell >= 0; cell = m_searchParent[ cell ] )
+		path.push_back( MazeSquare( originX + cell % width, originY + cell / width ) );
+	reverse( path.begin(), path.end() );
+	return true;
+}
+
+//------------------------------------------------------------------------------
+// Name: GenerateChunk()
+// Desc: Generates a chunk's maze and opens its edges to its neighbours
+//------------------------------------------------------------------------------
+void MazeWorld::GenerateChunk( const unsigned int seed, const int chunkX, const int chunkY,
+							   Grid& workspace, unsigned char* pTiles )
+{
+	workspace.GenerateMaze( HashCoords( seed, chunkX, chunkY, SALT_CHUNK ) );
+
+	//the grid's entrance and exit mean nothing here, so they become path
+	for( int y = 0; y < CHUNK_SIZE; ++y )
+	{
+		for( int x = 0; x < CHUNK_SIZE; ++x )
+		{
+			const bool wall = ( Grid::TILE_WALL == workspace.GetTile( x, y ) );
+			pTiles[ y * CHUNK_SIZE + x ] = (unsigned char)( wall ? Grid::TILE_WALL : Grid::TILE_PATH );
+		}
+	}
+
+	CarveOpening( pTiles, 0, GetOpening( seed, chunkX, chunkY, true ), 1, 0 );
+	CarveOpening( pTiles, CHUNK_SIZE - 1, GetOpening( seed, chunkX + 1, chunkY, true ), -1, 0 );
+	CarveOpening( pTiles, GetOpening( seed, chunkX, chunkY, false ), 0, 0, 1 );
+	CarveOpening( pTiles, GetOpening( seed, chunkX, chunkY + 1, false ), CHUNK_SIZE - 1, 0, -1 );
+}
+
+//------------------------------------------------------------------------------
+// Name: GetOpening()
+// Desc: Returns where a chunk's left or bottom edge is opened. Each edge is
+//		 named by the chunk above or to the right of it, so both sides agree
+//------------------------------------------------------------------------------
+int MazeWorld::GetOpening( const unsigned int seed, const int chunkX, const int chunkY, const bool vertical )
+{
+	const int salt = vertical ? SALT_VERTICAL_EDGE : SALT_HORIZONTAL_EDGE;
+	return int( HashCoords( seed, chunkX, chunkY, salt ) % CHUNK_SIZE );
+}
+
+//------------------------------------------------------------------------------
+// Name: GetKey()
+// Desc: Packs a chunk's coordinates into one number for the maps
+//------------------------------------------------------------------------------
+uint64 MazeWorld::GetKey( const int chunkX, const int chunkY )
+{
+	return ( uint64( (unsigned int)( chunkX ) ) << 32 ) | uint64( (unsigned int)( chunkY ) );
+}
+
+//------------------------------------------------------------------------------
+// Name: FindChunk()
+// Desc: Returns the loaded chunk holding a world cell, or NULL
+//------------------------------------------------------------------------------
+const MazeWorld::Chunk* MazeWorld::FindChunk( const int x, const int y ) const
+{
+	const int chunkX = FloorDiv( x, CHUNK_SIZE );
+	const int chunkY = FloorDiv( y, CHUNK_SIZE );
+	if( m_pLastChunk != NULL && m_pLastChunk->chunkX == chunkX && m_pLastChunk->chunkY == chunkY )
+		return m_pLastChunk;
+
+	map< uint64, Chunk* >::const_iterator it = m_chunks.find( GetKey( chunkX, chunkY ) );
+	if( it == m_chunks.end() )
+		return NULL;
+
+	m_pLastChunk = it->second;
+	return m_pLastChunk;
+}
+
+//------------------------------------------------------------------------------
+// Name: LoadChunk()
+// Desc: Returns a chunk, generating it here and now if it isn't loaded. It
+//		 stays until the next Update at least
+//------------------------------------------------------------------------------
+const MazeWorld::Chunk* MazeWorld::LoadChunk( const int chunkX, const int chunkY )
+{
+	map< uint64, Chunk* >::iterator it = m_chunks.find( GetKey( chunkX, chunkY ) );
+	if( it != m_chunks.end() )
+	{
+		Touch( it->second );
+		return it->second;
+	}
+
+	Chunk* pChunk = new Chunk;
+	pChunk->chunkX = chunkX;
+	pChunk->chunkY = chunkY;
+	GenerateChunk( m_seed, chunkX, chunkY, m_grid, pChunk->tiles );
+	Insert( pChunk );
+	return pChunk;
+}
+
+//------------------------------------------------------------------------------
+// Name: Insert()
+// Desc: Adds a chunk to the loaded set as the most recently used
+//------------------------------------------------------------------------------
+void MazeWorld::Insert( Chunk* pChunk )
+{
+	m_chunks[ GetKey( pChunk->chunkX, pChunk->chunkY ) ] = pChunk;
+	m_used.push_front( pChunk );
+	pChunk->used = m_used.begin();
+}
+
+//------------------------------------------------------------------------------
+// Name: Touch()
+// Desc: Moves a chunk to the front of the used list
+//------------------------------------------------------------------------------
+void MazeWorld::Touch( Chunk* pChunk )
+{
+	m_used.splice( m_used.begin(), m_used, pChunk->used );
+}
+
+//------------------------------------------------------------------------------
+// Name: RunWorker()
+// Desc: Background thread filling in the chunks queued for it, until the
+//		 world is destroyed
+//------------------------------------------------------------------------------
+void MazeWorld::RunWorker( void* pWorker )
+{
+	Worker& worker = *( (Worker*)( pWorker ) );
+	MazeWorld& world = *worker.pWorld;
+
+	while( true )
+	{
+		worker.wake.Wait();
+		if( world.m_stop )
+			break;
+
+		//the push that woke us may not quite have finished
+		MpscNode* pNode;
+		while( ( pNode = worker.requests.Pop() ) == NULL )
+			YieldThread();
+
+		Chunk* pChunk = (Chunk*)( pNode );
+		GenerateChunk( world.m_seed, pChunk->chunkX, pChunk->chunkY, worker.grid, pChunk->tiles );
+		world.m_finished.Push( pChunk );
+	}
+}
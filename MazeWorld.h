@@ -0,0 +1,159 @@
+//------------------------------------------------------------------------------
+// File: MazeWorld.h
+// Desc: Unbounded maze built from chunks generated on demand
+//
+// Created: 20 October 2026 03:42:19
+//
+// (c)2002 Neil Wakefield
+//------------------------------------------------------------------------------
+
+
+#ifndef INCLUSIONGUARD_MAZEWORLD_H
+#define INCLUSIONGUARD_MAZEWORLD_H
+
+
+//------------------------------------------------------------------------------
+// Included files:
+//------------------------------------------------------------------------------
+#include "BucketQueue.h"
+#include "Constants.h"
+#include "Grid.h"
+#include "Threading.h"
+#include "Types.h"
+
+#include <list>
+#include <map>
+#include <set>
+#include <vector>
+using namespace std;
+
+
+//------------------------------------------------------------------------------
+// Prototypes and declarations:
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Name: class MazeWorld
+// Desc: A maze with no edges, split into square chunks of world cells. Each
+//		 chunk is a Grid maze generated from a seed hashed out of the world
+//		 seed and the chunk's coordinates, so it comes out the same whenever
+//		 and wherever it is made. Every edge between two chunks has one
+//		 opening, at a place hashed from the edge's coordinates so both sides
+//		 agree on it, and each chunk carves in from its openings until it
+//		 meets its own maze.
+//
+//		 RequestArea queues the chunks around an agent or the camera for
+//		 background threads, nearest first, and Update takes in the finished
+//		 ones and evicts the least recently requested to stay in budget.
+//		 Neither waits on generation. FindPath searches across chunks inside
+//		 a box around its ends, generating any missing chunks of the box on
+//		 the calling thread. Everything but the generation itself belongs to
+//		 the thread that owns the world
+//------------------------------------------------------------------------------
+class MazeWorld
+{
+
+public:
+	enum { CHUNK_SIZE = CONST_WORLD_CHUNK_SIZE };
+
+	//numThreads of 0 uses one fewer than there are processors, but always
+	// at least one
+	MazeWorld( const unsigned int seed, const int numThreads = 0 );
+	~MazeWorld();
+
+	unsigned int GetSeed() const { return m_seed; }
+
+	//bytes of chunks kept once Update has evicted
+	void SetMemoryBudget( const size_t bytes );
+	size_t GetMemoryBudget() const { return m_memoryBudget; }
+
+	//cells a FindPath box may cover before the search is refused
+	void SetMaxSearchCells( const int cells ) { m_maxSearchCells = cells; }
+	int GetMaxSearchCells() const { return m_maxSearchCells; }
+
+	//wants every chunk within radius cells of x, y, and marks them used
+	void RequestArea( const int x, const int y, const int radius );
+	void Update();
+
+	//cells of chunks not yet loaded read as wall
+	bool IsLoaded( const int x, const int y ) const { return FindChunk( x, y ) != NULL; }
+	Grid::GridTile GetTile( const int x, const int y ) const;
+	bool IsPath( const int x, const int y ) const { return Grid::TILE_WALL != GetTile( x, y ); }
+
+	//shortest route between two open cells, both ends included. Returns
+	// false if there isn't one inside the search box
+	bool FindPath( const int fromX, const int fromY, const int toX, const int toY,
+				   vector< MazeSquare >& path );
+
+	int GetNumChunks() const { return int( m_chunks.size() ); }
+	int GetNumPending() const { return int( m_pending.size() ); }
+
+	//fills pTiles with a chunk's cells, row by row. workspace must be a
+	// CHUNK_SIZE square Grid
+	static void GenerateChunk( const unsigned int seed, const int chunkX, const int chunkY,
+							   Grid& workspace, unsigned char* pTiles );
+
+	//the cell along a chunk's left or bottom edge where it opens to the chunk
+	// beside it, counted from the chunk's bottom or left
+	static int GetOpening( const unsigned int seed, const int chunkX, const int chunkY, const bool vertical );
+
+private:
+	struct Chunk : public MpscNode
+	{
+		int chunkX;
+		int chunkY;
+		unsigned char tiles[ CHUNK_SIZE * CHUNK_SIZE ];
+		list< Chunk* >::iterator used;	//place in m_used
+	};
+
+	//a background generator, with its own queue of chunks to fill
+	struct Worker
+	{
+		MazeWorld* pWorld;
+		Grid grid;
+		MpscQueue requests;
+		Semaphore wake;
+		Thread thread;
+
+		Worker() : grid( CHUNK_SIZE, CHUNK_SIZE ) {}
+	};
+
+	unsigned int m_seed;
+	size_t m_memoryBudget;
+	int m_maxChunks;
+
+	map< uint64, Chunk* > m_chunks;
+	list< Chunk* > m_used;				//most recently used first
+	set< uint64 > m_pending;			//handed to a worker, not back yet
+	mutable const Chunk* m_pLastChunk;	//lookups tend to stay in one chunk
+
+	vector< Worker* > m_workers;
+	int m_nextWorker;
+	MpscQueue m_finished;
+	volatile long m_stop;
+
+	Grid m_grid;	//for chunks FindPath can't wait for
+
+	//search workspace, over a box of whole chunks
+	int m_maxSearchCells;
+	vector< const Chunk* > m_searchChunks;
+	vector< int > m_searchCost;
+	vector< int > m_searchParent;
+	BucketQueue m_openQueue;
+
+	static uint64 GetKey( const int chunkX, const int chunkY );
+	const Chunk* FindChunk( const int x, const int y ) const;
+	const Chunk* LoadChunk( const int chunkX, const int chunkY );
+	void Insert( Chunk* pChunk );
+	void Touch( Chunk* pChunk );
+
+	static void RunWorker( void* pWorker );
+
+	//not copyable, as the workers point back at it
+	MazeWorld( const MazeWorld& );
+	MazeWorld& operator=( const MazeWorld& );
+
+};
+
+
+#endif //INCLUSIONGUARD_MAZEWORLD_H
@@ -0,0 +1,215 @@
+//------------------------------------------------------------------------------
+// File: MemoryArena.cpp
+// Desc: Bump allocator that gives back everything it handed out at once
+//
+// Created: 20 October 2026 07:38:16
+//
+// (c)2002 Neil Wakefield
+//------------------------------------------------------------------------------
+
+
+//------------------------------------------------------------------------------
+// Included files:
+//------------------------------------------------------------------------------
+#include "MemoryArena.h"
+#include "MemoryTracker.h"
+#include "Threading.h"
+
+#include <stdlib.h>
+
+
+//------------------------------------------------------------------------------
+// Definitions:
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Name: MemoryArena()
+// Desc: Constructor for the arena object. No memory is taken until needed
+//------------------------------------------------------------------------------
+MemoryArena::MemoryArena( const size_t blockSize )
+{
+	m_blockSize = ( blockSize > ALIGNMENT ) ? blockSize : ALIGNMENT;
+	m_current = 0;
+	m_offset = 0;
+	m_usedBefore = 0;
+	m_numLive = 0;
+	m_lock = 0;
+	m_installed = false;
+}
+
+//------------------------------------------------------------------------------
+// Name: ~MemoryArena()
+// Desc: Destructor for the arena object
+//------------------------------------------------------------------------------
+MemoryArena::~MemoryArena()
+{
+	Uninstall();
+
+	for( size_t i = 0; i < m_blocks.size(); ++i )
+		free( m_blocks[ i ].pMemory );
+}
+
+//------------------------------------------------------------------------------
+// Name: Allocate()
+// Desc: Hands out the next piece of the current block, moving on to a later
+//		 block, or a new one, if it doesn't fit
+//------------------------------------------------------------------------------
+void* MemoryArena::Allocate( const size_t bytes )
+{
+	const size_t size = ( bytes + ALIGNMENT - 1 ) & ~( ALIGNMENT - 1 );
+	if( size < bytes )
+		return NULL;
+
+	Lock();
+
+	//blocks kept from before the last Reset are tried in order. Any too small
+	// for this are skipped until the next Reset
+	while( m_current < m_blocks.size() && m_offset + size > m_blocks[ m_current ].size )
+	{
+		m_usedBefore += m_offset;
+		m_offset = 0;
+		++m_current;
+	}
+
+	if( m_current == m_blocks.size() )
+	{
+		Block block;
+		block.size = ( size > m_blockSize ) ? size : m_blockSize;
+		block.pMemory = malloc( block.size + ALIGNMENT - 1 );
+		if( NULL == block.pMemory )
+		{
+			Unlock();
+			return NULL;
+		}
+
+		const size_t address = (size_t)( block.pMemory );
+		block.pStart = (unsigned char*)( ( address + ALIGNMENT - 1 ) & ~( ALIGNMENT - 1 ) );
+		m_blocks.push_back( block );
+	}
+
+	void* pMemory = m_blocks[ m_current ].pStart + m_offset;
+	m_offset += size;
+	AtomicIncrement( &m_numLive );	//frees don't take the lock
+
+	Unlock();
+	return pMemory;
+}
+
+//------------------------------------------------------------------------------
+// Name: Free()
+// Desc: Counts an allocation off. Its memory stays used until the Reset
+//------------------------------------------------------------------------------
+void MemoryArena::Free( void* pMemory )
+{
+	if( pMemory != NULL )
+		AtomicDecrement( &m_numLive );
+}
+
+//------------------------------------------------------------------------------
+// Name: Reset()
+// Desc: Makes every block free to hand out again
+//------------------------------------------------------------------------------
+bool MemoryArena::Reset()
+{
+	Lock();
+
+	const bool canReset = ( 0 == m_numLive );
+	if( canReset )
+	{
+		m_current = 0;
+		m_offset = 0;
+		m_usedBefore = 0;
+	}
+
+	Unlock();
+	return canReset;
+}
+
+//------------------------------------------------------------------------------
+// Name: Install()
+// Desc: Sends tracked allocations to this arena
+//------------------------------------------------------------------------------
+bool MemoryArena::Install()
+{
+	if( m_installed )
+		return true;
+
+	m_installed = MemoryTracker::SetHooks( AllocateHook, FreeHook, this );
+	return m_installed;
+}
+
+//------------------------------------------------------------------------------
+// Name: Uninstall()
+// Desc: Sends tracked allocations back to the heap
+//------------------------------------------------------------------------------
+bool MemoryArena::Uninstall()
+{
+	if( ! m_installed )
+		return true;
+
+	if( ! MemoryTracker::SetHooks( NULL, NULL, NULL ) )
+		return false;
+
+	m_installed = false;
+	return true;
+}
+
+//------------------------------------------------------------------------------
+// Name: GetNumBytesUsed()
+// Desc: Returns the bytes handed out since the last Reset, padding included
+//------------------------------------------------------------------------------
+size_t MemoryArena::GetNumBytesUsed() const
+{
+	return m_usedBefore + m_offset;
+}
+
+//------------------------------------------------------------------------------
+// Name: GetNumBytesReserved()
+// Desc: Returns the size of every block together
+//------------------------------------------------------------------------------
+size_t MemoryArena::GetNumBytesReserved() const
+{
+	size_t total = 0;
+	for( size_t i = 0; i < m_blocks.size(); ++i )
+		total += m_blocks[ i ].size;
+
+	return total;
+}
+
+//------------------------------------------------------------------------------
+// Name: Lock()
+// Desc: Spins until this thread holds the arena. Allocations are short, so
+//		 waiting threads yield rather than sleep
+//------------------------------------------------------------------------------
+void MemoryArena::Lock()
+{
+	while( AtomicCompareExchange( &m_lock, 1, 0 ) != 0 )
+		YieldThread();
+}
+
+//------------------------------------------------------------------------------
+// Name: Unlock()
+// Desc: Lets the next thread in
+//------------------------------------------------------------------------------
+void MemoryArena::Unlock()
+{
+	AtomicCompareExchange( &m_lock, 0, 1 );
+}
+
+//------------------------------------------------------------------------------
+// Name: AllocateHook()
+// Desc: Passes the tracker's allocations on to an arena
+//------------------------------------------------------------------------------
+void* MemoryArena::AllocateHook( const size_t bytes, void* pArena )
+{
+	return ( (MemoryArena*)( pArena ) )->Allocate( bytes );
+}
+
+//------------------------------------------------------------------------------
+// Name: FreeHook()
+// Desc: Passes the tracker's frees on to an arena
+//------------------------------------------------------------------------------
+void MemoryArena::FreeHook( void* pMemory, const size_t, void* pArena )
+{
+	( (MemoryArena*)( pArena ) )->Free( pMemory );
+}
@@ -0,0 +1,98 @@
+//------------------------------------------------------------------------------
+// File: MemoryArena.h
+// Desc: Bump allocator that gives back everything it handed out at once
+//
+// Created: 20 October 2026 07:24:51
+//
+// (c)2002 Neil Wakefield
+//------------------------------------------------------------------------------
+
+
+#ifndef INCLUSIONGUARD_MEMORYARENA_H
+#define INCLUSIONGUARD_MEMORYARENA_H
+
+
+//------------------------------------------------------------------------------
+// Included files:
+//------------------------------------------------------------------------------
+#include <stddef.h>
+
+#include <vector>
+using namespace std;
+
+
+//------------------------------------------------------------------------------
+// Prototypes and declarations:
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Name: class MemoryArena
+// Desc: Hands out memory from large blocks by moving a pointer along them.
+//		 Freeing only counts the allocation off; nothing is reused until Reset,
+//		 which rewinds to the first block in one step and keeps the blocks for
+//		 the next maze. Once installed, every tracked Grid and solver container
+//		 allocates from it, so a maze built and solved from scratch can be
+//		 thrown away with the Grid and a Reset.
+//
+//		 A vector that grows leaves its old buffer behind until the Reset, so
+//		 an arena suits mazes whose size is known up front, and holds more at
+//		 its peak than the heap would
+//------------------------------------------------------------------------------
+class MemoryArena
+{
+
+public:
+	static const size_t DEFAULT_BLOCK_SIZE = 4 * 1024 * 1024;
+	static const size_t ALIGNMENT = 16;		//enough for any SSE type
+
+	MemoryArena( const size_t blockSize = DEFAULT_BLOCK_SIZE );
+	~MemoryArena();
+
+	void* Allocate( const size_t bytes );
+	void Free( void* pMemory );
+
+	//fails while anything handed out has not been freed
+	bool Reset();
+
+	//routes the MemoryTracker through this arena, or back to the heap. Both
+	// fail while any tracked memory is allocated
+	bool Install();
+	bool Uninstall();
+	bool IsInstalled() const { return m_installed; }
+
+	long GetNumLive() const { return m_numLive; }
+	size_t GetNumBytesUsed() const;			//since the last Reset
+	size_t GetNumBytesReserved() const;		//held in blocks
+
+private:
+	struct Block
+	{
+		void* pMemory;			//as malloc gave it
+		unsigned char* pStart;	//aligned
+		size_t size;
+	};
+
+	size_t m_blockSize;
+	vector< Block > m_blocks;
+	size_t m_current;		//block being handed out from
+	size_t m_offset;		//into the current block
+	size_t m_usedBefore;	//bytes handed out from the blocks before it
+
+	volatile long m_numLive;
+	volatile long m_lock;	//the tracker can be called from several threads
+	bool m_installed;
+
+	void Lock();
+	void Unlock();
+
+	static void* AllocateHook( const size_t bytes, void* pArena );
+	static void FreeHook( void* pMemory, const size_t bytes, void* pArena );
+
+	//not copyable
+	MemoryArena( const MemoryArena& );
+	MemoryArena& operator=( const MemoryArena& );
+
+};
+
+
+#endif //INCLUSIONGUARD_MEMORYARENA_H
@@ -0,0 +1,224 @@
+//------------------------------------------------------------------------------
+// File: MemoryTracker.cpp
+// Desc: Counts the memory the maze and its solvers hold, by subsystem
+//
+// Created: 20 October 2026 07:09:40
+//
+// (c)2002 Neil Wakefield
+//------------------------------------------------------------------------------
+
+
+//------------------------------------------------------------------------------
+// Included files:
+//------------------------------------------------------------------------------
+#include "MemoryTracker.h"
+#include "Threading.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+
+//------------------------------------------------------------------------------
+// Globals:
+//------------------------------------------------------------------------------
+namespace
+{
+	//zero before any constructor runs, so containers made during static
+	// initialisation are counted too
+	volatile long g_bytes[ MemoryTracker::NUM_SUBSYSTEMS ];
+	volatile long g_peakBytes[ MemoryTracker::NUM_SUBSYSTEMS ];
+	volatile long g_numLive[ MemoryTracker::NUM_SUBSYSTEMS ];
+	volatile long g_numAllocations[ MemoryTracker::NUM_SUBSYSTEMS ];
+
+	MemoryAllocateHook g_pAllocate = NULL;
+	MemoryFreeHook g_pFree = NULL;
+	void* g_pContext = NULL;
+
+	//--------------------------------------------------------------------------
+	// Name: FormatBytes()
+	// Desc: Writes a size in the largest unit that keeps it above one
+	//--------------------------------------------------------------------------
+	void FormatBytes( const long bytes, char* pText )
+	{
+		if( bytes >= 1024 * 1024 )
+			sprintf( pText, "%.1f MB", bytes / ( 1024.0 * 1024.0 ) );
+		else if( bytes >= 1024 )
+			sprintf( pText, "%.1f KB", bytes / 1024.0 );
+		else
+			sprintf( pText, "%ld B", bytes );
+	}
+}
+
+
+//------------------------------------------------------------------------------
+// Definitions:
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Name: GetName()
+// Desc: Returns a short name for a subsystem, for reports
+//------------------------------------------------------------------------------
+const char* MemoryTracker::GetName( const Subsystem subsystem )
+{
+	switch( subsystem )
+	{
+	case SUBSYSTEM_TILES:		return "tiles";
+	case SUBSYSTEM_GENERATOR:	return "generator";
+	case SUBSYSTEM_SOLVER:		return "solver";
+	case SUBSYSTEM_SOLUTION:	return "solution";
+	default:					return "unknown";
+	}
+}
+
+//------------------------------------------------------------------------------
+// Name: SetHooks()
+// Desc: Routes tracked memory through other functions
+//------------------------------------------------------------------------------
+bool MemoryTracker::SetHooks( MemoryAllocateHook pAllocate, MemoryFreeHook pFree, void* pContext )
+{
+	for( int i = 0; i < NUM_SUBSYSTEMS; ++i )
+	{
+		if( g_numLive[ i ] != 0 )
+			return false;
+	}
+
+	//both or neither, as memory from one can't go to the other
+	if( NULL == pAllocate || NULL == pFree )
+	{
+		pAllocate = NULL;
+		pFree = NULL;
+		pContext = NULL;
+	}
+
+	g_pAllocate = pAllocate;
+	g_pFree = pFree;
+	g_pContext = pContext;
+	return true;
+}
+
+//------------------------------------------------------------------------------
+// Name: Allocate()
+// Desc: Gets memory from the hooks, counting it against a subsystem
+//------------------------------------------------------------------------------
+void* MemoryTracker::Allocate( const size_t bytes, const Subsystem subsystem )
+{
+	void* pMemory = g_pAllocate ? g_pAllocate( bytes, g_pContext ) : malloc( bytes );
+	if( NULL == pMemory )
+		return NULL;
+
+	AtomicIncrement( &g_numLive[ subsystem ] );
+	AtomicIncrement( &g_numAllocations[ subsystem ] );
+	const long total = AtomicAdd( &g_bytes[ subsystem ], long( bytes ) );
+
+	//another thread may raise the peak between the read and the exchange,
+	// in which case the exchange fails and the new peak is checked again
+	long peak = g_peakBytes[ subsystem ];
+	while( total > peak )
+	{
+		const long seen = AtomicCompareExchange( &g_peakBytes[ subsystem ], total, peak );
+		if( seen == peak )
+			break;
+		peak = seen;
+	}
+
+	return pMemory;
+}
+
+//------------------------------------------------------------------------------
+// Name: Free()
+// Desc: Gives memory back to the hooks it came from
+//------------------------------------------------------------------------------
+void MemoryTracker::Free( void* pMemory, const size_t bytes, const Subsystem subsystem )
+{
+	if( NULL == pMemory )
+		return;
+
+	AtomicDecrement( &g_numLive[ subsystem ] );
+	AtomicAdd( &g_bytes[ subsystem ], -long( bytes ) );
+
+	if( g_pFree )
+		g_pFree( pMemory, bytes, g_pContext );
+	else
+		free( pMemory );
+}
+
+//------------------------------------------------------------------------------
+// Name: GetCounters()
+// Desc: Reads one subsystem's counters. They are read one at a time, so may
+//		 be slightly out of step with each other while other threads allocate
+//------------------------------------------------------------------------------
+void MemoryTracker::GetCounters( const Subsystem subsystem, MemoryCounters& counters )
+{
+	counters.bytes = g_bytes[ subsystem ];
+	counters.peakBytes = g_peakBytes[ subsystem ];
+	counters.numLive = g_numLive[ subsystem ];
+	counters.numAllocations = g_numAllocations[ subsystem ];
+}
+
+//------------------------------------------------------------------------------
+// Name: GetTotalBytes()
+// Desc: Returns the bytes held by every subsystem together
+//------------------------------------------------------------------------------
+long MemoryTracker::GetTotalBytes()
+{
+	long total = 0;
+	for( int i = 0; i < NUM_SUBSYSTEMS; ++i )
+		total += g_bytes[ i ];
+
+	return total;
+}
+
+//------------------------------------------------------------------------------
+// Name: ResetPeaks()
+// Desc: Starts the peaks again from what is held now
+//------------------------------------------------------------------------------
+void MemoryTracker::ResetPeaks()
+{
+	for( int i = 0; i < NUM_SUBSYSTEMS; ++i )
+	{
+		long peak = g_peakBytes[ i ];
+		while( true )
+		{
+			const long seen = AtomicCompareExchange( &g_peakBytes[ i ], g_bytes[ i ], peak );
+			if( seen == peak )
+				break;
+			peak = seen;
+		}
+	}
+}
+
+//------------------------------------------------------------------------------
+// Name: GetReport()
+// Desc: Formats the counters for every subsystem, one per line
+//------------------------------------------------------------------------------
+string MemoryTracker::GetReport()
+{
+	string report;
+	char line[ 256 ];
+	char now[ 32 ];
+	char peak[ 32 ];
+
+	long totalBytes = 0;
+	long totalPeak = 0;
+	for( int i = 0; i < NUM_SUBSYSTEMS; ++i )
+	{
+		MemoryCounters counters;
+		GetCounters( Subsystem( i ), counters );
+		totalBytes += counters.bytes;
+		totalPeak += counters.peakBytes;
+
+		FormatBytes( counters.bytes, now );
+		FormatBytes( counters.peakBytes, peak );
+		sprintf( line, "%-10s %10s held, %10s peak, %6ld live of %ld allocations\n",
+				 GetName( Subsystem( i ) ), now, peak, counters.numLive, counters.numAllocations );
+		report += line;
+	}
+
+	//the peaks may have come at different times, so their sum is an upper bound
+	FormatBytes( totalBytes, now );
+	FormatBytes( totalPeak, peak );
+	sprintf( line, "%-10s %10s held, %10s peak at most\n", "total", now, peak );
+	report += line;
+
+	return report;
+}
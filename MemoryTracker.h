@@ -0,0 +1,158 @@
+//------------------------------------------------------------------------------
+// File: MemoryTracker.h
+// Desc: Counts the memory the maze and its solvers hold, by subsystem
+//
+// Created: 20 October 2026 06:58:12
+//
+// (c)2002 Neil Wakefield
+//------------------------------------------------------------------------------
+
+
+#ifndef INCLUSIONGUARD_MEMORYTRACKER_H
+#define INCLUSIONGUARD_MEMORYTRACKER_H
+
+
+//------------------------------------------------------------------------------
+// Included files:
+//------------------------------------------------------------------------------
+#include <stddef.h>
+
+#include <new>
+#include <string>
+#include <vector>
+using namespace std;
+
+
+//------------------------------------------------------------------------------
+// Prototypes and declarations:
+//------------------------------------------------------------------------------
+
+//where tracked memory comes from and goes back to - see MemoryTracker::SetHooks
+typedef void* ( *MemoryAllocateHook )( const size_t bytes, void* pContext );
+typedef void ( *MemoryFreeHook )( void* pMemory, const size_t bytes, void* pContext );
+
+//------------------------------------------------------------------------------
+// Name: struct MemoryCounters
+// Desc: One subsystem's use of memory
+//------------------------------------------------------------------------------
+struct MemoryCounters
+{
+	long bytes;				//held now
+	long peakBytes;			//most held at once since the last ResetPeaks
+	long numLive;			//allocations not yet freed
+	long numAllocations;	//made in all
+};
+
+//------------------------------------------------------------------------------
+// Name: class MemoryTracker
+// Desc: Every Grid and solver container allocates through here, using a
+//		 TrackedAllocator that names the subsystem it belongs to. The counts
+//		 are kept with atomic operations, as the daemon and the parallel
+//		 solver fill containers from several threads. The memory itself
+//		 comes from malloc unless other hooks are set, such as a MemoryArena's
+//------------------------------------------------------------------------------
+class MemoryTracker
+{
+
+public:
+	enum Subsystem
+	{
+		SUBSYSTEM_TILES,		//tiles, weights, layout tables and exits
+		SUBSYSTEM_GENERATOR,	//generator frontier and braiding candidates
+		SUBSYSTEM_SOLVER,		//search costs, parents, queues and tables
+		SUBSYSTEM_SOLUTION,		//solution paths, and the cache of them
+		NUM_SUBSYSTEMS
+	};
+
+	static const char* GetName( const Subsystem subsystem );
+
+	//memory has to go back to the hooks it came from, so they can only be
+	// changed while nothing tracked is allocated. Returns false otherwise.
+	// NULL hooks go back to malloc and free
+	static bool SetHooks( MemoryAllocateHook pAllocate, MemoryFreeHook pFree, void* pContext );
+
+	static void* Allocate( const size_t bytes, const Subsystem subsystem );
+	static void Free( void* pMemory, const size_t bytes, const Subsystem subsystem );
+
+	static void GetCounters( const Subsystem subsystem, MemoryCounters& counters );
+	static long GetTotalBytes();
+	static void ResetPeaks();
+
+	//one line per subsystem and a total, for logs and benchmarks
+	static string GetReport();
+
+};
+
+//------------------------------------------------------------------------------
+// Name: class TrackedAllocator
+// Desc: Standard allocator that counts what it hands out against a subsystem
+//------------------------------------------------------------------------------
+template< class T, MemoryTracker::Subsystem SUBSYSTEM >
+class TrackedAllocator
+{
+
+public:
+	typedef T value_type;
+	typedef T* pointer;
+	typedef const T* const_pointer;
+	typedef T& reference;
+	typedef const T& const_reference;
+	typedef size_t size_type;
+	typedef ptrdiff_t difference_type;
+
+	template< class U > struct rebind { typedef TrackedAllocator< U, SUBSYSTEM > other; };
+
+	TrackedAllocator() {}
+	template< class U > TrackedAllocator( const TrackedAllocator< U, SUBSYSTEM >& ) {}
+
+	pointer address( reference value ) const { return &value; }
+	const_pointer address( const_reference value ) const { return &value; }
+	size_type max_size() const { return size_t( -1 ) / sizeof( T ); }
+
+	pointer allocate( const size_type count, const void* = NULL )
+	{
+		if( count > max_size() )
+			throw bad_alloc();
+
+		void* pMemory = MemoryTracker::Allocate( count * sizeof( T ), SUBSYSTEM );
+		if( NULL == pMemory )
+			throw bad_alloc();
+
+		return (pointer)( pMemory );
+	}
+
+	void deallocate( pointer pMemory, const size_type count )
+	{
+		MemoryTracker::Free( pMemory, count * sizeof( T ), SUBSYSTEM );
+	}
+
+	void construct( pointer pMemory, const T& value ) { new( (void*)( pMemory ) ) T( value ); }
+	void destroy( pointer pMemory ) { pMemory->~T(); }
+
+};
+
+//any two allocators for a subsystem can free each other's memory
+template< class T, class U, MemoryTracker::Subsystem SUBSYSTEM >
+inline bool operator==( const TrackedAllocator< T, SUBSYSTEM >&, const TrackedAllocator< U, SUBSYSTEM >& )
+{
+	return true;
+}
+
+template< class T, class U, MemoryTracker::Subsystem SUBSYSTEM >
+inline bool operator!=( const TrackedAllocator< T, SUBSYSTEM >&, const TrackedAllocator< U, SUBSYSTEM >& )
+{
+	return false;
+}
+
+//------------------------------------------------------------------------------
+// Name: struct TrackedVector
+// Desc: Names the vector type for a subsystem, as TrackedVector< T, S >::Type
+//------------------------------------------------------------------------------
+template< class T, MemoryTracker::Subsystem SUBSYSTEM >
+struct TrackedVector
+{
+	typedef vector< T, TrackedAllocator< T, SUBSYSTEM > > Type;
+};
+
+
+#endif //INCLUSIONGUARD_MEMORYTRACKER_H
@@ -0,0 +1,451 @@
+//------------------------------------------------------------------------------
+// File: ParallelSearch.cpp
+// Desc: Hash-distributed parallel A* (HDA*) for single large queries
+//
+// Created: 19 October 2026 20:58:44
+//
+// (c)2002 Neil Wakefield
+//------------------------------------------------------------------------------
+
+
+//------------------------------------------------------------------------------
+// Included files:
+//------------------------------------------------------------------------------
+#include "ParallelSearch.h"
+#include "Grid.h"
+#include "Landmarks.h"
+
+#include <stdlib.h>
+#include <algorithm>
+#include <queue>
+
+
+//------------------------------------------------------------------------------
+// Globals:
+//------------------------------------------------------------------------------
+namespace
+{
+	//entry in a worker's open list
+	struct OpenEntry
+	{
+		OpenEntry( const int newEstimate, const int newCost, const int newCell )
+			: estimate( newEstimate ), cost( newCost ), cell( newCell ) {}
+
+		int estimate;	//cost plus heuristic
+		int cost;
+		int cell;
+	};
+
+	//orders the open list cheapest estimate first, deepest first on ties
+	struct OpenEntryOrder
+	{
+		bool operator()( const OpenEntry& a, const OpenEntry& b ) const
+		{
+			if( a.estimate != b.estimate )
+				return a.estimate > b.estimate;
+			return a.cost < b.cost;
+		}
+	};
+
+	typedef priority_queue< OpenEntry, TrackedVector< OpenEntry, MemoryTracker::SUBSYSTEM_SOLVER >::Type,
+							OpenEntryOrder > OpenHeap;
+
+	//a successor posted to the worker that owns it
+	struct SearchMessage : public MpscNode
+	{
+		int cell;
+		int cost;
+		int estimate;
+		int parent;
+	};
+
+	//--------------------------------------------------------------------------
+	// Name: AllocateMessage()
+	// Desc: Takes a message from a worker's pool, or makes a new one if the
+	//		 pool is empty
+	//--------------------------------------------------------------------------
+	SearchMessage* AllocateMessage( MpscNode*& pPool )
+	{
+		if( pPool != NULL )
+		{
+			SearchMessage* pMessage = (SearchMessage*)( pPool );
+			pPool = pPool->next;
+			return pMessage;
+		}
+
+		void* pMemory = MemoryTracker::Allocate( sizeof( SearchMessage ), MemoryTracker::SUBSYSTEM_SOLVER );
+		if( NULL == pMemory )
+			throw bad_alloc();
+
+		return new( pMemory ) SearchMessage;
+	}
+
+	//--------------------------------------------------------------------------
+	// Name: ReleaseMessage()
+	// Desc: Puts a handled message in a worker's pool, for it to send on
+	//--------------------------------------------------------------------------
+	void ReleaseMessage( MpscNode*& pPool, MpscNode* pMessage )
+	{
+		pMessage->next = pPool;
+		pPool = pMessage;
+	}
+}
+
+//------------------------------------------------------------------------------
+// Name: struct ParallelSearch::Worker
+// Desc: State belonging to a single worker thread
+//------------------------------------------------------------------------------
+struct ParallelSearch::Worker
+{
+	ParallelSearch* pSearch;
+	int index;
+
+	MpscQueue inbox;
+	MpscNode* pPool;	//messages this worker has handled, only it may touch
+	OpenHeap open;
+	Thread thread;
+
+	unsigned int nodesExpanded;
+	unsigned int heuristicCalls;
+	unsigned int peakOpenList;
+	unsigned int messagesSent;
+};
+
+
+//------------------------------------------------------------------------------
+// Definitions:
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Name: ParallelSearch()
+// Desc: Constructor for the parallel search
+//------------------------------------------------------------------------------
+ParallelSearch::ParallelSearch()
+{
+	m_pGrid = NULL;
+	m_pLandmarks = NULL;
+	m_work = 0;
+	m_bestCost = -1;
+	m_abort = 0;
+}
+
+//------------------------------------------------------------------------------
+// Name: FindPath()
+// Desc: Finds the cheapest route from an open cell to the nearest of several
+//		 goals using up to numThreads threads, the calling thread included.
+//		 Fills in every cell from start to goal inclusive and the index of the
+//		 goal reached, or returns FALSE if there is no route. pLandmarks may be
+//		 NULL, in which case only the Manhattan bound is used
+//------------------------------------------------------------------------------
+bool ParallelSearch::FindPath( const Grid& grid, const int startCell, const int* pGoalCells,
+							   const int numGoals, const int numThreads, const Landmarks* pLandmarks,
+							   SolverInts& path, int& goalIndex, GridStats& stats )
+{
+	path.clear();
+	goalIndex = -1;
+	if( numGoals <= 0 )
+		return false;
+
+	m_pGrid = &grid;
+	m_pLandmarks = pLandmarks;
+	m_goalCells.assign( pGoalCells, pGoalCells + numGoals );
+	m_goalX.resize( numGoals );
+	m_goalY.resize( numGoals );
+	for( int i = 0; i < numGoals; ++i )
+	{
+		m_goalX[ i ] = grid.GetCellX( pGoalCells[ i ] );
+		m_goalY[ i ] = grid.GetCellY( pGoalCells[ i ] );
+	}
+
+	int threadCount = ( numThreads > 1 ) ? numThreads : 1;
+	for( ;; )
+	{
+		m_cost.assign( grid.GetNumCells(), -1 );
+		m_parent.assign( grid.GetNumCells(), -1 );
+		m_work = 1;
+		m_bestCost = -1;
+		m_abort = 0;
+
+		for( int i = 0; i < threadCount; ++i )
+		{
+			Worker* pWorker = new Worker;
+			pWorker->pSearch = this;
+			pWorker->index = i;
+			pWorker->pPool = NULL;
+			pWorker->nodesExpanded = 0;
+			pWorker->heuristicCalls = 0;
+			pWorker->peakOpenList = 0;
+			pWorker->messagesSent = 0;
+			m_workers.push_back( pWorker );
+		}
+
+		//seed the start's owner, then set everyone going
+		Worker& owner = *m_workers[ GetOwner( startCell ) ];
+		m_cost[ startCell ] = 0;
+		owner.open.push( OpenEntry( Estimate( startCell ), 0, startCell ) );
+		++owner.heuristicCalls;
+
+		bool started = true;
+		for( int i = 1; i < threadCount && started; ++i )
+			started = m_workers[ i ]->thread.Start( WorkerThread, m_workers[ i ] );
+
+		//without every worker some cells would never be searched, so stop the
+		// ones that did start and go round again on this thread alone
+		if( ! started )
+			AtomicIncrement( &m_abort );
+		else
+			RunWorker( *m_workers[ 0 ] );
+
+		for( int i = 1; i < threadCount; ++i )
+			m_workers[ i ]->thread.Join();
+
+		if( started )
+			break;
+
+		DeleteWorkers();
+		threadCount = 1;
+	}
+
+	//gather up the statistics
+	for( size_t i = 0; i < m_workers.size(); ++i )
+	{
+		const Worker& worker = *m_workers[ i ];
+		GRID_STAT_ADD( stats, nodesExpanded, worker.nodesExpanded );
+		GRID_STAT_ADD( stats, heuristicCalls, worker.heuristicCalls );
+		GRID_STAT_MAX( stats, peakOpenList, worker.peakOpenList );
+		GRID_STAT_ADD( stats, messagesSent, worker.messagesSent );
+	}
+	DeleteWorkers();
+	GRID_STAT_SET( stats, threadsUsed, (unsigned int)( threadCount ) );
+
+	if( m_bestCost < 0 )
+		return false;
+
+	//any goal left holding the best cost will do
+	for( size_t i = 0; i < m_goalCells.size() && goalIndex < 0; ++i )
+		if( m_cost[ m_goalCells[ i ] ] == m_bestCost )
+			goalIndex = int( i );
+
+	//costs fall strictly along the parent links, so this always ends at the start
+	for( int cell = m_goalCells[ goalIndex ]; cell >= 0; cell = m_parent[ cell ] )
+		path.push_back( cell );
+	reverse( path.begin(), path.end() );
+
+	return true;
+}
+
+//------------------------------------------------------------------------------
+// Name: Estimate()
+// Desc: Returns a lower bound on the cost from a cell to the nearest goal
+//------------------------------------------------------------------------------
+int ParallelSearch::Estimate( const int cell ) const
+{
+	const int x = m_pGrid->GetCellX( cell );
+	const int y = m_pGrid->GetCellY( cell );
+
+	int nearest = abs( x - m_goalX[ 0 ] ) + abs( y - m_goalY[ 0 ] );
+	for( size_t i = 1; i < m_goalCells.size(); ++i )
+	{
+		const int distance = abs( x - m_goalX[ i ] ) + abs( y - m_goalY[ i ] );
+		if( distance < nearest )
+			nearest = distance;
+	}
+
+	const int manhattan = Grid::MIN_WEIGHT * nearest;
+	if( NULL == m_pLandmarks )
+		return manhattan;
+
+	const int landmark = m_pLandmarks->Estimate( *m_pGrid, cell );
+	return ( landmark > manhattan ) ? landmark : manhattan;
+}
+
+//------------------------------------------------------------------------------
+// Name: IsGoal()
+// Desc: Checks to see if a cell is one of the goals
+//------------------------------------------------------------------------------
+bool ParallelSearch::IsGoal( const int cell ) const
+{
+	for( size_t i = 0; i < m_goalCells.size(); ++i )
+		if( m_goalCells[ i ] == cell )
+			return true;
+
+	return false;
+}
+
+//------------------------------------------------------------------------------
+// Name: CanImprove()
+// Desc: Checks to see if a route with this estimated total could still beat
+//		 the best goal cost found so far
+//------------------------------------------------------------------------------
+bool ParallelSearch::CanImprove( const int estimate ) const
+{
+	const long best = AtomicLoad( &m_bestCost );
+	return best < 0 || estimate < best;
+}
+
+//------------------------------------------------------------------------------
+// Name: OfferGoal()
+// Desc: Records a cost at which the goal was reached, if it is the cheapest
+//------------------------------------------------------------------------------
+void ParallelSearch::OfferGoal( const int cost )
+{
+	for( ;; )
+	{
+		const long best = AtomicLoad( &m_bestCost );
+		if( best >= 0 && best <= cost )
+			return;
+
+		if( AtomicCompareExchange( &m_bestCost, cost, best ) == best )
+			return;
+	}
+}
+
+//------------------------------------------------------------------------------
+// Name: Relax()
+// Desc: Offers a worker a route to one of its cells. Each offer uses up one
+//		 unit of work, which carries over to the open entry if it is kept
+//------------------------------------------------------------------------------
+void ParallelSearch::Relax( Worker& worker, const int cell, const int cost, const int estimate,
+							const int parent )
+{
+	if( ( m_cost[ cell ] >= 0 && m_cost[ cell ] <= cost ) || ! CanImprove( estimate ) )
+	{
+		AtomicDecrement( &m_work );
+		return;
+	}
+
+	m_cost[ cell ] = cost;
+	m_parent[ cell ] = parent;
+	worker.open.push( OpenEntry( estimate, cost, cell ) );
+
+	if( worker.open.size() > worker.peakOpenList )
+		worker.peakOpenList = (unsigned int)( worker.open.size() );
+}
+
+//------------------------------------------------------------------------------
+// Name: RunWorker()
+// Desc: Main loop of a worker - handle posted routes, then expand the best
+//		 open cell, until there is no work left anywhere
+//------------------------------------------------------------------------------
+void ParallelSearch::RunWorker( Worker& worker )
+{
+	const int offsetX[ 4 ] = { 0, 1, 0, -1 };
+	const int offsetY[ 4 ] = { -1, 0, 1, 0 };
+
+	while( 0 == AtomicLoad( &m_abort ) )
+	{
+		MpscNode* pNode;
+		while( ( pNode = worker.inbox.Pop() ) != NULL )
+		{
+			SearchMessage* pMessage = (SearchMessage*)( pNode );
+			Relax( worker, pMessage->cell, pMessage->cost, pMessage->estimate, pMessage->parent );
+			ReleaseMessage( worker.pPool, pNode );
+		}
+
+		if( worker.open.empty() )
+		{
+			if( 0 == AtomicLoad( &m_work ) )
+				break;
+
+			YieldThread();
+			continue;
+		}
+
+		const OpenEntry entry = worker.open.top();
+		worker.open.pop();
+
+		//skip entries superseded by a cheaper route, or beaten by the goal
+		const int cell = entry.cell;
+		if( entry.cost != m_cost[ cell ] || ! CanImprove( entry.estimate ) )
+		{
+			AtomicDecrement( &m_work );
+			continue;
+		}
+
+		if( IsGoal( cell ) )
+		{
+			OfferGoal( entry.cost );
+			AtomicDecrement( &m_work );
+			continue;
+		}
+
+		++worker.nodesExpanded;
+
+		const int cellX = m_pGrid->GetCellX( cell );
+		const int cellY = m_pGrid->GetCellY( cell );
+		for( int i = 0; i < 4; ++i )
+		{
+			const int x = cellX + offsetX[ i ];
+			const int y = cellY + offsetY[ i ];
+			if( ! m_pGrid->IsPath( x, y ) )
+				continue;
+
+			const int next = m_pGrid->GetCellIndex( x, y );
+			if( next == m_parent[ cell ] )
+				continue;
+
+			const int cost = entry.cost + m_pGrid->GetWeight( x, y );
+			const int estimate = cost + Estimate( next );
+			++worker.heuristicCalls;
+			if( ! CanImprove( estimate ) )
+				continue;
+
+			AtomicIncrement( &m_work );
+
+			const int owner = GetOwner( next );
+			if( owner == worker.index )
+			{
+				Relax( worker, next, cost, estimate, cell );
+				continue;
+			}
+
+			SearchMessage* pMessage = AllocateMessage( worker.pPool );
+			pMessage->cell = next;
+			pMessage->cost = cost;
+			pMessage->estimate = estimate;
+			pMessage->parent = cell;
+			m_workers[ owner ]->inbox.Push( pMessage );
+			++worker.messagesSent;
+		}
+
+		AtomicDecrement( &m_work );
+	}
+}
+
+//------------------------------------------------------------------------------
+// Name: DeleteWorkers()
+// Desc: Frees the workers along with any messages still in their inboxes and
+//		 pools. Messages move between pools as they are sent, so they are only
+//		 freed once the search is over
+//------------------------------------------------------------------------------
+void ParallelSearch::DeleteWorkers()
+{
+	for( size_t i = 0; i < m_workers.size(); ++i )
+	{
+		Worker* pWorker = m_workers[ i ];
+
+		MpscNode* pNode;
+		while( ( pNode = pWorker->inbox.Pop() ) != NULL )
+			ReleaseMessage( pWorker->pPool, pNode );
+
+		while( pWorker->pPool != NULL )
+		{
+			pNode = pWorker->pPool;
+			pWorker->pPool = pNode->next;
+			MemoryTracker::Free( pNode, sizeof( SearchMessage ), MemoryTracker::SUBSYSTEM_SOLVER );
+		}
+
+		delete pWorker;
+	}
+	m_workers.clear();
+}
+
+//------------------------------------------------------------------------------
+// Name: WorkerThread()
+// Desc: Thread entry point for the workers other than the caller's
+//------------------------------------------------------------------------------
+void ParallelSearch::WorkerThread( void* pWorker )
+{
+	Worker* pSelf = (Worker*)( pWorker );
+	pSelf->pSearch->RunWorker( *pSelf );
+}
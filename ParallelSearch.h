@@ -0,0 +1,93 @@
+//------------------------------------------------------------------------------
+// File: ParallelSearch.h
+// Desc: Hash-distributed parallel A* (HDA*) for single large queries
+//
+// Created: 19 October 2026 20:58:44
+//
+// (c)2002 Neil Wakefield
+//------------------------------------------------------------------------------
+
+
+#ifndef INCLUSIONGUARD_PARALLELSEARCH_H
+#define INCLUSIONGUARD_PARALLELSEARCH_H
+
+
+//------------------------------------------------------------------------------
+// Included files:
+//------------------------------------------------------------------------------
+#include "GridStats.h"
+#include "MemoryTracker.h"
+#include "Threading.h"
+
+#include <vector>
+using namespace std;
+
+
+//------------------------------------------------------------------------------
+// Prototypes and declarations:
+//------------------------------------------------------------------------------
+class Grid;
+class Landmarks;
+
+//------------------------------------------------------------------------------
+// Name: class ParallelSearch
+// Desc: A* split across worker threads. Each cell is owned by the worker its
+//		 index hashes to, and only that worker keeps its cost and open list
+//		 entry. Successors owned by other workers are posted to them through
+//		 lock-free queues. A shared count of open entries plus messages in
+//		 flight reaches zero only once every worker is out of work, which is
+//		 when the search ends. Workers drop anything that can't beat the best
+//		 cost found so far to any of the goals, so the result is as cheap as
+//		 the serial solver's, though ties may be broken differently
+//------------------------------------------------------------------------------
+class ParallelSearch
+{
+
+public:
+	typedef TrackedVector< int, MemoryTracker::SUBSYSTEM_SOLVER >::Type SolverInts;
+
+	ParallelSearch();
+
+	bool FindPath( const Grid& grid, const int startCell, const int* pGoalCells, const int numGoals,
+				   const int numThreads, const Landmarks* pLandmarks,
+				   SolverInts& path, int& goalIndex, GridStats& stats );
+
+private:
+	struct Worker;
+
+	const Grid* m_pGrid;
+	const Landmarks* m_pLandmarks;
+	SolverInts m_goalCells;
+	SolverInts m_goalX;
+	SolverInts m_goalY;
+
+	vector< Worker* > m_workers;
+
+	//per-cell state, each entry written only by the cell's owner
+	SolverInts m_cost;
+	SolverInts m_parent;
+
+	volatile long m_work;		//open entries plus messages not yet handled
+	volatile long m_bestCost;	//cheapest goal cost so far, -1 for none
+	volatile long m_abort;		//set to stop every worker early
+
+	int GetOwner( const int cell ) const
+	{
+		return int( ( (unsigned int)( cell ) * 2654435761u ) % (unsigned int)( m_workers.size() ) );
+	}
+
+	int Estimate( const int cell ) const;
+	bool IsGoal( const int cell ) const;
+	bool CanImprove( const int estimate ) const;
+	void OfferGoal( const int cost );
+
+	void RunWorker( Worker& worker );
+	void Relax( Worker& worker, const int cell, const int cost, const int estimate,
+				const int parent );
+	void DeleteWorkers();
+	static void WorkerThread( void* pWorker );
+
+};
+
+
+#endif //INCLUSIONGUARD_PARALLELSEARCH_H
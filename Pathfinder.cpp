@@ -38,36 +38,28 @@ App::App()
 
 	//start with chasecam disabled
 	m_chaseCam = FALSE;
+	m_fAspect = 1.0f;
+
+	//frame timing is recorded all the time, but only shown on request
+	m_timingStarted = false;
+	m_showTimings = false;
+	m_timingKeyDown = false;
+	m_pFont = new CD3DFont( _T( "Arial" ), 10, D3DFONT_BOLD );
 
 	//initialise buffer pointers
 	m_pPlayerMesh	= NULL;
 	m_pPlayerVB		= NULL;
 	m_pPlayerIB		= NULL;
-	m_pCubeMesh		= NULL;
-	m_pCubeVB		= NULL;
-	m_pCubeIB		= NULL;
 
 	m_dwMeshFVF				= 0;
 	m_dwNumPlayerVertices	= 0;
 	m_dwNumPlayerPrims		= 0;
-	m_dwNumCubeVertices		= 0;
-	m_dwNumCubePrims		= 0;
+	m_agentBatch			= 0;
 
-	//create the game grid
-	m_pGrid = new Grid();
-	m_pGrid->GenerateMaze();
-	m_pGrid->GenerateSolution();
+	//create the game grid and the player walking it
+	m_pSimulation = new Simulation( (unsigned int)( time( NULL ) ) );
+	m_mazeCount = m_pSimulation->GetMazeCount();
 	m_newMaze = true;
-
-	//create the player
-	m_pPlayer = new Player();
-    MazeSquare square;
-	float halfSize = Grid::GRID_SIZE / 2.0f;
-    
-	m_pGrid->PopNextSolution( square );
-	m_pPlayer->SetPosition( square.x - halfSize, square.y - halfSize );
-	m_pGrid->PopNextSolution( square );
-	m_pPlayer->SetGoal( square.x - halfSize, square.y - halfSize );
 }
 
 //------------------------------------------------------------------------------
@@ -76,9 +68,13 @@ App::App()
 //------------------------------------------------------------------------------
 App::~App()
 {
+	//remove the overlay font
+	delete m_pFont;
+	m_pFont = NULL;
+
 	//remove the game grid
-	delete m_pGrid;
-	m_pGrid = NULL;
+	delete m_pSimulation;
+	m_pSimulation = NULL;
 	
 	//update the global pointer
 	g_pApp = NULL;
@@ -108,23 +104,50 @@ HRESULT App::OneTimeSceneInit()
 //------------------------------------------------------------------------------
 HRESULT App::InitDeviceObjects()
 {
-	//create the grid cube mesh...
-	D3DXCreateBox( m_pd3dDevice, 1.0f, 1.0f, 1.0f, &m_pCubeMesh, NULL );
-	m_pCubeMesh->GetVertexBuffer( &m_pCubeVB );
-	m_dwNumCubeVertices = m_pCubeMesh->GetNumVertices();
-	m_pCubeMesh->GetIndexBuffer( &m_pCubeIB );
-	m_dwNumCubePrims = m_pCubeMesh->GetNumFaces();
-
-	//create the player model
-	D3DXCreateSphere( m_pd3dDevice, CONST_PLAYER_SIZE, 20, 20, &m_pPlayerMesh, NULL );
-	m_pPlayerMesh->GetVertexBuffer( &m_pPlayerVB );
+	//create the player model - a unit sphere, which each instance scales
+	D3DXCreateSphere( m_pd3dDevice, 1.0f, 20, 20, &m_pPlayerMesh, NULL );
 	m_dwNumPlayerVertices = m_pPlayerMesh->GetNumVertices();
-	m_pPlayerMesh->GetIndexBuffer( &m_pPlayerIB );
 	m_dwNumPlayerPrims = m_pPlayerMesh->GetNumFaces();
 	
 	//get the FVF flags for the meshes
 	m_dwMeshFVF = m_pPlayerMesh->GetFVF();
 
+	//keep a copy of the sphere's vertices to expand batches from...
+	LPDIRECT3DVERTEXBUFFER8 pMeshVB = NULL;
+	BYTE* pData = NULL;
+	m_pPlayerMesh->GetVertexBuffer( &pMeshVB );
+	m_playerVertices.resize( m_dwNumPlayerVertices );
+	pMeshVB->Lock( 0, 0, &pData, D3DLOCK_READONLY );
+	memcpy( &m_playerVertices[ 0 ], pData, m_dwNumPlayerVertices * sizeof( MESH_VERTEX ) );
+	pMeshVB->Unlock();
+	SAFE_RELEASE( pMeshVB );
+
+	//...and repeat its indices for every sphere in a batch
+	const DWORD numIndices = m_dwNumPlayerPrims * 3;
+	m_agentBatch = InstanceBuffer::GetMaxBatch( m_dwNumPlayerVertices );
+	if( FAILED( m_pd3dDevice->CreateIndexBuffer( m_agentBatch * numIndices * sizeof( WORD ),
+												 D3DUSAGE_WRITEONLY, D3DFMT_INDEX16,
+												 D3DPOOL_MANAGED, &m_pPlayerIB ) ) )
+		return E_FAIL;
+
+	LPDIRECT3DINDEXBUFFER8 pMeshIB = NULL;
+	BYTE* pIndices = NULL;
+	m_pPlayerMesh->GetIndexBuffer( &pMeshIB );
+	pMeshIB->Lock( 0, 0, &pIndices, D3DLOCK_READONLY );
+	m_pPlayerIB->Lock( 0, 0, &pData, 0 );
+	InstanceBuffer::ExpandIndices( (const unsigned short*)( pIndices ), numIndices,
+								   m_dwNumPlayerVertices, m_agentBatch,
+								   (unsigned short*)( pData ) );
+	m_pPlayerIB->Unlock();
+	pMeshIB->Unlock();
+	SAFE_RELEASE( pMeshIB );
+
+	m_pFont->InitDeviceObjects( m_pd3dDevice );
+
+	//the device buffers are empty, so every chunk of wall must be uploaded
+	m_pSimulation->GetGrid().GetDirtyChunks().MarkAll();
+	UpdateWallGeometry();
+
 	//create the materials
 	memset( &m_wallMaterial, 0, sizeof( D3DMATERIAL8 ) );
 	m_wallMaterial.Diffuse.r = 1.0f;
@@ -147,6 +170,101 @@ HRESULT App::InitDeviceObjects()
 	return S_OK;
 }
 
+//------------------------------------------------------------------------------
+// Name: UpdateWallGeometry()
+// Desc: Rebuilds the chunks of wall the grid has marked dirty and re-uploads them
+//------------------------------------------------------------------------------
+HRESULT App::UpdateWallGeometry()
+{
+	m_wallChunks.Update( m_pSimulation->GetGrid() );
+
+	if( int( m_wallBuffers.size() ) != m_wallChunks.GetNumChunks() )
+	{
+		ReleaseWallGeometry();
+
+		WALL_CHUNK_BUFFERS empty;
+		memset( &empty, 0, sizeof( WALL_CHUNK_BUFFERS ) );
+		m_wallBuffers.assign( m_wallChunks.GetNumChunks(), empty );
+	}
+
+	const vector< int >& rebuilt = m_wallChunks.GetRebuiltChunks();
+	for( size_t i = 0; i < rebuilt.size(); ++i )
+	{
+		if( FAILED( UploadWallChunk( rebuilt[ i ] ) ) )
+			return E_FAIL;
+	}
+
+	return S_OK;
+}
+
+//------------------------------------------------------------------------------
+// Name: UploadWallChunk()
+// Desc: Copies the mesh for one chunk of wall into device buffers
+//------------------------------------------------------------------------------
+HRESULT App::UploadWallChunk( const int index )
+{
+	const WallMesh& mesh = m_wallChunks.GetMesh( index );
+	WALL_CHUNK_BUFFERS& buffers = m_wallBuffers[ index ];
+
+	for( int i = 0; i < WallMesh::NUM_LAYERS; ++i )
+	{
+		const WallMesh::Layer layer = WallMesh::Layer( i );
+		const DWORD numVertices = mesh.GetNumVertices( layer );
+		const DWORD numIndices = mesh.GetNumIndices( layer );
+
+		SAFE_RELEASE( buffers.pIB[ i ] );
+		SAFE_RELEASE( buffers.pVB[ i ] );
+		buffers.dwNumVertices[ i ] = 0;
+		buffers.dwNumPrims[ i ] = 0;
+
+		if( 0 == numIndices )
+			continue;
+
+		//vertices...
+		if( FAILED( m_pd3dDevice->CreateVertexBuffer( numVertices * sizeof( MESH_VERTEX ),
+													  D3DUSAGE_WRITEONLY, m_dwMeshFVF,
+													  D3DPOOL_MANAGED, &buffers.pVB[ i ] ) ) )
+			return E_FAIL;
+
+		BYTE* pData = NULL;
+		buffers.pVB[ i ]->Lock( 0, 0, &pData, 0 );
+		memcpy( pData, mesh.GetVertices( layer ), numVertices * sizeof( WallVertex ) );
+		buffers.pVB[ i ]->Unlock();
+
+		//...and indices
+		if( FAILED( m_pd3dDevice->CreateIndexBuffer( numIndices * sizeof( WORD ),
+													 D3DUSAGE_WRITEONLY, D3DFMT_INDEX16,
+													 D3DPOOL_MANAGED, &buffers.pIB[ i ] ) ) )
+			return E_FAIL;
+
+		buffers.pIB[ i ]->Lock( 0, 0, &pData, 0 );
+		memcpy( pData, mesh.GetIndices( layer ), numIndices * sizeof( WORD ) );
+		buffers.pIB[ i ]->Unlock();
+
+		buffers.dwNumVertices[ i ] = numVertices;
+		buffers.dwNumPrims[ i ] = numIndices / 3;
+	}
+
+	return S_OK;
+}
+
+//------------------------------------------------------------------------------
+// Name: ReleaseWallGeometry()
+// Desc: Frees the device buffers holding the wall chunks
+//------------------------------------------------------------------------------
+void App::ReleaseWallGeometry()
+{
+	for( size_t c = 0; c < m_wallBuffers.size(); ++c )
+	{
+		for( int i = 0; i < WallMesh::NUM_LAYERS; ++i )
+		{
+			SAFE_RELEASE( m_wallBuffers[ c ].pIB[ i ] );
+			SAFE_RELEASE( m_wallBuffers[ c ].pVB[ i ] );
+		}
+	}
+	m_wallBuffers.clear();
+}
+
 //------------------------------------------------------------------------------
 // Name: RestoreDeviceObjects
 // Desc: Sets up device-specific data on res change
@@ -154,16 +272,16 @@ HRESULT App::InitDeviceObjects()
 HRESULT App::RestoreDeviceObjects()
 {
 	//set up the camera
-	D3DXMATRIX matView;
-	D3DXVECTOR3 vEyePt		= D3DXVECTOR3( -0.5f, -0.5f, ( Grid::GRID_SIZE + 2 ) * -1.4f );
+	const int gridSize = max( m_pSimulation->GetGrid().GetWidth(), m_pSimulation->GetGrid().GetHeight() );
+	D3DXVECTOR3 vEyePt		= D3DXVECTOR3( -0.5f, -0.5f, ( gridSize + 2 ) * -1.4f );
 	D3DXVECTOR3 vLookAtPt	= D3DXVECTOR3( -0.5f, -0.5f, 0.0f );
 	D3DXVECTOR3 vUp			= D3DXVECTOR3( 0.0f, 1.0f, 0.0f );
-	D3DXMatrixLookAtLH( &matView, &vEyePt, &vLookAtPt, &vUp );
-	m_pd3dDevice->SetTransform( D3DTS_VIEW, &matView );
+	SetViewMatrix( vEyePt, vLookAtPt, vUp );
 
 	D3DXMATRIX matProj;
-	float fAspect = m_d3dsdBackBuffer.Width / float(m_d3dsdBackBuffer.Height);
-	D3DXMatrixPerspectiveFovLH( &matProj, D3DX_PI/4, fAspect, 1.0f, 500.0f );
+	m_fAspect = m_d3dsdBackBuffer.Width / float(m_d3dsdBackBuffer.Height);
+	D3DXMatrixPerspectiveFovLH( &matProj, CONST_CAMERA_FOV, m_fAspect,
+								CONST_CAMERA_NEAR, CONST_CAMERA_FAR );
 	m_pd3dDevice->SetTransform( D3DTS_PROJECTION, &matProj );	
 
 	//set render states
@@ -171,9 +289,35 @@ HRESULT App::RestoreDeviceObjects()
 
 	SetUpLights();
 
+	//the player spheres are rewritten every frame, so live in a dynamic buffer
+	if( FAILED( m_pd3dDevice->CreateVertexBuffer( m_agentBatch * m_dwNumPlayerVertices *
+												  sizeof( MESH_VERTEX ),
+												  D3DUSAGE_DYNAMIC | D3DUSAGE_WRITEONLY,
+												  m_dwMeshFVF, D3DPOOL_DEFAULT,
+												  &m_pPlayerVB ) ) )
+		return E_FAIL;
+
+	m_pFont->RestoreDeviceObjects();
+
 	return S_OK;
 }
 
+//------------------------------------------------------------------------------
+// Name: SetViewMatrix()
+// Desc: Points the camera, remembering where so the walls can be culled
+//------------------------------------------------------------------------------
+void App::SetViewMatrix( const D3DXVECTOR3& vEyePt, const D3DXVECTOR3& vLookAtPt,
+						 const D3DXVECTOR3& vUp )
+{
+	D3DXMATRIX matView;
+	D3DXMatrixLookAtLH( &matView, &vEyePt, &vLookAtPt, &vUp );
+	m_pd3dDevice->SetTransform( D3DTS_VIEW, &matView );
+
+	m_vEyePt = vEyePt;
+	m_vLookAtPt = vLookAtPt;
+	m_vUpVec = vUp;
+}
+
 //------------------------------------------------------------------------------
 // Name: SetUpLights()
 // Desc: Sets up lighting for the scene
@@ -189,7 +333,8 @@ void App::SetUpLights()
 	d3dLight.Diffuse.b  = 0.9f;
 	d3dLight.Position.x	= -0.5f;
 	d3dLight.Position.y	= -0.5f;
-	d3dLight.Position.z	= -1.0f * Grid::GRID_SIZE;
+	const Grid& grid = m_pSimulation->GetGrid();
+	d3dLight.Position.z	= -1.0f * max( grid.GetWidth(), grid.GetHeight() );
 	d3dLight.Range		= 1000.0f;
 	d3dLight.Attenuation0 = 1.0f;
 	m_pd3dDevice->SetLight( 0, &d3dLight );
@@ -206,93 +351,110 @@ void App::SetUpLights()
 //------------------------------------------------------------------------------
 HRESULT App::Render()
 {
+	Timer renderTimer;
+
+	//pick up any changes to the walls since the last frame
+	UpdateWallGeometry();
+
 	//blank the screen
 	m_pd3dDevice->Clear( 0, NULL, D3DCLEAR_TARGET | D3DCLEAR_ZBUFFER,
 						 D3DCOLOR_ARGB(0xff,0,0,0), 1.0f, 0 );
 
 	if( SUCCEEDED( m_pd3dDevice->BeginScene() ) )
 	{
-		//render the game grid
+		//render the game grid - the walls and border are baked in world space
 		m_pd3dDevice->SetVertexShader( m_dwMeshFVF );
-		m_pd3dDevice->SetStreamSource( 0, m_pCubeVB, sizeof( MESH_VERTEX ) );
-		m_pd3dDevice->SetIndices( m_pCubeIB, 0 );
-		m_pd3dDevice->SetMaterial( &m_wallMaterial );
 
-		//calculate half the grid size - this is needed for translating cubes
-		float halfSize = Grid::GRID_SIZE / 2.0f;
+		D3DXMATRIX matWorld;
+		D3DXMatrixIdentity( &matWorld );
+		m_pd3dDevice->SetTransform( D3DTS_WORLD, &matWorld );
 
-		for( int y = 0; y < Grid::GRID_SIZE; ++y )
+		//only draw the chunks the camera can see - the chase-cam also has a
+		// limited range, so distant parts of the maze are skipped
+		Frustum frustum;
+		frustum.Build( Vector3( m_vEyePt.x, m_vEyePt.y, m_vEyePt.z ),
+					   Vector3( m_vLookAtPt.x, m_vLookAtPt.y, m_vLookAtPt.z ),
+					   Vector3( m_vUpVec.x, m_vUpVec.y, m_vUpVec.z ),
+					   CONST_CAMERA_FOV, m_fAspect, CONST_CAMERA_NEAR, CONST_CAMERA_FAR,
+					   m_chaseCam ? CONST_CHASECAM_RANGE : CONST_CAMERA_FAR );
+		m_wallChunks.CollectVisible( frustum, m_visibleChunks );
+
+		for( int i = 0; i < WallMesh::NUM_LAYERS; ++i )
 		{
-			for( int x = 0; x < Grid::GRID_SIZE; ++x )
+			if( WallMesh::LAYER_BORDER == i )
+				m_pd3dDevice->SetMaterial( &m_borderMaterial );
+			else
+				m_pd3dDevice->SetMaterial( &m_wallMaterial );
+
+			for( size_t c = 0; c < m_visibleChunks.size(); ++c )
 			{
-				if( Grid::TILE_WALL == m_pGrid->GetTile( x, y ) )
+				const WALL_CHUNK_BUFFERS& buffers = m_wallBuffers[ m_visibleChunks[ c ] ];
+				if( 0 == buffers.dwNumPrims[ i ] )
+					continue;
+
+				//each part's indices start again from its own first vertex
+				const vector< WallMeshPart >& parts =
+					m_wallChunks.GetMesh( m_visibleChunks[ c ] ).GetParts( WallMesh::Layer( i ) );
+				m_pd3dDevice->SetStreamSource( 0, buffers.pVB[ i ], sizeof( MESH_VERTEX ) );
+				for( size_t p = 0; p < parts.size(); ++p )
 				{
-					//transform the cube to this point
-					D3DXMATRIX matWorld;
-					D3DXMatrixTranslation( &matWorld, x - halfSize, y - halfSize, 0.0f );
-					m_pd3dDevice->SetTransform( D3DTS_WORLD, &matWorld );
-
-					//now render it
+					m_pd3dDevice->SetIndices( buffers.pIB[ i ], parts[ p ].firstVertex );
 					m_pd3dDevice->DrawIndexedPrimitive( D3DPT_TRIANGLELIST, 0,
-														m_dwNumCubeVertices, 0, 
-														m_dwNumCubePrims );
+														parts[ p ].numVertices,
+														parts[ p ].firstIndex,
+														parts[ p ].numIndices / 3 );
 				}
 			}
 		}
 
-		//draw the grid border
-		m_pd3dDevice->SetMaterial( &m_borderMaterial );		
+		//draw the player, part way between the last two ticks and sitting on
+		// the floor of the maze
+		const Vector3 playerPos = m_pSimulation->GetPlayerPosition( m_pSimulation->GetAlpha() );
+		m_agentPositions.assign( 1, Vector3( playerPos.x, playerPos.y, 0.0f ) );
+		const int numAgents = m_agentInstances.Build( &m_agentPositions[ 0 ],
+													  int( m_agentPositions.size() ),
+													  CONST_PLAYER_SIZE, &frustum );
+
+		m_pd3dDevice->SetStreamSource( 0, m_pPlayerVB, sizeof( MESH_VERTEX ) );
+		m_pd3dDevice->SetIndices( m_pPlayerIB, 0 );
+		m_pd3dDevice->SetMaterial( &m_playerMaterial );
 
-		for( int x = -1; x <= Grid::GRID_SIZE; ++x )
+		//the spheres are already in world space, so a batch is one draw
+		for( int first = 0; first < numAgents; first += m_agentBatch )
 		{
-			//draw top and bottom borders
-			D3DXMATRIX matWorld;
-			D3DXMatrixTranslation( &matWorld, x - halfSize, -1 - halfSize, 0.0f );
-			m_pd3dDevice->SetTransform( D3DTS_WORLD, &matWorld );
-			m_pd3dDevice->DrawIndexedPrimitive( D3DPT_TRIANGLELIST, 0, m_dwNumCubeVertices, 0, 
-												m_dwNumCubePrims );
-
-			D3DXMatrixTranslation( &matWorld, x - halfSize, halfSize, 0.0f );
-			m_pd3dDevice->SetTransform( D3DTS_WORLD, &matWorld );
-			m_pd3dDevice->DrawIndexedPrimitive( D3DPT_TRIANGLELIST, 0, m_dwNumCubeVertices, 0, 
-												m_dwNumCubePrims );
+			const int count = min( numAgents - first, m_agentBatch );
+			BYTE* pData = NULL;
+			if( FAILED( m_pPlayerVB->Lock( 0, count * m_dwNumPlayerVertices * sizeof( MESH_VERTEX ),
+										   &pData, D3DLOCK_DISCARD ) ) )
+				break;
+			m_agentInstances.Expand( &m_playerVertices[ 0 ].p.x, m_dwNumPlayerVertices, first,
+									 count, (float*)( pData ) );
+			m_pPlayerVB->Unlock();
+
+			m_pd3dDevice->DrawIndexedPrimitive( D3DPT_TRIANGLELIST, 0,
+												count * m_dwNumPlayerVertices,
+												0, count * m_dwNumPlayerPrims );
 		}
-		for( int y = -1; y <= Grid::GRID_SIZE; ++y )
+
+		//draw the timing overlay
+		if( m_showTimings )
 		{
-			//draw left and right borders
-			D3DXMATRIX matWorld;
-			if( y != m_pGrid->GetStartY() )
+			for( int i = 0; i < FrameStats::NUM_STAGES; ++i )
 			{
-				D3DXMatrixTranslation( &matWorld, -1 - halfSize, y - halfSize, 0.0f );
-				m_pd3dDevice->SetTransform( D3DTS_WORLD, &matWorld );
-				m_pd3dDevice->DrawIndexedPrimitive( D3DPT_TRIANGLELIST, 0, m_dwNumCubeVertices, 0, 
-													m_dwNumCubePrims );
-			}
-			if( y != m_pGrid->GetGoalY() )
-			{
-				D3DXMatrixTranslation( &matWorld, halfSize, y - halfSize, 0.0f );
-				m_pd3dDevice->SetTransform( D3DTS_WORLD, &matWorld );
-				m_pd3dDevice->DrawIndexedPrimitive( D3DPT_TRIANGLELIST, 0, m_dwNumCubeVertices, 0, 
-													m_dwNumCubePrims );
+				string line = m_frameStats.GetSummary( FrameStats::Stage( i ) );
+				m_pFont->DrawText( 2.0f, 2.0f + i * 16.0f, D3DCOLOR_ARGB( 0xff, 0xff, 0xff, 0x00 ),
+								   line.c_str() );
 			}
 		}
 
-		//draw the player
-		m_pd3dDevice->SetStreamSource( 0, m_pPlayerVB, sizeof( MESH_VERTEX ) );
-		m_pd3dDevice->SetIndices( m_pPlayerIB, 0 );
-		m_pd3dDevice->SetMaterial( &m_playerMaterial );
-
-		D3DXVECTOR3 playerPos = m_pPlayer->GetPos();
-		D3DXMATRIX matWorld;
-		D3DXMatrixTranslation( &matWorld, playerPos[ 0 ], playerPos[ 1 ], 0.0f );
-		m_pd3dDevice->SetTransform( D3DTS_WORLD, &matWorld );
-		m_pd3dDevice->DrawIndexedPrimitive( D3DPT_TRIANGLELIST, 0, m_dwNumPlayerVertices,
-											0, m_dwNumPlayerPrims );
-
 		//finished
 		m_pd3dDevice->EndScene();
 	}
 
+	//the framework presents the scene once we return
+	m_frameStats.Record( FrameStats::STAGE_RENDER, renderTimer.GetSeconds() );
+	m_presentTimer.Start();
+
 	return S_OK;
 }
 
@@ -302,16 +464,51 @@ HRESULT App::Render()
 //------------------------------------------------------------------------------
 HRESULT App::FrameMove()
 {
+	//time the previous frame, and the present that finished it
+	if( m_timingStarted )
+	{
+		m_frameStats.Record( FrameStats::STAGE_PRESENT, m_presentTimer.GetSeconds() );
+		m_frameStats.Record( FrameStats::STAGE_FRAME, m_frameTimer.Lap() );
+	}
+	else
+	{
+		m_frameTimer.Start();
+		m_timingStarted = true;
+	}
+	Timer frameMoveTimer;
+
+	//3 key toggles the timing overlay
+	const bool timingKeyDown = ( GetKeyState( 51 ) & 0x8000 ) != 0;
+	if( timingKeyDown && ! m_timingKeyDown )
+		m_showTimings = ! m_showTimings;
+	m_timingKeyDown = timingKeyDown;
+
+	if( m_newMaze )
+	{
+		//prevent the large time interval after maze generation from affecting motion
+		m_fElapsedTime = 0.0f;
+		m_pSimulation->ResetClock();
+		m_newMaze = false;
+	}
+
+	//run the ticks this frame covers
+	m_pSimulation->Advance( m_fElapsedTime );
+	if( m_pSimulation->GetMazeCount() != m_mazeCount )
+	{
+		m_mazeCount = m_pSimulation->GetMazeCount();
+		m_newMaze = true;
+		m_frameStats.Record( FrameStats::STAGE_REGENERATE, m_pSimulation->GetRegenerateSeconds() );
+	}
+
 	if( GetKeyState( 49 ) & 0x8000 )	//1 key
 	{
 		//side-on view
 		m_chaseCam = false;
-		D3DXMATRIX matView;
-		D3DXVECTOR3 vEyePt		= D3DXVECTOR3( -0.5f, -0.5f, ( Grid::GRID_SIZE + 2 ) * -1.4f );
+		const int gridSize = max( m_pSimulation->GetGrid().GetWidth(), m_pSimulation->GetGrid().GetHeight() );
+		D3DXVECTOR3 vEyePt		= D3DXVECTOR3( -0.5f, -0.5f, ( gridSize + 2 ) * -1.4f );
 		D3DXVECTOR3 vLookAtPt	= D3DXVECTOR3( -0.5f, -0.5f, 0.0f );
 		D3DXVECTOR3 vUp			= D3DXVECTOR3( 0.0f, 1.0f, 0.0f );
-		D3DXMatrixLookAtLH( &matView, &vEyePt, &vLookAtPt, &vUp );
-		m_pd3dDevice->SetTransform( D3DTS_VIEW, &matView );
+		SetViewMatrix( vEyePt, vLookAtPt, vUp );
 	}
 	else if( GetKeyState( 50 ) & 0x8000 ) //2 key
 	{
@@ -322,50 +519,16 @@ HRESULT App::FrameMove()
 	//if we are using the chase-cam, position the camera accordingly
 	if( m_chaseCam )
 	{
-        D3DXVECTOR3 vec = m_pPlayer->GetPos();
-		D3DXMATRIX matView;
-		D3DXVECTOR3 vEyePt		= D3DXVECTOR3( vec[ 0 ] - 8.0f,
-											   vec[ 1 ] - 8.0f,
-											   vec[ 2 ] - 10.0f );
-		D3DXVECTOR3 vLookAtPt	= vec;
+        const Vector3 vec = m_pSimulation->GetPlayerPosition( m_pSimulation->GetAlpha() );
+		D3DXVECTOR3 vEyePt		= D3DXVECTOR3( vec.x - 8.0f,
+											   vec.y - 8.0f,
+											   vec.z - 10.0f );
+		D3DXVECTOR3 vLookAtPt	= D3DXVECTOR3( vec.x, vec.y, vec.z );
 		D3DXVECTOR3 vUp			= D3DXVECTOR3( 0.0f, 0.0f, -1.0f );
-		D3DXMatrixLookAtLH( &matView, &vEyePt, &vLookAtPt, &vUp );
-		m_pd3dDevice->SetTransform( D3DTS_VIEW, &matView );
+		SetViewMatrix( vEyePt, vLookAtPt, vUp );
 	}
 
-	if( m_newMaze )
-	{
-		//prevent the large time interval after maze generation from affecting motion
-		m_fElapsedTime = 0.0f;
-		m_newMaze = false;
-	}
-
-	//check to see if we need to get the next goal point for the player
-	if( m_pPlayer->HasReachedGoal() )
-	{
-		float halfSize = Grid::GRID_SIZE / 2.0f;
-		MazeSquare square;
-		if( ! m_pGrid->PopNextSolution( square ) )
-		{
-			//no more solutions left, it's time to generate a new maze
-			m_pGrid->GenerateMaze();
-			m_pGrid->GenerateSolution();
-			m_pGrid->PopNextSolution( square );
-			m_pPlayer->SetPosition( square.x - halfSize, square.y - halfSize );
-			m_pGrid->PopNextSolution( square );
-			m_pPlayer->SetGoal( square.x - halfSize, square.y - halfSize );
-
-			m_newMaze = true;
-
-			return S_OK;
-		}
-
-		m_pPlayer->SetGoal( square.x - halfSize, square.y - halfSize );
-	}
-
-	//update the player's position
-	m_pPlayer->MovePlayer( m_fElapsedTime );
-
+	m_frameStats.Record( FrameStats::STAGE_FRAMEMOVE, frameMoveTimer.GetSeconds() );
     return S_OK;
 }
 
@@ -375,6 +538,9 @@ HRESULT App::FrameMove()
 //------------------------------------------------------------------------------
 HRESULT App::InvalidateDeviceObjects()
 {
+	SAFE_RELEASE( m_pPlayerVB );
+	m_pFont->InvalidateDeviceObjects();
+
 	return S_OK;
 }
 
@@ -388,15 +554,13 @@ HRESULT App::DeleteDeviceObjects()
 	SAFE_RELEASE( m_pPlayerIB );
 	SAFE_RELEASE( m_pPlayerVB );
 	SAFE_RELEASE( m_pPlayerMesh );
-	SAFE_RELEASE( m_pCubeIB );
-	SAFE_RELEASE( m_pCubeVB );
-	SAFE_RELEASE( m_pCubeMesh );
+	ReleaseWallGeometry();
+
+	m_pFont->DeleteDeviceObjects();
 
 	m_dwMeshFVF				= 0;
 	m_dwNumPlayerVertices	= 0;
 	m_dwNumPlayerPrims		= 0;
-	m_dwNumCubeVertices		= 0;
-	m_dwNumCubePrims		= 0;
 
 	return S_OK;
 }
@@ -407,6 +571,17 @@ HRESULT App::DeleteDeviceObjects()
 //------------------------------------------------------------------------------
 HRESULT App::FinalCleanup()
 {
+	//log the frame timings so hitches can be compared between runs, and
+	// what the last maze and its solve are holding
+	FILE* pFile = fopen( "frametimes.log", "w" );
+	if( pFile )
+	{
+		fputs( m_frameStats.GetReport().c_str(), pFile );
+		fputs( "\n", pFile );
+		fputs( MemoryTracker::GetReport().c_str(), pFile );
+		fclose( pFile );
+	}
+
 	return S_OK;
 }
 
@@ -16,15 +16,22 @@
 // Included files:
 //------------------------------------------------------------------------------
 #define WIN32_LEAN_AND_MEAN
-#include "Grid.h"
-#include "Player.h"
+#include "Simulation.h"
+#include "WallChunks.h"
+#include "FrameStats.h"
+#include "InstanceBuffer.h"
+#include "MemoryTracker.h"
+#include "Timer.h"
 #include "Constants.h"
 #include "resource.h"
 
 #include <windows.h>
 #include <d3dx8.h>
 #include <tchar.h>
+#include <stdio.h>
+#include <time.h>
 #include "d3dapp.h"
+#include "d3dfont.h"
 
 
 //------------------------------------------------------------------------------
@@ -44,6 +51,18 @@ struct MESH_VERTEX
     D3DXVECTOR3 n; // Normal
 };
 
+//-----------------------------------------------------------------------------
+// Name: struct WALL_CHUNK_BUFFERS
+// Desc: Device copy of the geometry for one chunk of walls
+//-----------------------------------------------------------------------------
+struct WALL_CHUNK_BUFFERS
+{
+	LPDIRECT3DVERTEXBUFFER8 pVB[ WallMesh::NUM_LAYERS ];
+	LPDIRECT3DINDEXBUFFER8 pIB[ WallMesh::NUM_LAYERS ];
+	DWORD dwNumVertices[ WallMesh::NUM_LAYERS ];
+	DWORD dwNumPrims[ WallMesh::NUM_LAYERS ];
+};
+
 //------------------------------------------------------------------------------
 // Name: class App
 // Desc: The main application class
@@ -66,28 +85,49 @@ public:
 
 private:
 	void SetUpLights();
+	void SetViewMatrix( const D3DXVECTOR3& vEyePt, const D3DXVECTOR3& vLookAtPt,
+						const D3DXVECTOR3& vUp );
+	HRESULT UpdateWallGeometry();
+	HRESULT UploadWallChunk( const int index );
+	void ReleaseWallGeometry();
 
-	Grid* m_pGrid;
+	Simulation* m_pSimulation;
+	unsigned int m_mazeCount;	//the simulation's count at the last frame
 
 	bool m_newMaze;
 
 	bool m_chaseCam;
 
-	Player* m_pPlayer;
+	D3DXVECTOR3 m_vEyePt;
+	D3DXVECTOR3 m_vLookAtPt;
+	D3DXVECTOR3 m_vUpVec;
+	float m_fAspect;
 
 	DWORD m_dwMeshFVF;
 
 	LPD3DXMESH m_pPlayerMesh;
-	LPDIRECT3DVERTEXBUFFER8	m_pPlayerVB;
-	DWORD m_dwNumPlayerVertices;
-	LPDIRECT3DINDEXBUFFER8	m_pPlayerIB;
+	LPDIRECT3DVERTEXBUFFER8	m_pPlayerVB;	//refilled with each batch of spheres
+	DWORD m_dwNumPlayerVertices;			//in one sphere
+	LPDIRECT3DINDEXBUFFER8	m_pPlayerIB;	//a whole batch's worth of spheres
 	DWORD m_dwNumPlayerPrims;
 
-	LPD3DXMESH m_pCubeMesh;
-	LPDIRECT3DVERTEXBUFFER8	m_pCubeVB;
-	DWORD m_dwNumCubeVertices;
-	LPDIRECT3DINDEXBUFFER8	m_pCubeIB;
-	DWORD m_dwNumCubePrims;
+	//spheres are expanded on the CPU and drawn a batch at a time
+	vector< MESH_VERTEX > m_playerVertices;
+	vector< Vector3 > m_agentPositions;
+	InstanceBuffer m_agentInstances;
+	int m_agentBatch;
+
+	WallChunks m_wallChunks;
+	vector< WALL_CHUNK_BUFFERS > m_wallBuffers;
+	vector< int > m_visibleChunks;
+
+	FrameStats m_frameStats;
+	Timer m_frameTimer;
+	Timer m_presentTimer;
+	bool m_timingStarted;
+	bool m_showTimings;
+	bool m_timingKeyDown;
+	CD3DFont* m_pFont;
 
 	D3DMATERIAL8 m_wallMaterial;
 	D3DMATERIAL8 m_borderMaterial;
@@ -12,7 +12,6 @@
 // Included files:
 //------------------------------------------------------------------------------
 #include "Player.h"
-#include <d3dx8.h>
 
 
 //------------------------------------------------------------------------------
@@ -32,8 +31,8 @@ const float Player::PLAYER_SPEED = CONST_PLAYER_SPEED;
 Player::Player()
 {
 	m_hasReachedGoal = true;
-	m_vGoal = D3DXVECTOR3( 0.0, 0.0, 0.0 );
-	m_vPosition = D3DXVECTOR3( 0.0, 0.0, 0.0 );
+	m_vGoal = Vector3( 0.0f, 0.0f, 0.0f );
+	m_vPosition = Vector3( 0.0f, 0.0f, 0.0f );
 }
 
 //------------------------------------------------------------------------------
@@ -43,21 +42,19 @@ Player::Player()
 void Player::MovePlayer( const float timeInterval )
 {
 	//calculate the vector between the current point and the goal
-	D3DXVECTOR3 direction;
-	D3DXVec3Subtract( &direction, &m_vGoal, &m_vPosition );
-	D3DXVECTOR3 movement;
-	D3DXVec3Normalize( &movement, &direction );
+	const Vector3 direction = Vec3Subtract( m_vGoal, m_vPosition );
+	Vector3 movement = Vec3Normalize( direction );
 
     //scale it by the speed
-	D3DXVec3Scale( &movement, &movement, PLAYER_SPEED * timeInterval );
+	movement = Vec3Scale( movement, PLAYER_SPEED * timeInterval );
 
 	//if movement is greater than the distance to the point, we need the next goal
-	if( D3DXVec3Length( &movement ) >= D3DXVec3Length( &direction ) )
+	if( Vec3Length( movement ) >= Vec3Length( direction ) )
 	{
 		m_hasReachedGoal = true;
 		movement = direction;	//stop it overshooting the goal
 	}
 
 	//move the player along this vector
-	D3DXVec3Add( &m_vPosition, &m_vPosition, &movement );
+	m_vPosition = Vec3Add( m_vPosition, movement );
 }
\ No newline at end of file
@@ -16,8 +16,7 @@
 // Included files:
 //------------------------------------------------------------------------------
 #include "Constants.h"
-
-#include <d3dx8.h>
+#include "Vector3.h"
 
 
 //------------------------------------------------------------------------------
@@ -34,17 +33,17 @@ class Player
 public:
 	Player();
 
-	D3DXVECTOR3 GetPos() const { return m_vPosition; }
+	Vector3 GetPos() const { return m_vPosition; }
 
 	void SetPosition( const float x, const float y )
 	{
-		m_vPosition = D3DXVECTOR3( x, y, 0.5f );
+		m_vPosition = Vector3( x, y, 0.5f );
 		m_hasReachedGoal = false;
 	}
 
 	void SetGoal( const float x, const float y )
 	{
-		m_vGoal = D3DXVECTOR3( x, y, 0.5 );
+		m_vGoal = Vector3( x, y, 0.5f );
 		m_hasReachedGoal = false;
 	}
 
@@ -56,8 +55,8 @@ private:
 
 	bool m_hasReachedGoal;
 
-	D3DXVECTOR3 m_vPosition;
-	D3DXVECTOR3 m_vGoal;
+	Vector3 m_vPosition;
+	Vector3 m_vGoal;
 };
 
 #endif //INCLUSIONGUARD_PLAYER_H
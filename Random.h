@@ -0,0 +1,63 @@
+//------------------------------------------------------------------------------
+// File: Random.h
+// Desc: Small seedable pseudo-random number generator
+//
+// Created: 19 October 2026 16:33:26
+//
+// (c)2002 Neil Wakefield
+//------------------------------------------------------------------------------
+
+
+#ifndef INCLUSIONGUARD_RANDOM_H
+#define INCLUSIONGUARD_RANDOM_H
+
+
+//------------------------------------------------------------------------------
+// Prototypes and declarations:
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Name: class Random
+// Desc: Xorshift generator with 32 bits of state. Unlike rand() each object
+//		 has its own sequence, the full 32 bit range is available and the same
+//		 seed gives the same sequence on every platform
+//------------------------------------------------------------------------------
+class Random
+{
+
+public:
+	Random( const unsigned int seed = 1 ) { Seed( seed ); }
+
+	void Seed( const unsigned int seed )
+	{
+		//scramble the seed so that nearby seeds give unrelated sequences, and
+		// avoid the all-zero state which xorshift can never leave
+		unsigned int s = seed * 0x9e3779b9u + 0x7f4a7c15u;
+		s ^= s >> 16;
+		s *= 0x85ebca6bu;
+		s ^= s >> 13;
+		m_state = ( 0 == s ) ? 0x6d2b79f5u : s;
+	}
+
+	unsigned int Next()
+	{
+		unsigned int s = m_state;
+		s ^= s << 13;
+		s ^= s >> 17;
+		s ^= s << 5;
+		m_state = s;
+		return s;
+	}
+
+	//returns a number in [0, range)
+	unsigned int Next( const unsigned int range ) { return Next() % range; }
+
+	unsigned int GetState() const { return m_state; }
+
+private:
+	unsigned int m_state;
+
+};
+
+
+#endif //INCLUSIONGUARD_RANDOM_H
@@ -0,0 +1,138 @@
+//------------------------------------------------------------------------------
+// File: Simulation.cpp
+// Desc: Fixed-timestep game state, independent of the renderer
+//
+// Created: 20 October 2026 04:44:03
+//
+// (c)2002 Neil Wakefield
+//------------------------------------------------------------------------------
+
+
+//------------------------------------------------------------------------------
+// Included files:
+//------------------------------------------------------------------------------
+#include "Simulation.h"
+#include "Timer.h"
+
+#include <math.h>
+
+
+//------------------------------------------------------------------------------
+// Globals:
+//------------------------------------------------------------------------------
+
+
+//------------------------------------------------------------------------------
+// Definitions:
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Name: Simulation()
+// Desc: Constructor for the simulation, generating the first maze from the
+//		 seed. Later mazes carry on from the same random sequence
+//------------------------------------------------------------------------------
+Simulation::Simulation( const unsigned int seed, const int width, const int height )
+	: m_grid( width, height )
+{
+	m_tickLength = 1.0f / float( CONST_TICK_RATE );
+	m_accumulator = 0.0f;
+	m_tickCount = 0;
+	m_mazeCount = 0;
+
+	Timer timer;
+	m_grid.SetPathSmoothing( true );
+	m_grid.GenerateMaze( seed );
+	StartMaze();
+	m_regenerateSeconds = float( timer.GetSeconds() );
+}
+
+//------------------------------------------------------------------------------
+// Name: Advance()
+// Desc: Moves the clock on, running each tick that falls due
+//------------------------------------------------------------------------------
+void Simulation::Advance( const float elapsed )
+{
+	m_accumulator += elapsed;
+
+	int numTicks = 0;
+	while( m_accumulator >= m_tickLength && numTicks < CONST_MAX_TICKS_PER_ADVANCE )
+	{
+		Tick();
+		m_accumulator -= m_tickLength;
+		++numTicks;
+	}
+
+	//too far behind to catch up, so drop the whole ticks still owed
+	if( m_accumulator >= m_tickLength )
+		m_accumulator = fmodf( m_accumulator, m_tickLength );
+}
+
+//------------------------------------------------------------------------------
+// Name: Tick()
+// Desc: Moves the player one tick along the solution, starting a new maze
+//		 once the last square has been reached
+//------------------------------------------------------------------------------
+void Simulation::Tick()
+{
+	++m_tickCount;
+	m_previousPosition = m_player.GetPos();
+
+	//check to see if we need to get the next goal point for the player
+	if( m_player.HasReachedGoal() )
+	{
+		MazeSquare square;
+		if( ! m_grid.PopNextSolution( square ) )
+		{
+			//no more solutions left, it's time to generate a new maze
+			Timer timer;
+			m_grid.GenerateMaze();
+			StartMaze();
+			m_regenerateSeconds = float( timer.GetSeconds() );
+			return;
+		}
+
+		SetGoal( square );
+	}
+
+	//update the player's position
+	m_player.MovePlayer( m_tickLength );
+}
+
+//------------------------------------------------------------------------------
+// Name: GetPlayerPosition()
+// Desc: Blends the player's position over the last tick
+//------------------------------------------------------------------------------
+Vector3 Simulation::GetPlayerPosition( const float alpha ) const
+{
+	const Vector3 step = Vec3Subtract( m_player.GetPos(), m_previousPosition );
+	return Vec3Add( m_previousPosition, Vec3Scale( step, alpha ) );
+}
+
+//------------------------------------------------------------------------------
+// Name: StartMaze()
+// Desc: Solves a freshly generated maze and puts the player at its entrance
+//------------------------------------------------------------------------------
+void Simulation::StartMaze()
+{
+	m_grid.GenerateSolution();
+
+	MazeSquare square;
+	m_grid.PopNextSolution( square );
+	m_player.SetPosition( square.x - m_grid.GetWidth() / 2.0f, square.y - m_grid.GetHeight() / 2.0f );
+	m_grid.PopNextSolution( square );
+	SetGoal( square );
+
+	//nothing to blend from in a new maze
+	m_previousPosition = m_player.GetPos();
+	++m_mazeCount;
+}
+
+//------------------------------------------------------------------------------
+// Name: SetGoal()
+// Desc: Points the player at a square, in the world space the maze is drawn
+//		 in with its centre at the origin
+//------------------------------------------------------------------------------
+void Simulation::SetGoal( const MazeSquare& square )
+{
+	m_player.SetGoal( square.x - m_grid.GetWidth() / 2.0f, square.y - m_grid.GetHeight() / 2.0f );
+}
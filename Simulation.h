@@ -0,0 +1,88 @@
+//------------------------------------------------------------------------------
+// File: Simulation.h
+// Desc: Fixed-timestep game state, independent of the renderer
+//
+// Created: 20 October 2026 04:31:26
+//
+// (c)2002 Neil Wakefield
+//------------------------------------------------------------------------------
+
+
+#ifndef INCLUSIONGUARD_SIMULATION_H
+#define INCLUSIONGUARD_SIMULATION_H
+
+
+//------------------------------------------------------------------------------
+// Included files:
+//------------------------------------------------------------------------------
+#include "Constants.h"
+#include "Grid.h"
+#include "Player.h"
+#include "Vector3.h"
+
+
+//------------------------------------------------------------------------------
+// Prototypes and declarations:
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Name: class Simulation
+// Desc: The maze and the player walking its solution, stepped in ticks of a
+//		 fixed length. Real time is fed in through Advance, which runs as
+//		 many whole ticks as it covers and keeps the remainder, so the same
+//		 seed walks the same route tick for tick whatever the frame rate.
+//		 The renderer draws between the last two ticks using GetAlpha, and
+//		 headless runs can call Tick directly as fast as it will go
+//------------------------------------------------------------------------------
+class Simulation
+{
+
+public:
+	Simulation( const unsigned int seed, const int width = CONST_GRID_SIZE,
+				const int height = CONST_GRID_SIZE );
+
+	//runs the ticks due after elapsed more seconds, at most
+	// CONST_MAX_TICKS_PER_ADVANCE of them so a stall can't snowball
+	void Advance( const float elapsed );
+
+	//forgets any part tick carried over, after a pause
+	void ResetClock() { m_accumulator = 0.0f; }
+
+	void Tick();
+
+	float GetTickLength() const { return m_tickLength; }
+	unsigned int GetTickCount() const { return m_tickCount; }
+
+	//how far from the last tick towards the next the clock has got
+	float GetAlpha() const { return m_accumulator / m_tickLength; }
+
+	//where to draw the player, between the last two ticks
+	Vector3 GetPlayerPosition( const float alpha ) const;
+
+	Grid& GetGrid() { return m_grid; }
+	const Grid& GetGrid() const { return m_grid; }
+	const Player& GetPlayer() const { return m_player; }
+
+	//goes up by one with each new maze
+	unsigned int GetMazeCount() const { return m_mazeCount; }
+	float GetRegenerateSeconds() const { return m_regenerateSeconds; }
+
+private:
+	Grid m_grid;
+	Player m_player;
+	Vector3 m_previousPosition;		//the player at the start of the last tick
+
+	float m_tickLength;
+	float m_accumulator;			//seconds not yet ticked
+	unsigned int m_tickCount;
+
+	unsigned int m_mazeCount;
+	float m_regenerateSeconds;		//how long the last new maze took
+
+	void StartMaze();
+	void SetGoal( const MazeSquare& square );
+
+};
+
+
+#endif //INCLUSIONGUARD_SIMULATION_H
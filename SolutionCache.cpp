@@ -0,0 +1,181 @@
+//------------------------------------------------------------------------------
+// File: SolutionCache.cpp
+// Desc: Least recently used cache of maze solutions
+//
+// Created: 19 October 2026 18:10:47
+//
+// (c)2002 Neil Wakefield
+//------------------------------------------------------------------------------
+
+
+//------------------------------------------------------------------------------
+// Included files:
+//------------------------------------------------------------------------------
+#include "SolutionCache.h"
+
+
+//------------------------------------------------------------------------------
+// Globals:
+//------------------------------------------------------------------------------
+namespace
+{
+	//rough cost of the list and map nodes that hold an entry
+	const size_t g_nodeBytes = 64;
+
+	//offsets for each move, in the order of Grid::Direction
+	const int g_moveX[ 4 ] = { 0, 1, 0, -1 };
+	const int g_moveY[ 4 ] = { 1, 0, -1, 0 };
+}
+
+
+//------------------------------------------------------------------------------
+// Definitions:
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Name: SolutionCache()
+// Desc: Constructor for the solution cache
+//------------------------------------------------------------------------------
+SolutionCache::SolutionCache( const size_t maxBytes )
+{
+	m_maxBytes = maxBytes;
+	m_usedBytes = 0;
+
+	m_hits = 0;
+	m_misses = 0;
+}
+
+//------------------------------------------------------------------------------
+// Name: SetMaxBytes()
+// Desc: Changes the memory budget, dropping entries if it has shrunk
+//------------------------------------------------------------------------------
+void SolutionCache::SetMaxBytes( const size_t maxBytes )
+{
+	m_maxBytes = maxBytes;
+	Trim();
+}
+
+//------------------------------------------------------------------------------
+// Name: Find()
+// Desc: Copies out the solution stored under a key, returning FALSE if there
+//		 isn't one. A hit makes the entry the most recently used
+//------------------------------------------------------------------------------
+bool SolutionCache::Find( const SolutionKey& key, SquareVector& solution )
+{
+	EntryMap::iterator found = m_lookup.find( key );
+	if( found == m_lookup.end() )
+	{
+		++m_misses;
+		return false;
+	}
+	++m_hits;
+
+	//move to the front without copying the entry
+	EntryList::iterator entry = found->second;
+	m_entries.splice( m_entries.begin(), m_entries, entry );
+
+	//unpack the moves
+	solution.clear();
+	MazeSquare square = entry->first;
+	solution.push_back( square );
+	for( int i = 0; i < entry->numMoves; ++i )
+	{
+		const int move = ( entry->moves[ i >> 2 ] >> ( ( i & 3 ) * 2 ) ) & 3;
+		square.x += g_moveX[ move ];
+		square.y += g_moveY[ move ];
+		solution.push_back( square );
+	}
+
+	return true;
+}
+
+//------------------------------------------------------------------------------
+// Name: Store()
+// Desc: Adds a solution under a key, replacing any already there. Solutions
+//		 that aren't a chain of single steps can't be packed and are skipped
+//------------------------------------------------------------------------------
+void SolutionCache::Store( const SolutionKey& key, const SquareVector& solution )
+{
+	if( solution.empty() )
+		return;
+
+	EntryMap::iterator found = m_lookup.find( key );
+	if( found != m_lookup.end() )
+		Remove( found->second );
+
+	Entry entry;
+	entry.key = key;
+	entry.first = solution.front();
+	entry.numMoves = int( solution.size() ) - 1;
+	entry.moves.assign( ( entry.numMoves + 3 ) / 4, 0 );
+
+	SquareVector::const_iterator iter = solution.begin();
+	MazeSquare previous = *iter;
+	int i = 0;
+	for( ++iter; iter != solution.end(); ++iter, ++i )
+	{
+		const int dx = iter->x - previous.x;
+		const int dy = iter->y - previous.y;
+
+		int move = 0;
+		while( move < 4 && ( g_moveX[ move ] != dx || g_moveY[ move ] != dy ) )
+			++move;
+		if( 4 == move )
+			return;
+
+		entry.moves[ i >> 2 ] |= (unsigned char)( move << ( ( i & 3 ) * 2 ) );
+		previous = *iter;
+	}
+
+	//don't flush the whole cache for one solution that can never fit
+	const size_t bytes = GetEntryBytes( entry );
+	if( bytes > m_maxBytes )
+		return;
+
+	m_entries.push_front( entry );
+	m_lookup[ key ] = m_entries.begin();
+	m_usedBytes += bytes;
+
+	Trim();
+}
+
+//------------------------------------------------------------------------------
+// Name: Clear()
+// Desc: Drops every entry, leaving the hit and miss counters alone
+//------------------------------------------------------------------------------
+void SolutionCache::Clear()
+{
+	m_entries.clear();
+	m_lookup.clear();
+	m_usedBytes = 0;
+}
+
+//------------------------------------------------------------------------------
+// Name: GetEntryBytes()
+// Desc: Returns the memory charged to an entry against the budget
+//------------------------------------------------------------------------------
+size_t SolutionCache::GetEntryBytes( const Entry& entry )
+{
+	return sizeof( Entry ) + g_nodeBytes + entry.moves.size();
+}
+
+//------------------------------------------------------------------------------
+// Name: Remove()
+// Desc: Drops a single entry
+//------------------------------------------------------------------------------
+void SolutionCache::Remove( EntryList::iterator entry )
+{
+	m_usedBytes -= GetEntryBytes( *entry );
+	m_lookup.erase( entry->key );
+	m_entries.erase( entry );
+}
+
+//------------------------------------------------------------------------------
+// Name: Trim()
+// Desc: Drops the least recently used entries until within the budget
+//------------------------------------------------------------------------------
+void SolutionCache::Trim()
+{
+	while( m_usedBytes > m_maxBytes && ! m_entries.empty() )
+		Remove( --m_entries.end() );
+}
@@ -0,0 +1,115 @@
+//------------------------------------------------------------------------------
+// File: SolutionCache.h
+// Desc: Least recently used cache of maze solutions
+//
+// Created: 19 October 2026 18:10:47
+//
+// (c)2002 Neil Wakefield
+//------------------------------------------------------------------------------
+
+
+#ifndef INCLUSIONGUARD_SOLUTIONCACHE_H
+#define INCLUSIONGUARD_SOLUTIONCACHE_H
+
+
+//------------------------------------------------------------------------------
+// Included files:
+//------------------------------------------------------------------------------
+#include "Constants.h"
+#include "Grid.h"
+#include "MemoryTracker.h"
+#include "Types.h"
+
+#include <list>
+#include <map>
+#include <vector>
+using namespace std;
+
+
+//------------------------------------------------------------------------------
+// Prototypes and declarations:
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Name: struct SolutionKey
+// Desc: Identifies a solve - the grid contents, both ends and the solver used
+//------------------------------------------------------------------------------
+struct SolutionKey
+{
+	SolutionKey() : hash( 0 ), startCell( 0 ), goalCell( 0 ), solver( 0 ) {}
+
+	bool operator<( const SolutionKey& other ) const
+	{
+		if( hash != other.hash )
+			return hash < other.hash;
+		if( startCell != other.startCell )
+			return startCell < other.startCell;
+		if( goalCell != other.goalCell )
+			return goalCell < other.goalCell;
+		return solver < other.solver;
+	}
+
+	uint64 hash;
+	int startCell;
+	int goalCell;
+	int solver;
+};
+
+//------------------------------------------------------------------------------
+// Name: class SolutionCache
+// Desc: Maps keys to solutions, dropping the least recently used once the
+//		 memory budget is reached. Each step of a path is packed into two bits,
+//		 so a cached solution costs about a quarter of a byte per square.
+//		 Grids on the same thread may share one cache. There is no locking, so
+//		 each thread needs its own
+//------------------------------------------------------------------------------
+class SolutionCache
+{
+
+public:
+	SolutionCache( const size_t maxBytes = CONST_SOLUTION_CACHE_BYTES );
+
+	void SetMaxBytes( const size_t maxBytes );
+	size_t GetMaxBytes() const { return m_maxBytes; }
+	size_t GetUsedBytes() const { return m_usedBytes; }
+	int GetNumEntries() const { return int( m_entries.size() ); }
+
+	bool Find( const SolutionKey& key, SquareVector& solution );
+	void Store( const SolutionKey& key, const SquareVector& solution );
+	void Clear();
+
+	unsigned int GetHits() const { return m_hits; }
+	unsigned int GetMisses() const { return m_misses; }
+	void ResetCounters() { m_hits = 0; m_misses = 0; }
+
+private:
+	struct Entry
+	{
+		SolutionKey key;
+		MazeSquare first;
+		int numMoves;
+		TrackedVector< unsigned char, MemoryTracker::SUBSYSTEM_SOLUTION >::Type moves;	//four moves to a byte
+	};
+
+	typedef list< Entry, TrackedAllocator< Entry, MemoryTracker::SUBSYSTEM_SOLUTION > > EntryList;
+	typedef pair< const SolutionKey, EntryList::iterator > EntryPair;
+	typedef map< SolutionKey, EntryList::iterator, less< SolutionKey >,
+				 TrackedAllocator< EntryPair, MemoryTracker::SUBSYSTEM_SOLUTION > > EntryMap;
+
+	size_t m_maxBytes;
+	size_t m_usedBytes;
+
+	EntryList m_entries;	//most recently used first
+	EntryMap m_lookup;
+
+	unsigned int m_hits;
+	unsigned int m_misses;
+
+	static size_t GetEntryBytes( const Entry& entry );
+	void Remove( EntryList::iterator entry );
+	void Trim();
+
+};
+
+
+#endif //INCLUSIONGUARD_SOLUTIONCACHE_H
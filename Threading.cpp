@@ -0,0 +1,396 @@
+//------------------------------------------------------------------------------
+// File: Threading.cpp
+// Desc: Threads and atomic operations for Win32 and POSIX
+//
+// Created: 19 October 2026 20:31:05
+//
+// (c)2002 Neil Wakefield
+//------------------------------------------------------------------------------
+
+
+//------------------------------------------------------------------------------
+// Included files:
+//------------------------------------------------------------------------------
+#include "Threading.h"
+
+#include <stddef.h>
+
+#ifdef WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#include <process.h>
+#else
+#include <sched.h>
+#include <unistd.h>
+#endif
+
+
+//------------------------------------------------------------------------------
+// Globals:
+//------------------------------------------------------------------------------
+
+
+//------------------------------------------------------------------------------
+// Definitions:
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Name: AtomicIncrement()
+// Desc: Adds one to a value, returning the result
+//------------------------------------------------------------------------------
+long AtomicIncrement( volatile long* pValue )
+{
+#ifdef WIN32
+	return InterlockedIncrement( pValue );
+#else
+	return __sync_add_and_fetch( pValue, 1 );
+#endif
+}
+
+//------------------------------------------------------------------------------
+// Name: AtomicDecrement()
+// Desc: Subtracts one from a value, returning the result
+//------------------------------------------------------------------------------
+long AtomicDecrement( volatile long* pValue )
+{
+#ifdef WIN32
+	return InterlockedDecrement( pValue );
+#else
+	return __sync_sub_and_fetch( pValue, 1 );
+#endif
+}
+
+//------------------------------------------------------------------------------
+// Name: AtomicAdd()
+// Desc: Adds an amount to a value, returning the result
+//------------------------------------------------------------------------------
+long AtomicAdd( volatile long* pValue, const long amount )
+{
+#ifdef WIN32
+	return InterlockedExchangeAdd( pValue, amount ) + amount;
+#else
+	return __sync_add_and_fetch( pValue, amount );
+#endif
+}
+
+//------------------------------------------------------------------------------
+// Name: AtomicCompareExchange()
+// Desc: Sets a value to exchange if it equals comparand, returning the value
+//		 it held beforehand
+//------------------------------------------------------------------------------
+long AtomicCompareExchange( volatile long* pValue, const long exchange, const long comparand )
+{
+#ifdef WIN32
+	return InterlockedCompareExchange( pValue, exchange, comparand );
+#else
+	return __sync_val_compare_and_swap( pValue, comparand, exchange );
+#endif
+}
+
+//------------------------------------------------------------------------------
+// Name: AtomicExchangePointer()
+// Desc: Stores a pointer, returning the one it replaced
+//------------------------------------------------------------------------------
+void* AtomicExchangePointer( void* volatile* ppTarget, void* pValue )
+{
+#ifdef WIN32
+	return InterlockedExchangePointer( ppTarget, pValue );
+#else
+	//test_and_set is only an acquire barrier, so swap with a full one instead
+	void* pPrevious;
+	do
+	{
+		pPrevious = AtomicLoadPointer( ppTarget );
+	}
+	while( __sync_val_compare_and_swap( ppTarget, pPrevious, pValue ) != pPrevious );
+
+	return pPrevious;
+#endif
+}
+
+//------------------------------------------------------------------------------
+// Name: AtomicLoad()
+// Desc: Reads a value another thread may be changing, seeing every store that
+//		 thread made before it
+//------------------------------------------------------------------------------
+long AtomicLoad( const volatile long* pValue )
+{
+	//an exchange that changes nothing, as there is no plain atomic read
+	volatile long* pTarget = (volatile long*)( pValue );
+#ifdef WIN32
+	return InterlockedCompareExchange( pTarget, 0, 0 );
+#else
+	return __sync_fetch_and_add( pTarget, 0 );
+#endif
+}
+
+//------------------------------------------------------------------------------
+// Name: AtomicLoadPointer()
+// Desc: Reads a pointer another thread may be changing, seeing every store
+//		 that thread made before it
+//------------------------------------------------------------------------------
+void* AtomicLoadPointer( void* const volatile* ppValue )
+{
+	void* volatile* ppTarget = (void* volatile*)( ppValue );
+#ifdef WIN32
+	return InterlockedCompareExchangePointer( ppTarget, NULL, NULL );
+#else
+	return __sync_val_compare_and_swap( ppTarget, (void*)( 0 ), (void*)( 0 ) );
+#endif
+}
+
+//------------------------------------------------------------------------------
+// Name: YieldThread()
+// Desc: Gives up the rest of this thread's time slice
+//------------------------------------------------------------------------------
+void YieldThread()
+{
+#ifdef WIN32
+	Sleep( 0 );
+#else
+	sched_yield();
+#endif
+}
+
+//------------------------------------------------------------------------------
+// Name: GetNumProcessors()
+// Desc: Returns the number of processors available, at least one
+//------------------------------------------------------------------------------
+int GetNumProcessors()
+{
+#ifdef WIN32
+	SYSTEM_INFO info;
+	GetSystemInfo( &info );
+	const int count = int( info.dwNumberOfProcessors );
+#else
+	const int count = int( sysconf( _SC_NPROCESSORS_ONLN ) );
+#endif
+
+	return ( count > 0 ) ? count : 1;
+}
+
+//------------------------------------------------------------------------------
+// Name: Thread()
+// Desc: Constructor for a thread, which doesn't run until started
+//------------------------------------------------------------------------------
+Thread::Thread()
+{
+	m_running = false;
+	m_pFunction = NULL;
+	m_pArg = NULL;
+#ifdef WIN32
+	m_handle = NULL;
+#endif
+}
+
+//------------------------------------------------------------------------------
+// Name: ~Thread()
+// Desc: Destructor for a thread, waiting for it to finish
+//------------------------------------------------------------------------------
+Thread::~Thread()
+{
+	Join();
+}
+
+//------------------------------------------------------------------------------
+// Name: Start()
+// Desc: Runs a function on a new thread, returning FALSE if it can't start
+//------------------------------------------------------------------------------
+bool Thread::Start( Function pFunction, void* pArg )
+{
+	if( m_running )
+		return false;
+
+	m_pFunction = pFunction;
+	m_pArg = pArg;
+
+#ifdef WIN32
+	//_beginthreadex rather than CreateThread, so the C runtime is set up
+	unsigned int id;
+	m_handle = (void*)( _beginthreadex( NULL, 0, Run, this, 0, &id ) );
+	m_running = ( m_handle != NULL );
+#else
+	m_running = ( 0 == pthread_create( &m_thread, NULL, Run, this ) );
+#endif
+
+	return m_running;
+}
+
+//------------------------------------------------------------------------------
+// Name: Join()
+// Desc: Waits for the thread to finish
+//------------------------------------------------------------------------------
+void Thread::Join()
+{
+	if( ! m_running )
+		return;
+
+#ifdef WIN32
+	WaitForSingleObject( m_handle, INFINITE );
+	CloseHandle( m_handle );
+	m_handle = NULL;
+#else
+	pthread_join( m_thread, NULL );
+#endif
+
+	m_running = false;
+}
+
+//------------------------------------------------------------------------------
+// Name: Run()
+// Desc: Entry point for new threads, calling on to the thread's function
+//------------------------------------------------------------------------------
+#ifdef WIN32
+unsigned int __stdcall Thread::Run( void* pThread )
+{
+	Thread* pSelf = (Thread*)( pThread );
+	pSelf->m_pFunction( pSelf->m_pArg );
+	return 0;
+}
+#else
+void* Thread::Run( void* pThread )
+{
+	Thread* pSelf = (Thread*)( pThread );
+	pSelf->m_pFunction( pSelf->m_pArg );
+	return NULL;
+}
+#endif
+
+//------------------------------------------------------------------------------
+// Name: Semaphore()
+// Desc: Constructor for a semaphore, starting at zero
+//------------------------------------------------------------------------------
+Semaphore::Semaphore()
+{
+#ifdef WIN32
+	m_handle = CreateSemaphore( NULL, 0, 0x7fffffff, NULL );
+#else
+	pthread_mutex_init( &m_mutex, NULL );
+	pthread_cond_init( &m_condition, NULL );
+	m_count = 0;
+#endif
+}
+
+//------------------------------------------------------------------------------
+// Name: ~Semaphore()
+// Desc: Destructor for a semaphore. Nothing may still be waiting on it
+//------------------------------------------------------------------------------
+Semaphore::~Semaphore()
+{
+#ifdef WIN32
+	CloseHandle( m_handle );
+#else
+	pthread_cond_destroy( &m_condition );
+	pthread_mutex_destroy( &m_mutex );
+#endif
+}
+
+//------------------------------------------------------------------------------
+// Name: Post()
+// Desc: Adds one to the count, waking a waiting thread if there is one
+//------------------------------------------------------------------------------
+void Semaphore::Post()
+{
+#ifdef WIN32
+	ReleaseSemaphore( m_handle, 1, NULL );
+#else
+	pthread_mutex_lock( &m_mutex );
+	++m_count;
+	pthread_cond_signal( &m_condition );
+	pthread_mutex_unlock( &m_mutex );
+#endif
+}
+
+//------------------------------------------------------------------------------
+// Name: Wait()
+// Desc: Waits for the count to be above zero, then takes one off it
+//------------------------------------------------------------------------------
+void Semaphore::Wait()
+{
+#ifdef WIN32
+	WaitForSingleObject( m_handle, INFINITE );
+#else
+	pthread_mutex_lock( &m_mutex );
+	while( 0 == m_count )
+		pthread_cond_wait( &m_condition, &m_mutex );
+	--m_count;
+	pthread_mutex_unlock( &m_mutex );
+#endif
+}
+
+//------------------------------------------------------------------------------
+// Name: MpscQueue()
+// Desc: Constructor for the queue, which starts out holding just the stub
+//------------------------------------------------------------------------------
+MpscQueue::MpscQueue()
+{
+	m_stub.next = NULL;
+	m_pHead = &m_stub;
+	m_pTail = &m_stub;
+}
+
+//------------------------------------------------------------------------------
+// Name: Push()
+// Desc: Adds a node to the queue. Safe to call from any thread
+//------------------------------------------------------------------------------
+void MpscQueue::Push( MpscNode* pNode )
+{
+	pNode->next = NULL;
+	MpscNode* pPrevious = (MpscNode*)( AtomicExchangePointer( (void* volatile*)( &m_pHead ), pNode ) );
+
+	//until this link is made the consumer can't see pNode or anything after it
+	AtomicExchangePointer( (void* volatile*)( &pPrevious->next ), pNode );
+}
+
+//------------------------------------------------------------------------------
+// Name: LoadNext()
+// Desc: Reads a node's link, which a producer may be setting from another
+//		 thread
+//------------------------------------------------------------------------------
+MpscNode* MpscQueue::LoadNext( MpscNode* pNode )
+{
+	return (MpscNode*)( AtomicLoadPointer( (void* volatile*)( &pNode->next ) ) );
+}
+
+//------------------------------------------------------------------------------
+// Name: Pop()
+// Desc: Takes the oldest node off the queue, or returns NULL if none is ready.
+//		 Only the consuming thread may call this
+//------------------------------------------------------------------------------
+MpscNode* MpscQueue::Pop()
+{
+	MpscNode* pTail = m_pTail;
+	MpscNode* pNext = LoadNext( pTail );
+
+	//skip over the stub
+	if( pTail == &m_stub )
+	{
+		if( NULL == pNext )
+			return NULL;
+
+		m_pTail = pNext;
+		pTail = pNext;
+		pNext = LoadNext( pNext );
+	}
+
+	if( pNext != NULL )
+	{
+		m_pTail = pNext;
+		return pTail;
+	}
+
+	//pTail looks like the last node, but a producer may be partway through
+	if( pTail != AtomicLoadPointer( (void* volatile*)( &m_pHead ) ) )
+		return NULL;
+
+	//put the stub back behind it, so pTail can be handed out
+	Push( &m_stub );
+	pNext = LoadNext( pTail );
+	if( pNext != NULL )
+	{
+		m_pTail = pNext;
+		return pTail;
+	}
+
+	return NULL;
+}
@@ -0,0 +1,145 @@
+//------------------------------------------------------------------------------
+// File: Threading.h
+// Desc: Threads and atomic operations for Win32 and POSIX
+//
+// Created: 19 October 2026 20:31:05
+//
+// (c)2002 Neil Wakefield
+//------------------------------------------------------------------------------
+
+
+#ifndef INCLUSIONGUARD_THREADING_H
+#define INCLUSIONGUARD_THREADING_H
+
+
+//------------------------------------------------------------------------------
+// Included files:
+//------------------------------------------------------------------------------
+#ifndef WIN32
+#include <pthread.h>
+#endif
+
+
+//------------------------------------------------------------------------------
+// Prototypes and declarations:
+//------------------------------------------------------------------------------
+
+//all of these act as full memory barriers
+long AtomicIncrement( volatile long* pValue );
+long AtomicDecrement( volatile long* pValue );
+long AtomicAdd( volatile long* pValue, const long amount );
+long AtomicCompareExchange( volatile long* pValue, const long exchange, const long comparand );
+void* AtomicExchangePointer( void* volatile* ppTarget, void* pValue );
+long AtomicLoad( const volatile long* pValue );
+void* AtomicLoadPointer( void* const volatile* ppValue );
+
+void YieldThread();
+int GetNumProcessors();
+
+//------------------------------------------------------------------------------
+// Name: class Thread
+// Desc: A single worker thread running a plain function
+//------------------------------------------------------------------------------
+class Thread
+{
+
+public:
+	Thread();
+	~Thread();
+
+	typedef void ( *Function )( void* pArg );
+
+	bool Start( Function pFunction, void* pArg );
+	void Join();
+
+	bool IsRunning() const { return m_running; }
+
+private:
+	bool m_running;
+	Function m_pFunction;
+	void* m_pArg;
+
+#ifdef WIN32
+	void* m_handle;
+	static unsigned int __stdcall Run( void* pThread );
+#else
+	pthread_t m_thread;
+	static void* Run( void* pThread );
+#endif
+
+	//not copyable
+	Thread( const Thread& );
+	Thread& operator=( const Thread& );
+
+};
+
+//------------------------------------------------------------------------------
+// Name: class Semaphore
+// Desc: Counter that Wait blocks on while it is zero, for idle workers to
+//		 sleep on instead of spinning
+//------------------------------------------------------------------------------
+class Semaphore
+{
+
+public:
+	Semaphore();
+	~Semaphore();
+
+	void Post();
+	void Wait();
+
+private:
+#ifdef WIN32
+	void* m_handle;
+#else
+	pthread_mutex_t m_mutex;
+	pthread_cond_t m_condition;
+	long m_count;
+#endif
+
+	//not copyable
+	Semaphore( const Semaphore& );
+	Semaphore& operator=( const Semaphore& );
+
+};
+
+//------------------------------------------------------------------------------
+// Name: struct MpscNode
+// Desc: Link embedded at the start of anything passed through an MpscQueue
+//------------------------------------------------------------------------------
+struct MpscNode
+{
+	MpscNode* volatile next;
+};
+
+//------------------------------------------------------------------------------
+// Name: class MpscQueue
+// Desc: Lock-free intrusive queue with many producers and a single consumer,
+//		 after Dmitry Vyukov's design. Push is a single atomic exchange and
+//		 never waits. Pop may briefly report empty while a push is half done,
+//		 so consumers must poll rather than treat empty as final
+//------------------------------------------------------------------------------
+class MpscQueue
+{
+
+public:
+	MpscQueue();
+
+	void Push( MpscNode* pNode );
+	MpscNode* Pop();
+
+private:
+	MpscNode* volatile m_pHead;		//last pushed, shared by the producers
+	MpscNode* m_pTail;				//next to pop, owned by the consumer
+	MpscNode m_stub;
+
+	static MpscNode* LoadNext( MpscNode* pNode );
+
+	//not copyable - the stub's address is part of the queue
+	MpscQueue( const MpscQueue& );
+	MpscQueue& operator=( const MpscQueue& );
+
+};
+
+
+#endif //INCLUSIONGUARD_THREADING_H
@@ -0,0 +1,56 @@
+//------------------------------------------------------------------------------
+// File: Timer.cpp
+// Desc: High resolution timer for profiling
+//
+// Created: 19 October 2026 14:46:58
+//
+// (c)2002 Neil Wakefield
+//------------------------------------------------------------------------------
+
+
+//------------------------------------------------------------------------------
+// Included files:
+//------------------------------------------------------------------------------
+#include "Timer.h"
+
+#ifdef WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+
+//------------------------------------------------------------------------------
+// Globals:
+//------------------------------------------------------------------------------
+
+
+//------------------------------------------------------------------------------
+// Definitions:
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Name: GetTime()
+// Desc: Returns the current time in seconds from an arbitrary starting point
+//------------------------------------------------------------------------------
+double Timer::GetTime()
+{
+#ifdef WIN32
+	static double secondsPerCount = 0.0;
+	if( 0.0 == secondsPerCount )
+	{
+		LARGE_INTEGER frequency;
+		QueryPerformanceFrequency( &frequency );
+		secondsPerCount = 1.0 / double( frequency.QuadPart );
+	}
+
+	LARGE_INTEGER count;
+	QueryPerformanceCounter( &count );
+	return double( count.QuadPart ) * secondsPerCount;
+#else
+	timespec now;
+	clock_gettime( CLOCK_MONOTONIC, &now );
+	return double( now.tv_sec ) + double( now.tv_nsec ) * 1.0e-9;
+#endif
+}
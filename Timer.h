@@ -0,0 +1,49 @@
+//------------------------------------------------------------------------------
+// File: Timer.h
+// Desc: High resolution timer for profiling
+//
+// Created: 19 October 2026 14:40:12
+//
+// (c)2002 Neil Wakefield
+//------------------------------------------------------------------------------
+
+
+#ifndef INCLUSIONGUARD_TIMER_H
+#define INCLUSIONGUARD_TIMER_H
+
+
+//------------------------------------------------------------------------------
+// Prototypes and declarations:
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Name: class Timer
+// Desc: Measures elapsed wall-clock time using the performance counter on
+//		 Windows and the monotonic clock elsewhere
+//------------------------------------------------------------------------------
+class Timer
+{
+
+public:
+	Timer() { Start(); }
+
+	void Start() { m_start = GetTime(); }
+	double GetSeconds() const { return GetTime() - m_start; }
+
+	double Lap()
+	{
+		const double now = GetTime();
+		const double elapsed = now - m_start;
+		m_start = now;
+		return elapsed;
+	}
+
+	static double GetTime();
+
+private:
+	double m_start;
+
+};
+
+
+#endif //INCLUSIONGUARD_TIMER_H
@@ -0,0 +1,69 @@
+//------------------------------------------------------------------------------
+// File: TranspositionTable.cpp
+// Desc: Fixed-size table of the cheapest cost each cell has been reached at
+//
+// Created: 19 October 2026 19:48:30
+//
+// (c)2002 Neil Wakefield
+//------------------------------------------------------------------------------
+
+
+//------------------------------------------------------------------------------
+// Included files:
+//------------------------------------------------------------------------------
+#include "TranspositionTable.h"
+
+
+//------------------------------------------------------------------------------
+// Globals:
+//------------------------------------------------------------------------------
+
+
+//------------------------------------------------------------------------------
+// Definitions:
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Name: TranspositionTable()
+// Desc: Constructor for the transposition table
+//------------------------------------------------------------------------------
+TranspositionTable::TranspositionTable()
+{
+	m_mask = 0;
+	m_iteration = 0;
+	Resize( 0 );
+}
+
+//------------------------------------------------------------------------------
+// Name: Resize()
+// Desc: Sizes the table to the largest power of two entries within a budget,
+//		 with a single entry as the minimum. The table is left empty
+//------------------------------------------------------------------------------
+void TranspositionTable::Resize( const size_t maxBytes )
+{
+	size_t numEntries = 1;
+	while( numEntries * 2 * sizeof( Entry ) <= maxBytes )
+		numEntries *= 2;
+
+	Entry empty;
+	empty.cell = -1;
+	empty.cost = 0;
+	empty.iteration = 0;
+
+	m_entries.assign( numEntries, empty );
+	m_mask = (unsigned int)( numEntries - 1 );
+	m_iteration = 1;
+}
+
+//------------------------------------------------------------------------------
+// Name: NextIteration()
+// Desc: Empties the table in constant time by moving to a new iteration
+//------------------------------------------------------------------------------
+void TranspositionTable::NextIteration()
+{
+	++m_iteration;
+
+	//on wrapping around, old entries could look current again
+	if( 0 == m_iteration )
+		Resize( GetNumBytes() );
+}
@@ -0,0 +1,81 @@
+//------------------------------------------------------------------------------
+// File: TranspositionTable.h
+// Desc: Fixed-size table of the cheapest cost each cell has been reached at
+//
+// Created: 19 October 2026 19:48:30
+//
+// (c)2002 Neil Wakefield
+//------------------------------------------------------------------------------
+
+
+#ifndef INCLUSIONGUARD_TRANSPOSITIONTABLE_H
+#define INCLUSIONGUARD_TRANSPOSITIONTABLE_H
+
+
+//------------------------------------------------------------------------------
+// Included files:
+//------------------------------------------------------------------------------
+#include "MemoryTracker.h"
+
+#include <vector>
+using namespace std;
+
+
+//------------------------------------------------------------------------------
+// Prototypes and declarations:
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Name: class TranspositionTable
+// Desc: Remembers the cheapest cost each cell was reached at during the
+//		 current iteration of a depth-first search, so that reaching it again
+//		 no cheaper can be cut off. Each cell hashes to a single slot and a new
+//		 entry simply replaces the old one, so the table never grows - a
+//		 collision only costs the search some repeated work
+//------------------------------------------------------------------------------
+class TranspositionTable
+{
+
+public:
+	TranspositionTable();
+
+	void Resize( const size_t maxBytes );
+	size_t GetNumBytes() const { return m_entries.size() * sizeof( Entry ); }
+
+	void NextIteration();
+
+	bool IsDominated( const int cell, const int cost ) const
+	{
+		const Entry& entry = m_entries[ GetSlot( cell ) ];
+		return entry.iteration == m_iteration && entry.cell == cell && entry.cost <= cost;
+	}
+
+	void Store( const int cell, const int cost )
+	{
+		Entry& entry = m_entries[ GetSlot( cell ) ];
+		entry.cell = cell;
+		entry.cost = cost;
+		entry.iteration = m_iteration;
+	}
+
+private:
+	struct Entry
+	{
+		int cell;
+		int cost;
+		unsigned int iteration;
+	};
+
+	TrackedVector< Entry, MemoryTracker::SUBSYSTEM_SOLVER >::Type m_entries;
+	unsigned int m_mask;
+	unsigned int m_iteration;	//entries from earlier iterations count as empty
+
+	unsigned int GetSlot( const int cell ) const
+	{
+		return ( (unsigned int)( cell ) * 2654435761u ) & m_mask;
+	}
+
+};
+
+
+#endif //INCLUSIONGUARD_TRANSPOSITIONTABLE_H
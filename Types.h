@@ -0,0 +1,28 @@
+//------------------------------------------------------------------------------
+// File: Types.h
+// Desc: Fixed-size types not provided by the compiler's standard headers
+//
+// Created: 19 October 2026 18:02:13
+//
+// (c)2002 Neil Wakefield
+//------------------------------------------------------------------------------
+
+
+#ifndef INCLUSIONGUARD_TYPES_H
+#define INCLUSIONGUARD_TYPES_H
+
+
+//------------------------------------------------------------------------------
+// Definitions:
+//------------------------------------------------------------------------------
+#ifdef _MSC_VER
+typedef unsigned __int64 uint64;
+#else
+typedef unsigned long long uint64;
+#endif
+
+//builds a 64 bit constant from two 32 bit halves, as the literal suffixes
+// differ between compilers
+#define MAKE_UINT64( high, low ) ( ( uint64( high ) << 32 ) | uint64( low ) )
+
+#endif //INCLUSIONGUARD_TYPES_H
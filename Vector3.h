@@ -0,0 +1,83 @@
+//------------------------------------------------------------------------------
+// File: Vector3.h
+// Desc: Minimal 3D vector maths with no Direct3D dependency
+//
+// Created: 19 October 2026 13:05:48
+//
+// (c)2002 Neil Wakefield
+//------------------------------------------------------------------------------
+
+
+#ifndef INCLUSIONGUARD_VECTOR3_H
+#define INCLUSIONGUARD_VECTOR3_H
+
+
+//------------------------------------------------------------------------------
+// Included files:
+//------------------------------------------------------------------------------
+#include <math.h>
+
+
+//------------------------------------------------------------------------------
+// Prototypes and declarations:
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Name: struct Vector3
+// Desc: A point or direction in 3D space, laid out like D3DXVECTOR3
+//------------------------------------------------------------------------------
+struct Vector3
+{
+	Vector3() : x( 0.0f ), y( 0.0f ), z( 0.0f ) {}
+	Vector3( const float newX, const float newY, const float newZ )
+		: x( newX ), y( newY ), z( newZ ) {}
+
+	float x, y, z;
+};
+
+//------------------------------------------------------------------------------
+// Functions:
+//------------------------------------------------------------------------------
+inline Vector3 Vec3Add( const Vector3& a, const Vector3& b )
+{
+	return Vector3( a.x + b.x, a.y + b.y, a.z + b.z );
+}
+
+inline Vector3 Vec3Subtract( const Vector3& a, const Vector3& b )
+{
+	return Vector3( a.x - b.x, a.y - b.y, a.z - b.z );
+}
+
+inline Vector3 Vec3Scale( const Vector3& v, const float s )
+{
+	return Vector3( v.x * s, v.y * s, v.z * s );
+}
+
+inline float Vec3Dot( const Vector3& a, const Vector3& b )
+{
+	return a.x * b.x + a.y * b.y + a.z * b.z;
+}
+
+inline Vector3 Vec3Cross( const Vector3& a, const Vector3& b )
+{
+	return Vector3( a.y * b.z - a.z * b.y,
+					a.z * b.x - a.x * b.z,
+					a.x * b.y - a.y * b.x );
+}
+
+inline float Vec3Length( const Vector3& v )
+{
+	return sqrtf( Vec3Dot( v, v ) );
+}
+
+inline Vector3 Vec3Normalize( const Vector3& v )
+{
+	const float length = Vec3Length( v );
+	if( length <= 0.0f )
+		return Vector3();
+
+	return Vec3Scale( v, 1.0f / length );
+}
+
+
+#endif //INCLUSIONGUARD_VECTOR3_H
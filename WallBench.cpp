@@ -0,0 +1,156 @@
+//------------------------------------------------------------------------------
+// File: WallBench.cpp
+// Desc: Measures the cost of rebuilding and culling wall chunks
+//
+// Created: 20 October 2026 09:41:27
+//
+// (c)2002 Neil Wakefield
+//------------------------------------------------------------------------------
+
+
+//------------------------------------------------------------------------------
+// Included files:
+//------------------------------------------------------------------------------
+#include "Constants.h"
+#include "Frustum.h"
+#include "Grid.h"
+#include "Random.h"
+#include "Timer.h"
+#include "WallChunks.h"
+#include "WallMesh.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+
+//------------------------------------------------------------------------------
+// Globals:
+//------------------------------------------------------------------------------
+namespace
+{
+	//--------------------------------------------------------------------------
+	// Name: BenchEdits()
+	// Desc: Flips random tiles one at a time, as a game editing the maze would,
+	//		 and times the chunk rebuild after each
+	//--------------------------------------------------------------------------
+	void BenchEdits( Grid& grid, WallChunks& chunks, const int numEdits )
+	{
+		Random random( 1 );
+		double total = 0.0;
+		double worst = 0.0;
+		int numRebuilt = 0;
+
+		for( int i = 0; i < numEdits; ++i )
+		{
+			const int x = int( random.Next( (unsigned int)( grid.GetWidth() ) ) );
+			const int y = int( random.Next( (unsigned int)( grid.GetHeight() ) ) );
+			const bool isWall = ( Grid::TILE_WALL == grid.GetTile( x, y ) );
+
+			Timer timer;
+			grid.SetTile( x, y, isWall ? Grid::TILE_PATH : Grid::TILE_WALL );
+			numRebuilt += chunks.Update( grid );
+			const double seconds = timer.GetSeconds();
+
+			total += seconds;
+			if( seconds > worst )
+				worst = seconds;
+		}
+
+		printf( "%-24s %9.3f us mean %9.3f us max, %.2f chunks each\n", "edit and rebuild",
+				total * 1.0e6 / numEdits, worst * 1.0e6, double( numRebuilt ) / numEdits );
+	}
+
+	//--------------------------------------------------------------------------
+	// Name: BenchCulling()
+	// Desc: Times the chunk query for the side view and for the chase-cam
+	//		 following the player to random places in the maze, with the
+	//		 cameras App::FrameMove sets up
+	//--------------------------------------------------------------------------
+	void BenchCulling( const Grid& grid, const WallChunks& chunks, const int numQueries )
+	{
+		const float size = float( grid.GetWidth() > grid.GetHeight() ? grid.GetWidth() : grid.GetHeight() );
+		vector< int > visible;
+
+		//far enough back to see all of a large maze, which the game's far
+		// plane would clip
+		Frustum sideView;
+		const float far = ( size + 2 ) * 2.0f;
+		sideView.Build( Vector3( -0.5f, -0.5f, ( size + 2 ) * -1.4f ), Vector3( -0.5f, -0.5f, 0.0f ),
+						Vector3( 0.0f, 1.0f, 0.0f ), CONST_CAMERA_FOV, 4.0f / 3.0f,
+						CONST_CAMERA_NEAR, far, far );
+
+		Timer timer;
+		int numVisible = 0;
+		for( int i = 0; i < numQueries; ++i )
+		{
+			chunks.CollectVisible( sideView, visible );
+			numVisible += int( visible.size() );
+		}
+		printf( "%-24s %9.3f us per query, %.1f of %d chunks visible\n", "cull side view",
+				timer.Lap() * 1.0e6 / numQueries, double( numVisible ) / numQueries,
+				chunks.GetNumChunks() );
+
+		//the cameras are built up front so only the query is timed
+		Random random( 2 );
+		vector< Frustum > chaseCams( numQueries );
+		for( int i = 0; i < numQueries; ++i )
+		{
+			const float x = random.Next( (unsigned int)( grid.GetWidth() ) ) - grid.GetWidth() / 2.0f;
+			const float y = random.Next( (unsigned int)( grid.GetHeight() ) ) - grid.GetHeight() / 2.0f;
+			chaseCams[ i ].Build( Vector3( x - 8.0f, y - 8.0f, -9.5f ), Vector3( x, y, 0.5f ),
+								  Vector3( 0.0f, 0.0f, -1.0f ), CONST_CAMERA_FOV, 4.0f / 3.0f,
+								  CONST_CAMERA_NEAR, CONST_CAMERA_FAR, CONST_CHASECAM_RANGE );
+		}
+
+		timer.Start();
+		numVisible = 0;
+		for( int i = 0; i < numQueries; ++i )
+		{
+			chunks.CollectVisible( chaseCams[ i ], visible );
+			numVisible += int( visible.size() );
+		}
+		printf( "%-24s %9.3f us per query, %.1f of %d chunks visible\n", "cull chase-cam",
+				timer.Lap() * 1.0e6 / numQueries, double( numVisible ) / numQueries,
+				chunks.GetNumChunks() );
+	}
+}
+
+
+//------------------------------------------------------------------------------
+// Definitions:
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Name: main()
+// Desc: Entry point - WallBench [size] [edits], with as many culling queries
+//		 as edits
+//------------------------------------------------------------------------------
+int main( int argc, char* argv[] )
+{
+	const int size = ( argc > 1 ) ? atoi( argv[ 1 ] ) : 1025;
+	const int numEdits = ( argc > 2 ) ? atoi( argv[ 2 ] ) : 10000;
+	if( size < 3 || numEdits <= 0 )
+	{
+		fprintf( stderr, "usage: WallBench [size] [edits]\n" );
+		return 1;
+	}
+
+	Grid grid( size, size );
+	grid.GenerateMaze( 1 );
+	printf( "%dx%d maze, %d edits, chunks of %d\n", size, size, numEdits, WallChunks::CHUNK_SIZE );
+
+	//a whole rebuild is what every edit would cost without the chunks
+	Timer timer;
+	WallMesh mesh;
+	mesh.Build( grid );
+	printf( "%-24s %9.3f ms\n", "whole mesh", timer.Lap() * 1000.0 );
+
+	WallChunks chunks;
+	const int numChunks = chunks.Update( grid );
+	printf( "%-24s %9.3f ms, %d chunks\n", "all chunks", timer.Lap() * 1000.0, numChunks );
+
+	BenchEdits( grid, chunks, numEdits );
+	BenchCulling( grid, chunks, numEdits );
+
+	return 0;
+}
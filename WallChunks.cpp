@@ -0,0 +1,138 @@
+//------------------------------------------------------------------------------
+// File: WallChunks.cpp
+// Desc: Wall geometry split into chunks which are rebuilt only when dirty
+//
+// Created: 19 October 2026 11:31:05
+//
+// (c)2002 Neil Wakefield
+//------------------------------------------------------------------------------
+
+
+//------------------------------------------------------------------------------
+// Included files:
+//------------------------------------------------------------------------------
+#include "WallChunks.h"
+
+#include <math.h>
+
+
+//------------------------------------------------------------------------------
+// Globals:
+//------------------------------------------------------------------------------
+
+
+//------------------------------------------------------------------------------
+// Definitions:
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Name: WallChunks()
+// Desc: Constructor for the chunked wall geometry
+//------------------------------------------------------------------------------
+WallChunks::WallChunks()
+{
+	m_numX = 0;
+	m_numY = 0;
+	m_gridWidth = 0;
+	m_gridHeight = 0;
+}
+
+//------------------------------------------------------------------------------
+// Name: Update()
+// Desc: Rebuilds every chunk the grid has marked dirty, returning how many
+//		 were rebuilt. Their indices are available from GetRebuiltChunks()
+//------------------------------------------------------------------------------
+int WallChunks::Update( Grid& grid )
+{
+	DirtyChunks& dirty = grid.GetDirtyChunks();
+
+	m_rebuilt.clear();
+
+	//resize if the grid layout has changed
+	if( grid.GetWidth() != m_gridWidth || grid.GetHeight() != m_gridHeight ||
+		dirty.GetNumX() != m_numX || dirty.GetNumY() != m_numY )
+	{
+		m_gridWidth = grid.GetWidth();
+		m_gridHeight = grid.GetHeight();
+		m_numX = dirty.GetNumX();
+		m_numY = dirty.GetNumY();
+		m_meshes.clear();
+		m_meshes.resize( m_numX * m_numY );
+		m_bounds.resize( m_numX * m_numY );
+		dirty.MarkAll();
+	}
+
+	int cx, cy;
+	while( dirty.Pop( cx, cy ) )
+	{
+		const int minX = cx * CHUNK_SIZE;
+		const int minY = cy * CHUNK_SIZE;
+		int maxX = minX + CHUNK_SIZE;
+		int maxY = minY + CHUNK_SIZE;
+		if( maxX > m_gridWidth )
+			maxX = m_gridWidth;
+		if( maxY > m_gridHeight )
+			maxY = m_gridHeight;
+
+		const int index = cy * m_numX + cx;
+		m_meshes[ index ].Build( grid, minX, minY, maxX, maxY );
+		m_bounds[ index ].empty = ! m_meshes[ index ].GetBounds( m_bounds[ index ].boxMin,
+																  m_bounds[ index ].boxMax );
+		m_rebuilt.push_back( index );
+	}
+
+	return int( m_rebuilt.size() );
+}
+
+//------------------------------------------------------------------------------
+// Name: CollectVisible()
+// Desc: Fills in the indices of the chunks that intersect a frustum. Only the
+//		 chunks under the frustum's footprint are tested, so the cost follows
+//		 what can be seen rather than the size of the grid
+//------------------------------------------------------------------------------
+void WallChunks::CollectVisible( const Frustum& frustum, vector< int >& visible ) const
+{
+	visible.clear();
+	if( 0 == m_numX || 0 == m_numY )
+		return;
+
+	float minX, minY, maxX, maxY;
+	frustum.GetFootprint( minX, minY, maxX, maxY );
+
+	//convert the footprint to a range of cells. The border ring around the
+	// grid, at -1 and at the width and height, belongs to the edge chunks, so
+	// a footprint touching only the border still takes them in once clamped
+	const float originX = -m_gridWidth / 2.0f - 0.5f;
+	const float originY = -m_gridHeight / 2.0f - 0.5f;
+	int x0 = int( floorf( minX - originX ) );
+	int y0 = int( floorf( minY - originY ) );
+	int x1 = int( floorf( maxX - originX ) );
+	int y1 = int( floorf( maxY - originY ) );
+
+	if( x1 < -1 || y1 < -1 || x0 > m_gridWidth || y0 > m_gridHeight )
+		return;
+
+	x0 = ( x0 < 0 ) ? 0 : ( x0 < m_gridWidth ) ? x0 : m_gridWidth - 1;
+	y0 = ( y0 < 0 ) ? 0 : ( y0 < m_gridHeight ) ? y0 : m_gridHeight - 1;
+	x1 = ( x1 < 0 ) ? 0 : ( x1 < m_gridWidth ) ? x1 : m_gridWidth - 1;
+	y1 = ( y1 < 0 ) ? 0 : ( y1 < m_gridHeight ) ? y1 : m_gridHeight - 1;
+
+	const int cx0 = x0 / CHUNK_SIZE;
+	const int cy0 = y0 / CHUNK_SIZE;
+	const int cx1 = x1 / CHUNK_SIZE;
+	const int cy1 = y1 / CHUNK_SIZE;
+
+	for( int cy = cy0; cy <= cy1; ++cy )
+	{
+		for( int cx = cx0; cx <= cx1; ++cx )
+		{
+			const int index = cy * m_numX + cx;
+			const ChunkBounds& bounds = m_bounds[ index ];
+			if( bounds.empty )
+				continue;
+
+			if( frustum.IsBoxVisible( bounds.boxMin, bounds.boxMax ) )
+				visible.push_back( index );
+		}
+	}
+}
@@ -0,0 +1,76 @@
+//------------------------------------------------------------------------------
+// File: WallChunks.h
+// Desc: Wall geometry split into chunks which are rebuilt only when dirty
+//
+// Created: 19 October 2026 11:24:40
+//
+// (c)2002 Neil Wakefield
+//------------------------------------------------------------------------------
+
+
+#ifndef INCLUSIONGUARD_WALLCHUNKS_H
+#define INCLUSIONGUARD_WALLCHUNKS_H
+
+
+//------------------------------------------------------------------------------
+// Included files:
+//------------------------------------------------------------------------------
+#include "Grid.h"
+#include "WallMesh.h"
+#include "Frustum.h"
+
+#include <vector>
+using namespace std;
+
+
+//------------------------------------------------------------------------------
+// Prototypes and declarations:
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Name: class WallChunks
+// Desc: One WallMesh per CHUNK_SIZE x CHUNK_SIZE block of the grid. Update()
+//		 rebuilds the chunks the grid has marked dirty since the last call and
+//		 records which ones changed, so the renderer only re-uploads those.
+//		 Each chunk also keeps its bounds so it can be culled against a frustum
+//------------------------------------------------------------------------------
+class WallChunks
+{
+
+public:
+	WallChunks();
+
+	const static int CHUNK_SIZE = DirtyChunks::CHUNK_SIZE;
+
+	int Update( Grid& grid );
+
+	int GetNumX() const { return m_numX; }
+	int GetNumY() const { return m_numY; }
+	int GetNumChunks() const { return m_numX * m_numY; }
+
+	const WallMesh& GetMesh( const int index ) const { return m_meshes[ index ]; }
+	const vector< int >& GetRebuiltChunks() const { return m_rebuilt; }
+
+	void CollectVisible( const Frustum& frustum, vector< int >& visible ) const;
+
+private:
+	int m_numX;
+	int m_numY;
+	int m_gridWidth;
+	int m_gridHeight;
+
+	vector< WallMesh > m_meshes;
+
+	struct ChunkBounds
+	{
+		Vector3 boxMin;
+		Vector3 boxMax;
+		bool empty;
+	};
+	vector< ChunkBounds > m_bounds;
+	vector< int > m_rebuilt;
+
+};
+
+
+#endif //INCLUSIONGUARD_WALLCHUNKS_H
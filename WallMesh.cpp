@@ -0,0 +1,435 @@
+//------------------------------------------------------------------------------
+// File: WallMesh.cpp
+// Desc: Greedy-meshed static geometry for the maze walls and border
+//
+// Created: 19 October 2026 09:20:37
+//
+// (c)2002 Neil Wakefield
+//------------------------------------------------------------------------------
+
+
+//------------------------------------------------------------------------------
+// Included files:
+//------------------------------------------------------------------------------
+#include "WallMesh.h"
+
+
+//------------------------------------------------------------------------------
+// Globals:
+//------------------------------------------------------------------------------
+namespace
+{
+	//unit steps for the four side faces, in the same order as Grid::Direction
+	const int g_dirX[ 4 ] = { 0, 1, 0, -1 };
+	const int g_dirY[ 4 ] = { 1, 0, -1, 0 };
+
+	//depth of a wall cube
+	const float g_nearZ = -0.5f;
+	const float g_farZ	= 0.5f;
+}
+
+
+//------------------------------------------------------------------------------
+// Definitions:
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Name: WallMesh()
+// Desc: Constructor for the wall mesh object
+//------------------------------------------------------------------------------
+WallMesh::WallMesh()
+{
+	Clear();
+}
+
+//------------------------------------------------------------------------------
+// Name: Clear()
+// Desc: Removes all geometry from the mesh
+//------------------------------------------------------------------------------
+void WallMesh::Clear()
+{
+	for( int i = 0; i < NUM_LAYERS; ++i )
+	{
+		m_vertices[ i ].clear();
+		m_indices[ i ].clear();
+		m_parts[ i ].clear();
+	}
+}
+
+//------------------------------------------------------------------------------
+// Name: Build()
+// Desc: Builds the mesh for the whole grid, including the surrounding border
+//------------------------------------------------------------------------------
+void WallMesh::Build( const Grid& grid )
+{
+	Build( grid, 0, 0, grid.GetWidth(), grid.GetHeight() );
+}
+
+//------------------------------------------------------------------------------
+// Name: Build()
+// Desc: Builds the mesh for the cells in [minX,maxX) x [minY,maxY). A region
+//		 touching the edge of the grid also takes the border cells next to it
+//------------------------------------------------------------------------------
+void WallMesh::Build( const Grid& grid, const int minX, const int minY,
+					  const int maxX, const int maxY )
+{
+	Clear();
+
+	//extend the region to take in the border where it touches the grid edge
+	const int width = grid.GetWidth();
+	const int height = grid.GetHeight();
+	const int ex0 = ( minX <= 0 ) ? -1 : minX;
+	const int ey0 = ( minY <= 0 ) ? -1 : minY;
+	const int ex1 = ( maxX >= width ) ? width + 1 : maxX;
+	const int ey1 = ( maxY >= height ) ? height + 1 : maxY;
+	const int w = ex1 - ex0;
+	const int h = ey1 - ey0;
+	if( w <= 0 || h <= 0 )
+		return;
+
+	//world space position of the lower-left corner of the region
+	const float originX = ex0 - width / 2.0f - 0.5f;
+	const float originY = ey0 - height / 2.0f - 0.5f;
+
+	vector< char > mask( w * h );
+	vector< char > used( w * h );
+	float corners[ 4 ][ 3 ];
+
+	for( int l = 0; l < NUM_LAYERS; ++l )
+	{
+		const Layer layer = Layer( l );
+
+		//find the solid cells belonging to this layer
+		for( int j = 0; j < h; ++j )
+		{
+			for( int i = 0; i < w; ++i )
+			{
+				const int x = ex0 + i;
+				const int y = ey0 + j;
+				const Layer cellLayer = IsBorder( grid, x, y ) ? LAYER_BORDER : LAYER_WALL;
+				mask[ j * w + i ] = ( cellLayer == layer ) && IsSolid( grid, x, y );
+				used[ j * w + i ] = false;
+			}
+		}
+
+		//front and back faces - merge cells into the largest rectangles we can
+		for( int j = 0; j < h; ++j )
+		{
+			for( int i = 0; i < w; ++i )
+			{
+				if( ! mask[ j * w + i ] || used[ j * w + i ] )
+					continue;
+
+				//grow along the row...
+				int runW = 1;
+				while( ( i + runW < w ) && mask[ j * w + i + runW ] &&
+					   ! used[ j * w + i + runW ] )
+					++runW;
+
+				//...then down the rows for as long as the whole run fits
+				int runH = 1;
+				while( j + runH < h )
+				{
+					bool rowFits = true;
+					for( int k = 0; k < runW; ++k )
+					{
+						const int index = ( j + runH ) * w + i + k;
+						if( ! mask[ index ] || used[ index ] )
+						{
+							rowFits = false;
+							break;
+						}
+					}
+					if( ! rowFits )
+						break;
+					++runH;
+				}
+
+				for( int v = 0; v < runH; ++v )
+					for( int u = 0; u < runW; ++u )
+						used[ ( j + v ) * w + i + u ] = true;
+
+				const float x0 = originX + i;
+				const float x1 = x0 + runW;
+				const float y0 = originY + j;
+				const float y1 = y0 + runH;
+
+				corners[ 0 ][ 0 ] = x0; corners[ 0 ][ 1 ] = y0;
+				corners[ 1 ][ 0 ] = x0; corners[ 1 ][ 1 ] = y1;
+				corners[ 2 ][ 0 ] = x1; corners[ 2 ][ 1 ] = y1;
+				corners[ 3 ][ 0 ] = x1; corners[ 3 ][ 1 ] = y0;
+
+				for( int c = 0; c < 4; ++c )
+					corners[ c ][ 2 ] = g_nearZ;
+				AddQuad( layer, corners, 0.0f, 0.0f, -1.0f );
+
+				for( int c = 0; c < 4; ++c )
+					corners[ c ][ 2 ] = g_farZ;
+				AddQuad( layer, corners, 0.0f, 0.0f, 1.0f );
+			}
+		}
+
+		//side faces - only where the neighbouring cell is open, merged into runs
+		for( int d = 0; d < 4; ++d )
+		{
+			const bool alongY = ( g_dirX[ d ] != 0 );
+			const int outerCount = alongY ? w : h;
+			const int innerCount = alongY ? h : w;
+
+			for( int o = 0; o < outerCount; ++o )
+			{
+				int k = 0;
+				while( k < innerCount )
+				{
+					//find the start of a run of exposed faces
+					int i = alongY ? o : k;
+					int j = alongY ? k : o;
+					if( ! mask[ j * w + i ] ||
+						IsSolid( grid, ex0 + i + g_dirX[ d ], ey0 + j + g_dirY[ d ] ) )
+					{
+						++k;
+						continue;
+					}
+
+					const int start = k;
+					while( k < innerCount )
+					{
+						i = alongY ? o : k;
+						j = alongY ? k : o;
+						if( ! mask[ j * w + i ] ||
+							IsSolid( grid, ex0 + i + g_dirX[ d ], ey0 + j + g_dirY[ d ] ) )
+							break;
+						++k;
+					}
+
+					if( alongY )
+					{
+						const float px = originX + o + ( g_dirX[ d ] > 0 ? 1.0f : 0.0f );
+						const float y0 = originY + start;
+						const float y1 = originY + k;
+						corners[ 0 ][ 0 ] = px; corners[ 0 ][ 1 ] = y0; corners[ 0 ][ 2 ] = g_nearZ;
+						corners[ 1 ][ 0 ] = px; corners[ 1 ][ 1 ] = y1; corners[ 1 ][ 2 ] = g_nearZ;
+						corners[ 2 ][ 0 ] = px; corners[ 2 ][ 1 ] = y1; corners[ 2 ][ 2 ] = g_farZ;
+						corners[ 3 ][ 0 ] = px; corners[ 3 ][ 1 ] = y0; corners[ 3 ][ 2 ] = g_farZ;
+					}
+					else
+					{
+						const float py = originY + o + ( g_dirY[ d ] > 0 ? 1.0f : 0.0f );
+						const float x0 = originX + start;
+						const float x1 = originX + k;
+						corners[ 0 ][ 0 ] = x0; corners[ 0 ][ 1 ] = py; corners[ 0 ][ 2 ] = g_nearZ;
+						corners[ 1 ][ 0 ] = x1; corners[ 1 ][ 1 ] = py; corners[ 1 ][ 2 ] = g_nearZ;
+						corners[ 2 ][ 0 ] = x1; corners[ 2 ][ 1 ] = py; corners[ 2 ][ 2 ] = g_farZ;
+						corners[ 3 ][ 0 ] = x0; corners[ 3 ][ 1 ] = py; corners[ 3 ][ 2 ] = g_farZ;
+					}
+					AddQuad( layer, corners, float( g_dirX[ d ] ), float( g_dirY[ d ] ), 0.0f );
+				}
+			}
+		}
+	}
+}
+
+//------------------------------------------------------------------------------
+// Name: GetVertices()
+// Desc: Returns the vertices of a layer, or NULL if the layer is empty
+//------------------------------------------------------------------------------
+const WallVertex* WallMesh::GetVertices( const Layer layer ) const
+{
+	if( m_vertices[ layer ].empty() )
+		return NULL;
+
+	return &m_vertices[ layer ][ 0 ];
+}
+
+//------------------------------------------------------------------------------
+// Name: GetIndices()
+// Desc: Returns the indices of a layer, or NULL if the layer is empty
+//------------------------------------------------------------------------------
+const unsigned short* WallMesh::GetIndices( const Layer layer ) const
+{
+	if( m_indices[ layer ].empty() )
+		return NULL;
+
+	return &m_indices[ layer ][ 0 ];
+}
+
+//------------------------------------------------------------------------------
+// Name: GetBounds()
+// Desc: Returns the box enclosing all layers, or FALSE if the mesh is empty
+//------------------------------------------------------------------------------
+bool WallMesh::GetBounds( Vector3& boxMin, Vector3& boxMax ) const
+{
+	bool found = false;
+
+	for( int l = 0; l < NUM_LAYERS; ++l )
+	{
+		const vector< WallVertex >& verts = m_vertices[ l ];
+		for( size_t i = 0; i < verts.size(); ++i )
+		{
+			const WallVertex& v = verts[ i ];
+			if( ! found )
+			{
+				boxMin = boxMax = Vector3( v.x, v.y, v.z );
+				found = true;
+				continue;
+			}
+
+			if( v.x < boxMin.x ) boxMin.x = v.x;
+			if( v.y < boxMin.y ) boxMin.y = v.y;
+			if( v.z < boxMin.z ) boxMin.z = v.z;
+			if( v.x > boxMax.x ) boxMax.x = v.x;
+			if( v.y > boxMax.y ) boxMax.y = v.y;
+			if( v.z > boxMax.z ) boxMax.z = v.z;
+		}
+	}
+
+	return found;
+}
+
+//------------------------------------------------------------------------------
+// Name: ComputeVolume()
+// Desc: Returns the signed volume enclosed by all layers of the mesh. For a
+//		 watertight, outward-facing mesh of the whole grid this equals the
+//		 number of solid cells
+//------------------------------------------------------------------------------
+float WallMesh::ComputeVolume() const
+{
+	double volume = 0.0;
+
+	for( int l = 0; l < NUM_LAYERS; ++l )
+	{
+		const vector< unsigned short >& indices = m_indices[ l ];
+		const vector< WallMeshPart >& parts = m_parts[ l ];
+
+		for( size_t p = 0; p < parts.size(); ++p )
+		{
+			const WallVertex* pVerts = &m_vertices[ l ][ parts[ p ].firstVertex ];
+			const int endIndex = parts[ p ].firstIndex + parts[ p ].numIndices;
+
+			for( int t = parts[ p ].firstIndex; t + 2 < endIndex; t += 3 )
+			{
+				const WallVertex& a = pVerts[ indices[ t ] ];
+				const WallVertex& b = pVerts[ indices[ t + 1 ] ];
+				const WallVertex& c = pVerts[ indices[ t + 2 ] ];
+
+				//a . ( b x c )
+				volume += a.x * ( b.y * c.z - b.z * c.y ) +
+						  a.y * ( b.z * c.x - b.x * c.z ) +
+						  a.z * ( b.x * c.y - b.y * c.x );
+			}
+		}
+	}
+
+	return float( volume / 6.0 );
+}
+
+//------------------------------------------------------------------------------
+// Name: IsSolid()
+// Desc: Checks to see if a cell is a wall or part of the border
+//------------------------------------------------------------------------------
+bool WallMesh::IsSolid( const Grid& grid, const int x, const int y )
+{
+	if( x >= 0 && x < grid.GetWidth() && y >= 0 && y < grid.GetHeight() )
+		return ( Grid::TILE_WALL == grid.GetTile( x, y ) );
+
+	if( ! IsBorder( grid, x, y ) )
+		return false;
+
+	//leave gaps in the border for the entrance and exits
+	if( x == -1 && y == grid.GetStartY() )
+		return false;
+	for( int i = 0; i < grid.GetNumExits(); ++i )
+	{
+		const MazeSquare outside = grid.GetExitOutside( i );
+		if( x == outside.x && y == outside.y )
+			return false;
+	}
+
+	return true;
+}
+
+//------------------------------------------------------------------------------
+// Name: IsBorder()
+// Desc: Checks to see if a cell lies in the ring just outside the grid
+//------------------------------------------------------------------------------
+bool WallMesh::IsBorder( const Grid& grid, const int x, const int y )
+{
+	const int width = grid.GetWidth();
+	const int height = grid.GetHeight();
+
+	if( x < -1 || x > width || y < -1 || y > height )
+		return false;
+
+	return ( x == -1 || x == width || y == -1 || y == height );
+}
+
+//------------------------------------------------------------------------------
+// Name: AddQuad()
+// Desc: Appends a quad to a layer, winding it clockwise as seen from the side
+//		 the normal points to. Starts a new part if the quad's indices would
+//		 no longer fit in 16 bits
+//------------------------------------------------------------------------------
+void WallMesh::AddQuad( const Layer layer, const float corners[ 4 ][ 3 ],
+						const float nx, const float ny, const float nz )
+{
+	vector< WallVertex >& verts = m_vertices[ layer ];
+	vector< unsigned short >& indices = m_indices[ layer ];
+	vector< WallMeshPart >& parts = m_parts[ layer ];
+
+	if( parts.empty() || parts.back().numVertices + 4 > MAX_PART_VERTICES )
+	{
+		WallMeshPart part;
+		part.firstVertex = int( verts.size() );
+		part.numVertices = 0;
+		part.firstIndex = int( indices.size() );
+		part.numIndices = 0;
+		parts.push_back( part );
+	}
+
+	WallMeshPart& part = parts.back();
+	const unsigned short base = (unsigned short)( part.numVertices );
+	part.numVertices += 4;
+	part.numIndices += 6;
+	for( int c = 0; c < 4; ++c )
+	{
+		WallVertex v;
+		v.x = corners[ c ][ 0 ];
+		v.y = corners[ c ][ 1 ];
+		v.z = corners[ c ][ 2 ];
+		v.nx = nx;
+		v.ny = ny;
+		v.nz = nz;
+		verts.push_back( v );
+	}
+
+	//direct3d culls anticlockwise faces, so make sure ( 1 - 0 ) x ( 2 - 0 )
+	// points the same way as the normal
+	const float ax = corners[ 1 ][ 0 ] - corners[ 0 ][ 0 ];
+	const float ay = corners[ 1 ][ 1 ] - corners[ 0 ][ 1 ];
+	const float az = corners[ 1 ][ 2 ] - corners[ 0 ][ 2 ];
+	const float bx = corners[ 2 ][ 0 ] - corners[ 0 ][ 0 ];
+	const float by = corners[ 2 ][ 1 ] - corners[ 0 ][ 1 ];
+	const float bz = corners[ 2 ][ 2 ] - corners[ 0 ][ 2 ];
+	const float facing = ( ay * bz - az * by ) * nx +
+						 ( az * bx - ax * bz ) * ny +
+						 ( ax * by - ay * bx ) * nz;
+
+	if( facing > 0.0f )
+	{
+		indices.push_back( base );
+		indices.push_back( base + 1 );
+		indices.push_back( base + 2 );
+		indices.push_back( base );
+		indices.push_back( base + 2 );
+		indices.push_back( base + 3 );
+	}
+	else
+	{
+		indices.push_back( base );
+		indices.push_back( base + 2 );
+		indices.push_back( base + 1 );
+		indices.push_back( base );
+		indices.push_back( base + 3 );
+		indices.push_back( base + 2 );
+	}
+}
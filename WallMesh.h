@@ -0,0 +1,99 @@
+//------------------------------------------------------------------------------
+// File: WallMesh.h
+// Desc: Greedy-meshed static geometry for the maze walls and border
+//
+// Created: 19 October 2026 09:14:22
+//
+// (c)2002 Neil Wakefield
+//------------------------------------------------------------------------------
+
+
+#ifndef INCLUSIONGUARD_WALLMESH_H
+#define INCLUSIONGUARD_WALLMESH_H
+
+
+//------------------------------------------------------------------------------
+// Included files:
+//------------------------------------------------------------------------------
+#include "Grid.h"
+#include "Vector3.h"
+
+#include <vector>
+using namespace std;
+
+
+//------------------------------------------------------------------------------
+// Prototypes and declarations:
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Name: struct WallVertex
+// Desc: A single vertex in the wall mesh - matches the layout of MESH_VERTEX
+//------------------------------------------------------------------------------
+struct WallVertex
+{
+	float x, y, z;		//position
+	float nx, ny, nz;	//normal
+};
+
+//------------------------------------------------------------------------------
+// Name: struct WallMeshPart
+// Desc: A run of a layer's vertices and the triangles using them. Indices are
+//		 16 bit and count from the part's first vertex, so a large layer is
+//		 split into several parts, each drawn with its own base vertex
+//------------------------------------------------------------------------------
+struct WallMeshPart
+{
+	int firstVertex;
+	int numVertices;
+	int firstIndex;
+	int numIndices;
+};
+
+//------------------------------------------------------------------------------
+// Name: class WallMesh
+// Desc: Builds one vertex/index buffer per layer from the wall tiles of a grid.
+//		 Adjacent wall cells are merged into larger quads and faces hidden by a
+//		 neighbouring solid cell are dropped. Cells are unit cubes centred on
+//		 ( x - width / 2, y - height / 2, 0 ), as in App::Render.
+//------------------------------------------------------------------------------
+class WallMesh
+{
+
+public:
+	WallMesh();
+
+	enum Layer { LAYER_WALL, LAYER_BORDER, NUM_LAYERS };
+	const static int MAX_PART_VERTICES = 65535;
+
+	void Build( const Grid& grid );
+	void Build( const Grid& grid, const int minX, const int minY,
+				const int maxX, const int maxY );
+	void Clear();
+
+	int GetNumVertices( const Layer layer ) const { return int( m_vertices[ layer ].size() ); }
+	int GetNumIndices( const Layer layer ) const { return int( m_indices[ layer ].size() ); }
+	int GetNumTriangles( const Layer layer ) const { return GetNumIndices( layer ) / 3; }
+
+	const WallVertex* GetVertices( const Layer layer ) const;
+	const unsigned short* GetIndices( const Layer layer ) const;
+	const vector< WallMeshPart >& GetParts( const Layer layer ) const { return m_parts[ layer ]; }
+
+	bool GetBounds( Vector3& boxMin, Vector3& boxMax ) const;
+	float ComputeVolume() const;
+
+private:
+	vector< WallVertex > m_vertices[ NUM_LAYERS ];
+	vector< unsigned short > m_indices[ NUM_LAYERS ];
+	vector< WallMeshPart > m_parts[ NUM_LAYERS ];
+
+	static bool IsSolid( const Grid& grid, const int x, const int y );
+	static bool IsBorder( const Grid& grid, const int x, const int y );
+
+	void AddQuad( const Layer layer, const float corners[ 4 ][ 3 ],
+				  const float nx, const float ny, const float nz );
+
+};
+
+
+#endif //INCLUSIONGUARD_WALLMESH_H